@@ -0,0 +1,438 @@
+/**
+ * mser_bench: MSER計算・定常状態検出のベンチマーク
+ *
+ * 合成ワークロード（AR(1)+指数過渡、段階変化、裾の重いノイズ）に対して
+ * calculateMSER1 / calculateMSER5 / calculateMSERm と SteadyStateDetector::addDataPoint、
+ * MultiSteadyStateDetector::addRow を系列長・バッチサイズ・checkInterval で掃引し、
+ * 結果をJSONで出力する。
+ *
+ * 使用例:
+ *   mser_bench --quick --output bench.json
+ */
+
+#include "mser/mser.h"
+#include "mser/multi_steady_state_detector.h"
+#include "mser/simd.h"
+#include "mser/steady_state_detector.h"
+#include "workload_generators.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// 割り当て回数の計測（グローバル operator new の置き換え）
+// ============================================================================
+
+namespace {
+
+std::atomic<size_t> gAllocationCount(0);
+std::atomic<size_t> gAllocatedBytes(0);
+
+void* countedAllocate(size_t size) {
+    gAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    gAllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    void* pointer = std::malloc(size != 0 ? size : 1);
+    if (pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+} // namespace
+
+void* operator new(size_t size) {
+    return countedAllocate(size);
+}
+
+void* operator new[](size_t size) {
+    return countedAllocate(size);
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept {
+    std::free(pointer);
+}
+
+namespace {
+
+using mser::MSER;
+using mser::MSERVariant;
+using mser::MultiSteadyStateDetector;
+using mser::SteadyStateConfig;
+using mser::SteadyStateDetector;
+using mser::TimeSeriesData;
+using mser::bench::Workload;
+using Clock = std::chrono::steady_clock;
+
+/**
+ * 区間内の割り当て計測
+ */
+struct AllocationScope {
+    size_t startCount = gAllocationCount.load(std::memory_order_relaxed);
+    size_t startBytes = gAllocatedBytes.load(std::memory_order_relaxed);
+    
+    size_t count() const { return gAllocationCount.load(std::memory_order_relaxed) - startCount; }
+    size_t bytes() const { return gAllocatedBytes.load(std::memory_order_relaxed) - startBytes; }
+};
+
+// ============================================================================
+// 設定
+// ============================================================================
+
+struct Options {
+    std::vector<size_t> offlineSizes = {1000, 10000, 100000, 1000000};
+    std::vector<size_t> detectorSizes = {10000, 100000};
+    std::vector<size_t> batchSizes = {2, 10, 20, 50};
+    std::vector<size_t> checkIntervals = {10, 50, 200};
+    size_t repetitions = 5;
+    std::string outputPath;     // 空は標準出力
+};
+
+void printUsage(const char* program) {
+    std::cerr << "使用方法: " << program << " [--quick] [--repetitions N] [--output FILE]\n"
+              << "  --quick           系列長を縮小して短時間で実行\n"
+              << "  --repetitions N   オフライン計算の繰り返し回数（既定: 5、中央値を報告）\n"
+              << "  --output FILE     JSONの出力先（既定: 標準出力）\n";
+}
+
+bool parseArguments(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--quick") {
+            options.offlineSizes = {1000, 10000, 100000};
+            options.detectorSizes = {10000};
+        } else if (arg == "--repetitions" && i + 1 < argc) {
+            options.repetitions = std::max(std::strtoul(argv[++i], nullptr, 10), 1ul);
+        } else if (arg == "--output" && i + 1 < argc) {
+            options.outputPath = argv[++i];
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ============================================================================
+// 計測
+// ============================================================================
+
+/**
+ * 1件の計測結果（JSONオブジェクト1つ）
+ */
+struct BenchmarkRecord {
+    std::string benchmark;
+    std::string workload;
+    std::string mode;
+    size_t n = 0;
+    size_t batchSize = 0;
+    size_t checkInterval = 0;
+    double nsPerSample = 0.0;
+    size_t allocations = 0;
+    size_t allocatedBytes = 0;
+    size_t checks = 0;
+    std::vector<double> checkLatencyNs;     // 収束チェックを伴う呼び出しの所要時間
+    size_t truncationPoint = 0;
+};
+
+double elapsedNs(Clock::time_point start, Clock::time_point end) {
+    return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+double percentile(std::vector<double> values, double p) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    std::sort(values.begin(), values.end());
+    size_t index = static_cast<size_t>(p * (values.size() - 1) + 0.5);
+    return values[std::min(index, values.size() - 1)];
+}
+
+/**
+ * オフライン計算（calculateMSER1/5/m）の計測
+ */
+template <typename Calculate>
+BenchmarkRecord benchmarkOffline(const std::string& name, Workload workload,
+                                 const TimeSeriesData& data, size_t batchSize,
+                                 size_t repetitions, Calculate calculate) {
+    BenchmarkRecord record;
+    record.benchmark = name;
+    record.workload = mser::bench::toString(workload);
+    record.n = data.size();
+    record.batchSize = batchSize;
+    
+    MSER calculator;
+    std::vector<double> timings;
+    for (size_t rep = 0; rep < repetitions; ++rep) {
+        AllocationScope allocations;
+        auto start = Clock::now();
+        mser::MSERResult result = calculate(calculator, data);
+        auto end = Clock::now();
+        
+        timings.push_back(elapsedNs(start, end) / data.size());
+        record.allocations = allocations.count();
+        record.allocatedBytes = allocations.bytes();
+        record.truncationPoint = result.truncationPoint;
+    }
+    
+    record.nsPerSample = percentile(timings, 0.5);
+    return record;
+}
+
+/**
+ * SteadyStateDetector::addDataPoint の計測
+ *
+ * 収束閾値を負にして最後まで収束させず、全系列でチェックコストを測る。
+ * 1回目は全体の所要時間、2回目は呼び出しごとの所要時間を計測する
+ */
+BenchmarkRecord benchmarkDetector(const std::string& mode, Workload workload,
+                                  const TimeSeriesData& data, size_t checkInterval) {
+    BenchmarkRecord record;
+    record.benchmark = "addDataPoint";
+    record.workload = mser::bench::toString(workload);
+    record.mode = mode;
+    record.n = data.size();
+    record.batchSize = 5;
+    record.checkInterval = checkInterval;
+    
+    SteadyStateConfig config;
+    config.variant = MSERVariant::MSER_5;
+    config.maxSamples = data.size();
+    config.checkInterval = checkInterval;
+    config.convergenceThreshold = -1.0;
+    config.enableIncremental = (mode == "incremental");
+    config.enableStreaming = (mode == "streaming");
+    
+    {
+        SteadyStateDetector detector(config);
+        AllocationScope allocations;
+        auto start = Clock::now();
+        for (double value : data) {
+            detector.addDataPoint(value);
+        }
+        auto end = Clock::now();
+        
+        record.nsPerSample = elapsedNs(start, end) / data.size();
+        record.allocations = allocations.count();
+        record.allocatedBytes = allocations.bytes();
+        record.truncationPoint = detector.getLastResult().truncationPoint;
+    }
+    
+    {
+        SteadyStateDetector detector(config);
+        record.checkLatencyNs.reserve(data.size() / checkInterval + 1);
+        for (double value : data) {
+            size_t lastCheck = detector.getLastResult().totalSamples;
+            auto start = Clock::now();
+            detector.addDataPoint(value);
+            auto end = Clock::now();
+            
+            if (detector.getLastResult().totalSamples != lastCheck) {
+                record.checkLatencyNs.push_back(elapsedNs(start, end));
+            }
+        }
+        record.checks = record.checkLatencyNs.size();
+    }
+    
+    return record;
+}
+
+/**
+ * MultiSteadyStateDetector::addRow の計測
+ *
+ * 各メトリック列は系列をメトリックごとに拡大したもので、収束閾値を負にして
+ * 最後まで収束させず、全メトリックを評価するチェックの所要時間を測る
+ */
+BenchmarkRecord benchmarkMultiDetector(size_t metricCount, Workload workload,
+                                       const TimeSeriesData& data, size_t checkInterval) {
+    BenchmarkRecord record;
+    record.benchmark = "addRow";
+    record.workload = mser::bench::toString(workload);
+    record.mode = "metrics=" + std::to_string(metricCount);
+    record.n = data.size();
+    record.batchSize = 5;
+    record.checkInterval = checkInterval;
+    
+    SteadyStateConfig config;
+    config.variant = MSERVariant::MSER_5;
+    config.maxSamples = data.size();
+    config.checkInterval = checkInterval;
+    config.convergenceThreshold = -1.0;
+    
+    MultiSteadyStateDetector detector(metricCount, config);
+    std::vector<double> row(metricCount);
+    record.checkLatencyNs.reserve(data.size() / checkInterval + 1);
+    double totalNs = 0.0;
+    for (double value : data) {
+        for (size_t m = 0; m < metricCount; ++m) {
+            row[m] = value * static_cast<double>(m + 1);
+        }
+        size_t lastCheck = detector.getLastResult(0).totalSamples;
+        auto start = Clock::now();
+        detector.addRow(row.data());
+        auto end = Clock::now();
+        
+        totalNs += elapsedNs(start, end);
+        if (detector.getLastResult(0).totalSamples != lastCheck) {
+            record.checkLatencyNs.push_back(elapsedNs(start, end));
+        }
+    }
+    
+    record.nsPerSample = totalNs / data.size();
+    record.checks = record.checkLatencyNs.size();
+    record.truncationPoint = detector.getLastResult(0).truncationPoint;
+    return record;
+}
+
+// ============================================================================
+// JSON出力
+// ============================================================================
+
+void writeJson(std::ostream& out, const std::vector<BenchmarkRecord>& records) {
+    out << "{\n"
+        << "  \"build\": {"
+        << "\"compiler\": \"" << __VERSION__ << "\""
+#ifdef NDEBUG
+        << ", \"assertions\": false"
+#else
+        << ", \"assertions\": true"
+#endif
+        << ", \"simd\": \"" << mser::simd::toString(mser::simd::getInstructionSet()) << "\""
+        << "},\n"
+        << "  \"results\": [";
+    
+    for (size_t i = 0; i < records.size(); ++i) {
+        const BenchmarkRecord& record = records[i];
+        out << (i == 0 ? "\n" : ",\n")
+            << "    {\"benchmark\": \"" << record.benchmark << "\""
+            << ", \"workload\": \"" << record.workload << "\"";
+        if (!record.mode.empty()) {
+            out << ", \"mode\": \"" << record.mode << "\"";
+        }
+        out << ", \"n\": " << record.n
+            << ", \"batchSize\": " << record.batchSize;
+        if (record.checkInterval != 0) {
+            out << ", \"checkInterval\": " << record.checkInterval;
+        }
+        out << ", \"nsPerSample\": " << record.nsPerSample
+            << ", \"allocations\": " << record.allocations
+            << ", \"allocatedBytes\": " << record.allocatedBytes
+            << ", \"truncationPoint\": " << record.truncationPoint;
+        if (record.checkInterval != 0) {
+            out << ", \"checks\": " << record.checks
+                << ", \"checkLatencyNs\": {"
+                << "\"p50\": " << percentile(record.checkLatencyNs, 0.50)
+                << ", \"p90\": " << percentile(record.checkLatencyNs, 0.90)
+                << ", \"p99\": " << percentile(record.checkLatencyNs, 0.99)
+                << ", \"max\": " << percentile(record.checkLatencyNs, 1.0)
+                << "}";
+        }
+        out << "}";
+    }
+    
+    out << "\n  ]\n}\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseArguments(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    
+    const Workload workloads[] = {
+        Workload::AR1_TRANSIENT, Workload::STEP_CHANGE, Workload::HEAVY_TAILED,
+    };
+    
+    std::vector<BenchmarkRecord> records;
+    
+    // オフライン計算: 系列長 × バッチサイズ
+    for (Workload workload : workloads) {
+        for (size_t n : options.offlineSizes) {
+            TimeSeriesData data = mser::bench::generateWorkload(workload, n);
+            std::cerr << "[offline] " << mser::bench::toString(workload) << " n=" << n << "\n";
+            
+            records.push_back(benchmarkOffline(
+                "calculateMSER1", workload, data, 1, options.repetitions,
+                [](MSER& calculator, const TimeSeriesData& d) {
+                    return calculator.calculateMSER1(d);
+                }));
+            records.push_back(benchmarkOffline(
+                "calculateMSER5", workload, data, 5, options.repetitions,
+                [](MSER& calculator, const TimeSeriesData& d) {
+                    return calculator.calculateMSER5(d);
+                }));
+            for (size_t batchSize : options.batchSizes) {
+                records.push_back(benchmarkOffline(
+                    "calculateMSERm", workload, data, batchSize, options.repetitions,
+                    [batchSize](MSER& calculator, const TimeSeriesData& d) {
+                        return calculator.calculateMSERm(d, batchSize);
+                    }));
+            }
+        }
+    }
+    
+    // リアルタイム検出: 系列長 × 検出モード × checkInterval
+    const char* modes[] = {"full", "incremental", "streaming"};
+    for (Workload workload : workloads) {
+        for (size_t n : options.detectorSizes) {
+            TimeSeriesData data = mser::bench::generateWorkload(workload, n);
+            for (const char* mode : modes) {
+                for (size_t checkInterval : options.checkIntervals) {
+                    std::cerr << "[detector] " << mser::bench::toString(workload) << " n=" << n
+                              << " mode=" << mode << " checkInterval=" << checkInterval << "\n";
+                    records.push_back(benchmarkDetector(mode, workload, data, checkInterval));
+                }
+            }
+        }
+    }
+    
+    // 多メトリック検出: メトリック数（最大の checkInterval のみ）
+    for (Workload workload : workloads) {
+        for (size_t n : options.detectorSizes) {
+            TimeSeriesData data = mser::bench::generateWorkload(workload, n);
+            for (size_t metricCount : {20, 200}) {
+                std::cerr << "[multi] " << mser::bench::toString(workload) << " n=" << n
+                          << " metrics=" << metricCount << "\n";
+                records.push_back(benchmarkMultiDetector(metricCount, workload, data,
+                                                         options.checkIntervals.back()));
+            }
+        }
+    }
+    
+    if (options.outputPath.empty()) {
+        writeJson(std::cout, records);
+        return 0;
+    }
+    
+    std::ofstream output(options.outputPath);
+    if (!output) {
+        std::cerr << "出力ファイルを開けません: " << options.outputPath << "\n";
+        return 1;
+    }
+    writeJson(output, records);
+    
+    return 0;
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "mser/types.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+
+namespace mser {
+namespace bench {
+
+/**
+ * 合成ワークロードの種類
+ */
+enum class Workload {
+    AR1_TRANSIENT,  // 指数減衰する初期過渡 + AR(1)ノイズ
+    STEP_CHANGE,    // 初期区間の段階的な水準変化 + 白色ノイズ
+    HEAVY_TAILED    // 指数減衰する初期過渡 + Student-t(ν=3) ノイズ
+};
+
+/**
+ * ワークロード名取得
+ */
+inline const char* toString(Workload workload) {
+    switch (workload) {
+        case Workload::AR1_TRANSIENT:
+            return "ar1_transient";
+        case Workload::STEP_CHANGE:
+            return "step_change";
+        case Workload::HEAVY_TAILED:
+            return "heavy_tailed";
+        default:
+            return "unknown";
+    }
+}
+
+/**
+ * 合成時系列の生成（シード固定で再現可能）
+ *
+ * いずれも定常平均 10、初期過渡は系列長の約5%で減衰する
+ * @param workload ワークロードの種類
+ * @param n 系列長
+ * @param seed 乱数シード
+ * @return 生成した時系列
+ */
+inline TimeSeriesData generateWorkload(Workload workload, size_t n, std::uint64_t seed = 42) {
+    std::mt19937_64 rng(seed);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    std::chi_squared_distribution<double> chiSquared(3.0);
+    
+    TimeSeriesData data(n);
+    double transientScale = std::max(static_cast<double>(n) / 20.0, 1.0);
+    
+    switch (workload) {
+        case Workload::AR1_TRANSIENT: {
+            const double phi = 0.9;  // 自己相関係数
+            double noise = 0.0;
+            for (size_t i = 0; i < n; ++i) {
+                noise = phi * noise + std::sqrt(1.0 - phi * phi) * normal(rng);
+                data[i] = 10.0 + 20.0 * std::exp(-static_cast<double>(i) / transientScale) + noise;
+            }
+            break;
+        }
+        case Workload::STEP_CHANGE: {
+            // 初期10%を4段の水準（25, 20, 15, 12）に分け、その後は10で一定
+            size_t stepLength = std::max<size_t>(n / 40, 1);
+            const double levels[] = {25.0, 20.0, 15.0, 12.0};
+            for (size_t i = 0; i < n; ++i) {
+                size_t step = i / stepLength;
+                double level = (step < 4) ? levels[step] : 10.0;
+                data[i] = level + normal(rng);
+            }
+            break;
+        }
+        case Workload::HEAVY_TAILED:
+        default: {
+            for (size_t i = 0; i < n; ++i) {
+                double t = normal(rng) / std::sqrt(chiSquared(rng) / 3.0);
+                data[i] = 10.0 + 20.0 * std::exp(-static_cast<double>(i) / transientScale) + t;
+            }
+            break;
+        }
+    }
+    
+    return data;
+}
+
+} // namespace bench
+} // namespace mser
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "spsc_ring_buffer.h"
+#include "steady_state_detector.h"
+#include "types.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace mser {
+
+/**
+ * 非同期定常状態検出器
+ *
+ * 呼び出し側（シミュレーションのステップスレッド）はSPSCリングバッファへの
+ * 値の追加のみを行い、専用の解析スレッドがバッファを取り出して収束チェックを実行する。
+ * addDataPoint のコストは checkInterval やデータ量に依存せず一定
+ */
+class AsyncSteadyStateDetector {
+public:
+    /**
+     * コンストラクター（解析スレッドを開始）
+     * @param config 検出設定
+     * @param bufferCapacity リングバッファ容量（2のべき乗に切り上げ）
+     */
+    explicit AsyncSteadyStateDetector(const SteadyStateConfig& config = SteadyStateConfig(),
+                                      size_t bufferCapacity = 4096);
+    
+    /**
+     * デストラクター（解析スレッドを停止）
+     */
+    ~AsyncSteadyStateDetector();
+    
+    AsyncSteadyStateDetector(const AsyncSteadyStateDetector&) = delete;
+    AsyncSteadyStateDetector& operator=(const AsyncSteadyStateDetector&) = delete;
+    
+    // ============================================================================
+    // リアルタイム検出機能（生産者スレッド専用）
+    // ============================================================================
+    
+    /**
+     * データポイント追加（wait-free）
+     * バッファが満杯の場合は値を破棄し、破棄数に計上する
+     * @param value 新しいデータ値
+     * @return 解析スレッドが定常状態を検出済みの場合true
+     */
+    bool addDataPoint(TimeSeriesValue value);
+    
+    /**
+     * 追加済みの全データが解析されるまで待機（条件変数で待機し、CPUを消費しない）
+     * 収束・停止した場合は未処理データが残っていても戻る
+     */
+    void flush();
+    
+    /**
+     * 解析スレッド停止（未処理データは処理してから停止）
+     */
+    void stop();
+    
+    // ============================================================================
+    // 状態取得機能（任意のスレッドから呼び出し可能）
+    // ============================================================================
+    
+    /**
+     * 収束状態取得
+     */
+    bool hasConverged() const;
+    
+    /**
+     * 最新のMSER結果取得（コピー）
+     */
+    MSERResult getLastResult() const;
+    
+    /**
+     * 解析済みサンプル数取得
+     */
+    size_t getProcessedCount() const;
+    
+    /**
+     * バッファ満杯により破棄されたサンプル数取得
+     */
+    size_t getDroppedCount() const;
+    
+    // ============================================================================
+    // 設定機能
+    // ============================================================================
+    
+    /**
+     * コールバック設定（収束検出時に解析スレッド上で呼び出される）
+     * 任意のスレッドからいつでも変更できる。変更前に収束していた場合は呼び出されない
+     */
+    void setConvergenceCallback(std::function<void(const MSERResult&)> callback);
+
+private:
+    // ============================================================================
+    // 内部状態
+    // ============================================================================
+    
+    SpscRingBuffer<TimeSeriesValue> buffer_;    // 生産者→解析スレッドのバッファ
+    SteadyStateDetector detector_;              // 解析スレッド専用の検出器
+    size_t pushedCount_;                        // 追加済みサンプル数（生産者専用）
+    
+    std::atomic<bool> running_;                 // 解析スレッド稼働フラグ
+    std::atomic<bool> converged_;               // 収束フラグ（公開用）
+    std::atomic<size_t> processedCount_;        // 解析済みサンプル数
+    std::atomic<size_t> droppedCount_;          // 破棄サンプル数
+    
+    mutable std::mutex resultMutex_;            // lastResult_ 保護
+    MSERResult lastResult_;                     // 最新結果（公開用）
+    
+    std::mutex callbackMutex_;                  // convergenceCallback_ の受け渡し保護
+    std::function<void(const MSERResult&)> convergenceCallback_;  // コールバック
+    
+    std::mutex progressMutex_;                  // flush の待機用
+    std::condition_variable progressChanged_;   // 解析の進行・収束・停止の通知
+    
+    std::thread worker_;                        // 解析スレッド
+    
+    // ============================================================================
+    // 内部機能
+    // ============================================================================
+    
+    /**
+     * 解析スレッド本体
+     */
+    void run();
+    
+    /**
+     * バッファの取り出しと解析
+     * @return 取り出したサンプル数
+     */
+    size_t drain();
+    
+    /**
+     * flush で待機中のスレッドへの通知
+     */
+    void notifyProgress();
+};
+
+} // namespace mser
@@ -0,0 +1,225 @@
+#pragma once
+
+#include "types.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace mser {
+
+// ============================================================================
+// チェックポイント形式
+// ============================================================================
+
+/**
+ * チェックポイントの識別子・形式バージョン
+ *
+ * 形式: マジック(8) | バージョン(u32) | バイト順マーカー(u32) | 本体
+ * 整数はすべて固定幅（size_t は u64）、浮動小数点は IEEE 754 のビット列をそのまま格納する。
+ * バイト順は書き込み側のホスト順で、異なるバイト順の読み込みは失敗として扱う
+ */
+constexpr char kCheckpointMagic[8] = {'M', 'S', 'E', 'R', 'C', 'K', 'P', 'T'};
+constexpr std::uint32_t kCheckpointVersion = 7;  // 2: 非有限値の取り込み方針、3: 時間重み付き状態、4: チェックの分割実行、5: 時間重み付き状態の累積和を廃止、6: 取り込み済みサンプルの統計量、7: インクリメンタル状態の累積和を廃止
+constexpr std::uint32_t kCheckpointByteOrderMark = 0x01020304u;
+
+/**
+ * チェックポイント書き込み（バッファ末尾への追記）
+ */
+class CheckpointWriter {
+public:
+    /**
+     * コンストラクター
+     * @param buffer 書き込み先バッファ（末尾に追記）
+     */
+    explicit CheckpointWriter(std::vector<std::uint8_t>& buffer) : buffer_(buffer) {}
+    
+    /**
+     * ヘッダー書き込み（マジック・バージョン・バイト順マーカー）
+     */
+    void writeHeader() {
+        writeBytes(kCheckpointMagic, sizeof(kCheckpointMagic));
+        write(kCheckpointVersion);
+        write(kCheckpointByteOrderMark);
+    }
+    
+    /**
+     * 固定幅の値の書き込み
+     */
+    template <typename T>
+    void write(const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "checkpoint values must be trivially copyable");
+        writeBytes(&value, sizeof(T));
+    }
+    
+    /**
+     * サイズ・インデックスの書き込み（u64）
+     */
+    void writeSize(size_t value) {
+        write(static_cast<std::uint64_t>(value));
+    }
+    
+    /**
+     * 真偽値の書き込み（u8）
+     */
+    void writeBool(bool value) {
+        write(static_cast<std::uint8_t>(value ? 1 : 0));
+    }
+    
+    /**
+     * 配列の書き込み（要素数 u64 + 要素のビット列）
+     */
+    template <typename T>
+    void writeArray(const std::vector<T>& values) {
+        static_assert(std::is_trivially_copyable<T>::value, "checkpoint values must be trivially copyable");
+        writeSize(values.size());
+        writeBytes(values.data(), values.size() * sizeof(T));
+    }
+
+private:
+    std::vector<std::uint8_t>& buffer_;     // 書き込み先
+    
+    void writeBytes(const void* data, size_t size) {
+        if (size == 0) {
+            return;
+        }
+        size_t offset = buffer_.size();
+        buffer_.resize(offset + size);
+        std::memcpy(buffer_.data() + offset, data, size);
+    }
+};
+
+/**
+ * チェックポイント読み込み（境界検査付き、失敗時は false）
+ */
+class CheckpointReader {
+public:
+    /**
+     * コンストラクター
+     * @param data 読み込み元
+     * @param size バイト数
+     */
+    CheckpointReader(const std::uint8_t* data, size_t size)
+        : data_(data), size_(size), offset_(0) {}
+    
+    /**
+     * ヘッダー検証（マジック・バージョン・バイト順）
+     */
+    bool readHeader() {
+        char magic[sizeof(kCheckpointMagic)];
+        std::uint32_t version = 0;
+        std::uint32_t byteOrderMark = 0;
+        return readBytes(magic, sizeof(magic)) &&
+               std::memcmp(magic, kCheckpointMagic, sizeof(magic)) == 0 &&
+               read(version) && version == kCheckpointVersion &&
+               read(byteOrderMark) && byteOrderMark == kCheckpointByteOrderMark;
+    }
+    
+    /**
+     * 固定幅の値の読み込み
+     */
+    template <typename T>
+    bool read(T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "checkpoint values must be trivially copyable");
+        return readBytes(&value, sizeof(T));
+    }
+    
+    /**
+     * サイズ・インデックスの読み込み（u64、size_t に収まらない場合は失敗）
+     */
+    bool readSize(size_t& value) {
+        std::uint64_t raw = 0;
+        if (!read(raw) || raw > static_cast<std::uint64_t>(SIZE_MAX)) {
+            return false;
+        }
+        value = static_cast<size_t>(raw);
+        return true;
+    }
+    
+    /**
+     * 真偽値の読み込み（0/1以外は失敗）
+     */
+    bool readBool(bool& value) {
+        std::uint8_t raw = 0;
+        if (!read(raw) || raw > 1) {
+            return false;
+        }
+        value = (raw == 1);
+        return true;
+    }
+    
+    /**
+     * 配列の読み込み（要素数が残りバイト数を超える場合は失敗）
+     */
+    template <typename T>
+    bool readArray(std::vector<T>& values) {
+        static_assert(std::is_trivially_copyable<T>::value, "checkpoint values must be trivially copyable");
+        size_t count = 0;
+        if (!readSize(count) || count > (size_ - offset_) / sizeof(T)) {
+            return false;
+        }
+        values.resize(count);
+        return readBytes(values.data(), count * sizeof(T));
+    }
+    
+    /**
+     * 全バイトを読み終えたか
+     */
+    bool atEnd() const {
+        return offset_ == size_;
+    }
+
+private:
+    const std::uint8_t* data_;      // 読み込み元
+    size_t size_;                   // 全バイト数
+    size_t offset_;                 // 読み込み位置
+    
+    bool readBytes(void* out, size_t size) {
+        if (size > size_ - offset_) {
+            return false;
+        }
+        if (size != 0) {
+            std::memcpy(out, data_ + offset_, size);
+        }
+        offset_ += size;
+        return true;
+    }
+};
+
+// ============================================================================
+// 共通構造体のシリアライズ
+// ============================================================================
+
+/**
+ * 検出設定の書き込み
+ */
+void writeConfig(CheckpointWriter& writer, const SteadyStateConfig& config);
+
+/**
+ * 検出設定の読み込み（列挙値が範囲外の場合は失敗）
+ */
+bool readConfig(CheckpointReader& reader, SteadyStateConfig& config);
+
+/**
+ * MSER計算結果の書き込み
+ */
+void writeResult(CheckpointWriter& writer, const MSERResult& result);
+
+/**
+ * MSER計算結果の読み込み
+ */
+bool readResult(CheckpointReader& reader, MSERResult& result);
+
+/**
+ * バッファのファイル書き出し（一括書き込み）
+ */
+bool writeCheckpointFile(const std::string& path, const std::vector<std::uint8_t>& buffer);
+
+/**
+ * ファイルのバッファ読み込み（一括読み込み）
+ */
+bool readCheckpointFile(const std::string& path, std::vector<std::uint8_t>& buffer);
+
+} // namespace mser
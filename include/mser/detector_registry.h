@@ -0,0 +1,227 @@
+#pragma once
+
+#include "incremental_mser.h"
+#include "thread_pool.h"
+#include "types.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace mser {
+
+/**
+ * 検出器ID
+ */
+using DetectorId = std::uint64_t;
+
+/**
+ * 検出器レジストリへの入力サンプル
+ */
+struct DetectorSample {
+    DetectorId id;                          // 検出器ID
+    TimeSeriesValue value;                  // データ値
+};
+
+/**
+ * シャード化検出器レジストリ
+ *
+ * 数万個のエンティティごとの定常状態検出を1つのレジストリで管理する。
+ * 検出器はIDのハッシュでシャードに振り分けられ、シャード内の連続配列に
+ * インクリメンタル状態（部分バッチ和とバッチ平均）のみを保持する。
+ * 検出器ごとのコールバック・MSER計算器・生データ領域は持たず、初回サンプルで生成される
+ *
+ * ingest はサンプルをシャードごとに振り分けてシャード単位で並列に取り込み、
+ * チェック時期に達した検出器を一定数ずつの作業バッチにまとめて
+ * ワークスティーリング・スレッドプール上で評価する。新たに収束した検出器のIDを返す
+ */
+class DetectorRegistry {
+public:
+    /**
+     * コンストラクター
+     * @param config 検出設定（全検出器共通、インクリメンタル計算を使用。
+     *               checkSchedule の TIME_BUDGET は検出器ごとの時刻計測を行わないため FIXED として扱う）
+     * @param shardCount シャード数（2のべき乗に切り上げ、0は既定値）
+     * @param threadCount スレッド数（0はハードウェア並列数）
+     */
+    explicit DetectorRegistry(const SteadyStateConfig& config = SteadyStateConfig(),
+                              size_t shardCount = 0, size_t threadCount = 0);
+    
+    /**
+     * デストラクター
+     */
+    ~DetectorRegistry();
+    
+    // ============================================================================
+    // リアルタイム検出機能
+    // ============================================================================
+    
+    /**
+     * サンプルの一括取り込みと期限到来チェックの評価
+     *
+     * 同一IDのサンプルは入力順に取り込まれる。収束済み・最大サンプル数到達済みの
+     * 検出器へのサンプルは無視される
+     * @param samples サンプル配列
+     * @param count サンプル数
+     * @return この呼び出しで新たに収束した検出器のID（次回の ingest 呼び出しまで有効）
+     */
+    const std::vector<DetectorId>& ingest(const DetectorSample* samples, size_t count);
+    
+    /**
+     * サンプルの一括取り込みと期限到来チェックの評価
+     */
+    const std::vector<DetectorId>& ingest(const std::vector<DetectorSample>& samples);
+    
+    /**
+     * 検出器の削除
+     * @return 登録されていた場合true
+     */
+    bool remove(DetectorId id);
+    
+    /**
+     * 全検出器の削除
+     */
+    void clear();
+    
+    // ============================================================================
+    // 状態取得機能
+    // ============================================================================
+    
+    /**
+     * 登録検出器数取得
+     */
+    size_t size() const;
+    
+    /**
+     * 検出器の登録判定
+     */
+    bool contains(DetectorId id) const;
+    
+    /**
+     * 収束状態取得（未登録の場合false）
+     */
+    bool hasConverged(DetectorId id) const;
+    
+    /**
+     * 最大サンプル数到達判定（未登録の場合false）
+     */
+    bool hasReachedMaxSamples(DetectorId id) const;
+    
+    /**
+     * 取り込み済みサンプル数取得（未登録の場合0）
+     */
+    size_t getSampleCount(DetectorId id) const;
+    
+    /**
+     * 最新のMSER結果取得
+     * @return 未登録の場合 nullptr（次回の ingest・remove 呼び出しまで有効）
+     */
+    const MSERResult* getLastResult(DetectorId id) const;
+    
+    /**
+     * 収束済み検出器数取得
+     */
+    size_t getConvergedCount() const;
+    
+    /**
+     * シャード数取得
+     */
+    size_t getShardCount() const;
+    
+    /**
+     * スレッド数取得
+     */
+    size_t getThreadCount() const;
+    
+    /**
+     * 確保済みメモリ量取得（検出器状態・索引・作業領域の容量）
+     */
+    size_t getBytesHeld() const;
+
+private:
+    // ============================================================================
+    // 内部状態
+    // ============================================================================
+    
+    /**
+     * 検出器1個分の状態
+     */
+    struct Entry {
+        DetectorId id;                      // 検出器ID
+        IncrementalMSER state;              // 部分バッチ和とバッチ平均
+        MSERResult lastResult;              // 最新結果
+        size_t lastCheckIndex;              // 最後のチェック位置
+        TimeSeriesValue lastFiniteValue;    // 直前の有限値（CLAMP時の置換値）
+        bool hasFiniteValue;                // 有限値を取り込み済みか
+        bool converged;                     // 収束フラグ
+        bool maxSamplesReached;             // 最大サンプル数到達フラグ
+        bool due;                           // 今回の ingest でチェック対象
+        
+        Entry(DetectorId entryId, const SteadyStateConfig& config);
+    };
+    
+    /**
+     * シャード（シャード内の検出器はシャードを担当するタスクのみが更新する）
+     */
+    struct Shard {
+        std::vector<Entry> entries;                         // 検出器状態（連続配列）
+        std::unordered_map<DetectorId, size_t> index;       // ID → entries 内の位置
+        std::vector<size_t> due;                            // 今回のチェック対象（entries 内の位置）
+    };
+    
+    /**
+     * チェック対象の検出器
+     */
+    struct DueCheck {
+        size_t shard;                       // シャード番号
+        size_t slot;                        // entries 内の位置
+    };
+    
+    SteadyStateConfig config_;              // 検出設定
+    size_t shardMask_;                      // シャード数 - 1
+    size_t convergedCount_;                 // 収束済み検出器数
+    std::vector<Shard> shards_;             // シャード
+    std::unique_ptr<ThreadPool> pool_;      // ワークスティーリング・スレッドプール
+    
+    std::vector<size_t> shardOffsets_;      // [shard+1] 振り分け後のサンプル位置（作業領域）
+    std::vector<size_t> sampleOrder_;       // シャード順に並べたサンプル番号（作業領域）
+    std::vector<DueCheck> dueChecks_;       // 全シャードのチェック対象（作業領域）
+    std::vector<DetectorId> convergedIds_;  // 新たに収束した検出器のID
+    
+    // ============================================================================
+    // 内部機能
+    // ============================================================================
+    
+    /**
+     * IDからシャード番号を決定
+     */
+    size_t shardOf(DetectorId id) const;
+    
+    /**
+     * IDに対応する検出器の検索（未登録の場合 nullptr）
+     */
+    const Entry* find(DetectorId id) const;
+    
+    /**
+     * シャード内のサンプル取り込み（シャード担当タスクから呼び出す）
+     */
+    void ingestShard(size_t shard, const DetectorSample* samples);
+    
+    /**
+     * 1サンプルの取り込み
+     */
+    void addValue(Entry& entry, TimeSeriesValue value);
+    
+    /**
+     * 検査タイミング判定
+     */
+    bool shouldPerformCheck(const Entry& entry) const;
+    
+    /**
+     * 収束チェック（作業バッチのタスクから呼び出す）
+     */
+    void checkConvergence(Entry& entry) const;
+};
+
+} // namespace mser
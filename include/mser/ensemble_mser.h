@@ -0,0 +1,94 @@
+#pragma once
+
+#include "thread_pool.h"
+#include "types.h"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace mser {
+
+/**
+ * 複数レプリケーション（アンサンブル）解析結果
+ */
+struct EnsembleResult {
+    std::vector<MSERResult> replications;   // レプリケーションごとのMSER結果
+    MSERResult averageResult;               // レプリケーション平均系列のMSER結果
+    size_t averageLength;                   // 平均系列長（最短レプリケーション長）
+    size_t truncationSample;                // 共通切り捨て点（サンプル単位）
+    
+    // 切り捨て点の分布（収束したレプリケーション、サンプル単位）
+    size_t convergedCount;                  // 収束したレプリケーション数
+    size_t truncationMin;                   // 最小値
+    size_t truncationMedian;                // 中央値
+    size_t truncationMax;                   // 最大値
+    double truncationMean;                  // 平均
+    double truncationStdDev;                // 標準偏差
+    
+    // 共通切り捨て点以降のレプリケーション平均による推定
+    double pooledMean;                      // レプリケーション平均の平均
+    double standardError;                   // 標準誤差 s/√R
+    
+    EnsembleResult() : averageLength(0), truncationSample(0), convergedCount(0),
+                       truncationMin(0), truncationMedian(0), truncationMax(0),
+                       truncationMean(0.0), truncationStdDev(0.0),
+                       pooledMean(0.0), standardError(0.0) {}
+};
+
+/**
+ * 複数レプリケーションMSER解析クラス
+ *
+ * 独立なR本のレプリケーションについて、レプリケーションごとのMSER計算を
+ * ワークスティーリング・スレッドプール上で並列実行し、レプリケーション平均系列の
+ * 切り捨て点（共通切り捨て点）と、その切り捨て点以降のレプリケーション平均から
+ * 全体平均と標準誤差を求める
+ */
+class EnsembleMSER {
+public:
+    /**
+     * コンストラクター
+     * @param threadCount スレッド数（0はハードウェア並列数）
+     */
+    explicit EnsembleMSER(size_t threadCount = 0);
+    
+    /**
+     * デストラクター
+     */
+    ~EnsembleMSER();
+    
+    // ============================================================================
+    // 解析機能
+    // ============================================================================
+    
+    /**
+     * アンサンブル解析
+     * @param replications レプリケーションごとの時系列（長さは不揃いでもよい）
+     * @param config 検出設定（variant・batchSize・algorithm を使用）
+     * @return アンサンブル解析結果（平均系列が未収束の場合 averageResult.converged=false）
+     */
+    EnsembleResult analyze(const std::vector<TimeSeriesData>& replications,
+                           const SteadyStateConfig& config = SteadyStateConfig());
+    
+    /**
+     * スレッド数取得
+     */
+    size_t getThreadCount() const;
+
+private:
+    // ============================================================================
+    // 内部状態
+    // ============================================================================
+    
+    std::unique_ptr<ThreadPool> pool_;      // ワークスティーリング・スレッドプール
+    
+    // ============================================================================
+    // 内部機能
+    // ============================================================================
+    
+    /**
+     * 切り捨て点分布の集計
+     */
+    static void summarizeTruncations(EnsembleResult& result);
+};
+
+} // namespace mser
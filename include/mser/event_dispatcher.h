@@ -0,0 +1,252 @@
+#pragma once
+
+#include "mpsc_ring_buffer.h"
+#include "types.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace mser {
+
+/**
+ * 検出イベントの種類
+ */
+enum class DetectorEventType {
+    CONVERGED,              // 定常状態を検出
+    MAX_SAMPLES_REACHED     // 収束前に最大サンプル数に到達
+};
+
+/**
+ * 検出イベント（キューにそのまま格納できるよう trivially copyable）
+ */
+struct DetectorEvent {
+    DetectorEventType type;     // イベントの種類
+    const char* source;         // 発行元名（EventDispatcher::registerSource が保持）
+    std::uint64_t sequence;     // 発行順の通し番号（破棄された番号は欠番になる）
+    std::int64_t timestampNs;   // 発行時刻（steady_clock、ナノ秒）
+    MSERResult result;          // 発行時点のMSER計算結果
+    
+    DetectorEvent() : type(DetectorEventType::CONVERGED), source(""), sequence(0), timestampNs(0) {}
+};
+
+/**
+ * イベントログの出力形式
+ */
+enum class EventLogFormat {
+    TEXT,   // 人が読むための複数行テキスト
+    JSON    // 1イベント1行の JSON（JSON Lines）
+};
+
+/**
+ * イベントの出力先（ディスパッチスレッドからバッチ単位で呼び出される）
+ */
+class EventSink {
+public:
+    virtual ~EventSink() = default;
+    
+    /**
+     * イベントのバッチ書き込み
+     * @param events イベント配列（発行順）
+     * @param count イベント数
+     */
+    virtual void write(const DetectorEvent* events, size_t count) = 0;
+};
+
+/**
+ * ストリーム・ファイルへのログ出力
+ *
+ * バッチ全体を内部バッファに整形してから1回の書き込みとフラッシュで出力する
+ */
+class StreamEventSink : public EventSink {
+public:
+    /**
+     * ストリームへの出力（ストリームはシンクより長く生存すること）
+     * @param out 出力先
+     * @param format 出力形式
+     */
+    explicit StreamEventSink(std::ostream& out, EventLogFormat format = EventLogFormat::TEXT);
+    
+    /**
+     * ファイルへの出力（追記）
+     * @param path 出力ファイル
+     * @param format 出力形式
+     */
+    explicit StreamEventSink(const std::string& path, EventLogFormat format = EventLogFormat::JSON);
+    
+    void write(const DetectorEvent* events, size_t count) override;
+    
+    /**
+     * 出力先が書き込み可能か
+     */
+    bool isOpen() const;
+    
+    /**
+     * 出力形式取得
+     */
+    EventLogFormat getFormat() const;
+
+private:
+    std::unique_ptr<std::ofstream> file_;   // ファイル出力時の出力先
+    std::ostream& out_;                     // 出力先
+    EventLogFormat format_;                 // 出力形式
+    std::ostringstream buffer_;             // バッチの整形用バッファ（再利用）
+    
+    void formatText(const DetectorEvent& event);
+    void formatJson(const DetectorEvent& event);
+};
+
+/**
+ * 検出イベントの非同期配信
+ *
+ * 検出器（シミュレーションのステップスレッド）はロックフリーのMPSCキューへの
+ * イベント追加のみを行い、専用のディスパッチスレッドがバッチ単位で取り出して
+ * 購読コールバックとシンクに配信する。発行側では入出力・ロック・ヒープ確保を行わない
+ */
+class EventDispatcher {
+public:
+    /**
+     * コンストラクター（ディスパッチスレッドを開始）
+     * @param queueCapacity キュー容量（2のべき乗に切り上げ）
+     */
+    explicit EventDispatcher(size_t queueCapacity = 1024);
+    
+    /**
+     * デストラクター（未配信イベントを配信してから停止）
+     */
+    ~EventDispatcher();
+    
+    EventDispatcher(const EventDispatcher&) = delete;
+    EventDispatcher& operator=(const EventDispatcher&) = delete;
+    
+    // ============================================================================
+    // イベント発行機能（任意のスレッドから呼び出し可能）
+    // ============================================================================
+    
+    /**
+     * イベント発行（ロックフリー）
+     * キューが満杯の場合はイベントを破棄し、破棄数に計上する
+     * @param type イベントの種類
+     * @param source 発行元名（registerSource の戻り値）
+     * @param result MSER計算結果
+     * @return キューに追加できた場合true
+     */
+    bool publish(DetectorEventType type, const char* source, const MSERResult& result);
+    
+    /**
+     * 発行元名の登録（同名は同じポインタを返す）
+     * @return ディスパッチャーの生存期間中有効な名前
+     */
+    const char* registerSource(const std::string& name);
+    
+    // ============================================================================
+    // 配信先設定機能
+    // ============================================================================
+    
+    /**
+     * 購読コールバック追加（ディスパッチスレッド上で発行順に呼び出される）
+     * コールバック内から subscribe・addSink・registerSource を呼び出さないこと
+     */
+    void subscribe(std::function<void(const DetectorEvent&)> callback);
+    
+    /**
+     * シンク追加
+     */
+    void addSink(std::shared_ptr<EventSink> sink);
+    
+    // ============================================================================
+    // 制御機能
+    // ============================================================================
+    
+    /**
+     * 発行済みの全イベントが配信されるまで待機（条件変数で待機、停止済みの場合は即座に戻る）
+     * コールバック・シンクから呼び出さないこと
+     */
+    void flush();
+    
+    /**
+     * ディスパッチスレッド停止（未配信イベントは配信してから停止）
+     * 停止後に発行されたイベントは配信されない
+     */
+    void stop();
+    
+    // ============================================================================
+    // 状態取得機能
+    // ============================================================================
+    
+    /**
+     * キューに追加されたイベント数取得
+     */
+    size_t getPublishedCount() const;
+    
+    /**
+     * 配信済みイベント数取得
+     */
+    size_t getDeliveredCount() const;
+    
+    /**
+     * キュー満杯により破棄されたイベント数取得
+     */
+    size_t getDroppedCount() const;
+
+private:
+    // ============================================================================
+    // 内部状態
+    // ============================================================================
+    
+    MpscRingBuffer<DetectorEvent> queue_;       // 発行側→ディスパッチスレッドのキュー
+    
+    std::atomic<bool> running_;                 // ディスパッチスレッド稼働フラグ
+    std::atomic<std::uint64_t> sequence_;       // 次の通し番号
+    std::atomic<size_t> publishedCount_;        // キューに追加されたイベント数
+    std::atomic<size_t> deliveredCount_;        // 配信済みイベント数
+    std::atomic<size_t> droppedCount_;          // 破棄イベント数
+    
+    std::mutex subscribersMutex_;               // 配信先・発行元名の保護
+    std::vector<std::function<void(const DetectorEvent&)>> callbacks_;  // 購読コールバック
+    std::vector<std::shared_ptr<EventSink>> sinks_;                     // シンク
+    std::deque<std::string> sources_;           // 発行元名（参照が無効化されない deque で保持）
+    
+    std::mutex progressMutex_;                  // flush の待機用
+    std::condition_variable progressChanged_;   // 配信の進行・停止の通知
+    
+    std::thread worker_;                        // ディスパッチスレッド
+    
+    // ============================================================================
+    // 内部機能
+    // ============================================================================
+    
+    /**
+     * ディスパッチスレッド本体
+     */
+    void run();
+    
+    /**
+     * キューの取り出しと配信
+     * @return 配信したイベント数
+     */
+    size_t drain();
+    
+    /**
+     * flush で待機中のスレッドへの通知
+     */
+    void notifyProgress();
+};
+
+/**
+ * 既定のディスパッチャー取得（標準出力へのテキストシンク付き、初回呼び出し時に開始）
+ * 統合ヘルパー関数で作成した検出器の既定の配信先
+ */
+EventDispatcher& defaultEventDispatcher();
+
+} // namespace mser
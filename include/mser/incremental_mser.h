@@ -0,0 +1,249 @@
+#pragma once
+
+#include "checkpoint.h"
+#include "types.h"
+#include <vector>
+#include <cstddef>
+#include <utility>
+
+namespace mser {
+
+/**
+ * インクリメンタルMSER状態
+ *
+ * データ点の追加ごとに部分バッチ和・完了バッチ平均を O(1) で更新し、
+ * 切り捨て点探索をバッチ数に比例するO(b)の走査のみで行う。
+ * batchSize=1 の場合はMSER-1と等価
+ *
+ * バッチ数上限を設定すると、上限到達時に隣接バッチ平均を2つずつ統合して
+ * バッチサイズを倍増させる（動的バッチング）。メモリとチェックコストは上限に比例する
+ */
+class IncrementalMSER {
+public:
+    /**
+     * コンストラクター
+     * @param batchSize バッチサイズ（1でMSER-1）
+     */
+    explicit IncrementalMSER(size_t batchSize = 5);
+    
+    /**
+     * デストラクター
+     */
+    ~IncrementalMSER();
+    
+    /**
+     * コピー・ムーブ（配列に格納した際の再配置で状態を複製しないようムーブを明示）
+     */
+    IncrementalMSER(const IncrementalMSER&) = default;
+    IncrementalMSER& operator=(const IncrementalMSER&) = default;
+    IncrementalMSER(IncrementalMSER&&) noexcept = default;
+    IncrementalMSER& operator=(IncrementalMSER&&) noexcept = default;
+    
+    // ============================================================================
+    // データ更新機能
+    // ============================================================================
+    
+    /**
+     * データポイント追加（O(1)）
+     * @param value 新しいデータ値
+     */
+    void addValue(TimeSeriesValue value);
+    
+    /**
+     * 状態リセット（確保済みメモリは保持）
+     */
+    void reset();
+    
+    /**
+     * バッチサイズ変更（状態はリセットされる）
+     */
+    void setBatchSize(size_t batchSize);
+    
+    /**
+     * 想定バッチ数分のメモリ予約
+     */
+    void reserve(size_t batchCount);
+    
+    /**
+     * 保持バッチ数上限の設定（0で無制限）
+     * 上限は20以上の偶数に丸められる
+     */
+    void setBatchLimit(size_t maxBatches);
+    
+    // ============================================================================
+    // MSER計算機能
+    // ============================================================================
+    
+    /**
+     * 最適な切り捨て点の検索（バッチ平均系列上、O(b)）
+     * 現在の平均でシフトした後方累積で接尾和を求める
+     * @return 切り捨て点（バッチ単位）とMSER値のペア
+     */
+    std::pair<size_t, double> findOptimalTruncationPoint() const;
+    
+    /**
+     * 検証条件の確認と結果の共通項目の設定（evaluate の走査前の部分）
+     * @param variant 結果に記録するMSER変種
+     * @param result 出力先（検証失敗時は未収束の結果）
+     * @return 切り捨て点の走査が必要な場合true
+     */
+    bool prepareEvaluation(MSERVariant variant, MSERResult& result) const;
+    
+    /**
+     * 現在の状態に対するMSER計算
+     * MSER::calculate と同じ検証条件・結果形式を用いる
+     * @param variant 結果に記録するMSER変種
+     * @return MSER計算結果
+     */
+    MSERResult evaluate(MSERVariant variant) const;
+    
+    // ============================================================================
+    // 状態取得機能
+    // ============================================================================
+    
+    /**
+     * 現在の実効バッチサイズ取得（圧縮により初期値の2のべき乗倍になる）
+     */
+    size_t getBatchSize() const;
+    
+    /**
+     * 保持バッチ数上限取得（0は無制限）
+     */
+    size_t getBatchLimit() const;
+    
+    /**
+     * 総サンプル数取得
+     */
+    size_t getSampleCount() const;
+    
+    /**
+     * 完了バッチ数取得
+     */
+    size_t getBatchCount() const;
+    
+    /**
+     * 完了バッチ平均系列取得
+     */
+    const TimeSeriesData& getBatchMeans() const;
+    
+    /**
+     * バッチ平均系列の改訂番号取得（リセット・圧縮・読み込みで既存要素が書き換わるたびに増加）
+     */
+    size_t getRevision() const;
+    
+    /**
+     * 確保済みメモリ量取得（バッチ平均配列の容量）
+     */
+    size_t getBytesHeld() const;
+    
+    /**
+     * 設定から有効バッチサイズを決定（MSER-1は1、MSER-5は5）
+     */
+    static size_t batchSizeFor(const SteadyStateConfig& config);
+    
+    // ============================================================================
+    // チェックポイント機能
+    // ============================================================================
+    
+    /**
+     * 状態の書き込み（部分バッチ・バッチ平均をそのまま保存）
+     */
+    void serialize(CheckpointWriter& writer) const;
+    
+    /**
+     * 状態の読み込み（再計算なし、失敗時は状態を変更しない）
+     */
+    bool deserialize(CheckpointReader& reader);
+
+private:
+    // ============================================================================
+    // 内部状態
+    // ============================================================================
+    
+    size_t baseBatchSize_;          // 初期バッチサイズ
+    size_t batchSize_;              // 実効バッチサイズ
+    size_t batchLimit_;             // 保持バッチ数上限（0は無制限）
+    size_t sampleCount_;            // 総サンプル数
+    size_t batchFill_;              // 現在の部分バッチのサンプル数
+    size_t nonFiniteCount_;         // NaN/Inf の数
+    double batchSum_;               // 現在の部分バッチの和
+    size_t revision_;               // バッチ平均系列の改訂番号（保存しない）
+    
+    TimeSeriesData batchMeans_;     // 完了バッチ平均
+    
+    /**
+     * 完了バッチの登録
+     */
+    void appendBatchMean(double batchMean);
+    
+    /**
+     * 隣接バッチ平均の統合（バッチサイズ倍増）
+     */
+    void compact();
+};
+
+/**
+ * 分割実行する切り捨て点探索
+ *
+ * 開始時点のバッチ数 b をスナップショットとして記録し、IncrementalMSER のバッチ平均の
+ * 先頭 b 要素を末尾から後方に累積する接尾和の走査（evaluate と同じ桁落ちしない走査）を
+ * 呼び出しごとの予算内で再開する。シフト量は開始時点の最後のバッチ平均（定常値の近似）を用いる。
+ * バッチ平均は追記のみで既存要素が変化しないため、走査中に追加されたバッチは結果に影響せず、
+ * 完了時の結果は開始時点の evaluate と丸め誤差の範囲で一致する。
+ * 圧縮・リセットでバッチ平均が書き換わった場合は現在の状態から走査をやり直す
+ */
+class TruncationScan {
+public:
+    /**
+     * コンストラクター（走査なし）
+     */
+    TruncationScan();
+    
+    /**
+     * 走査開始（O(1)、検証条件を満たさない場合は走査なしで結果が確定する）
+     * @param state 走査対象のインクリメンタル状態
+     * @param variant 結果に記録するMSER変種
+     */
+    void begin(const IncrementalMSER& state, MSERVariant variant);
+    
+    /**
+     * 走査の継続
+     * @param state begin と同じインクリメンタル状態
+     * @param maxPositions 累積するバッチ平均の数の上限（1以上、切り捨て候補外の末尾を含む）
+     * @return 走査が完了し結果が確定した場合true
+     */
+    bool advance(const IncrementalMSER& state, size_t maxPositions);
+    
+    /**
+     * 走査の取り消し
+     */
+    void cancel();
+    
+    /**
+     * 走査中判定（begin 後、結果が確定するまで）
+     */
+    bool isPending() const;
+    
+    /**
+     * 未走査のバッチ平均の数取得
+     */
+    size_t getRemaining() const;
+    
+    /**
+     * 確定した結果取得（走査中は途中までの最小値）
+     */
+    const MSERResult& getResult() const;
+
+private:
+    MSERResult result_;     // 結果（走査中は途中までの最小値）
+    size_t batchCount_;     // スナップショットのバッチ数
+    size_t revision_;       // スナップショットのバッチ平均系列の改訂番号
+    size_t position_;       // 未走査のバッチ平均の数（後方走査で次に累積するのは position_-1）
+    size_t endK_;           // 切り捨て候補の終了位置（含まない、⌊b/2⌋）
+    double shift_;          // 接尾和のシフト量
+    double suffixSum_;      // ∑j≥position_ (X̄j - c)
+    double suffixSumSq_;    // ∑j≥position_ (X̄j - c)²
+    bool pending_;          // 走査中フラグ
+};
+
+} // namespace mser
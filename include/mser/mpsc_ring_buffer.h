@@ -0,0 +1,124 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace mser {
+
+/**
+ * 複数生産者・単一消費者（MPSC）リングバッファ
+ *
+ * スロットごとのシーケンス番号で所有権を受け渡す有界キュー（Vyukov 方式）。
+ * 生産者側の tryPush はロックフリーで、満杯時は即座に false を返す（待機・ヒープ確保なし）。
+ * 容量は2のべき乗に切り上げられる
+ */
+template <typename T>
+class MpscRingBuffer {
+public:
+    /**
+     * コンストラクター
+     * @param capacity 最小容量（2のべき乗に切り上げ）
+     */
+    explicit MpscRingBuffer(size_t capacity)
+        : mask_(roundUpToPowerOfTwo(capacity) - 1), slots_(new Slot[mask_ + 1]), head_(0), tail_(0) {
+        for (size_t i = 0; i <= mask_; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+    
+    MpscRingBuffer(const MpscRingBuffer&) = delete;
+    MpscRingBuffer& operator=(const MpscRingBuffer&) = delete;
+    
+    /**
+     * 要素追加（任意のスレッドから呼び出し可能、ロックフリー）
+     * @return 満杯の場合false
+     */
+    bool tryPush(const T& value) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots_[tail & mask_];
+            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            
+            if (sequence == tail) {
+                // スロットが空いている場合のみ書き込み位置を確保
+                if (tail_.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed)) {
+                    slot.value = value;
+                    slot.sequence.store(tail + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (sequence < tail + 1) {
+                return false;  // 消費者が1周前の要素を取り出していない
+            } else {
+                tail = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+    
+    /**
+     * 要素取り出し（消費者スレッド専用）
+     * @return 空の場合false
+     */
+    bool tryPop(T& value) {
+        return popBulk(&value, 1) == 1;
+    }
+    
+    /**
+     * 一括取り出し（消費者スレッド専用）
+     * 書き込み途中のスロットに達した時点で打ち切る
+     * @param out 出力先
+     * @param maxCount 最大取り出し数
+     * @return 取り出した要素数
+     */
+    size_t popBulk(T* out, size_t maxCount) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        size_t count = 0;
+        while (count < maxCount) {
+            Slot& slot = slots_[head & mask_];
+            if (slot.sequence.load(std::memory_order_acquire) != head + 1) {
+                break;
+            }
+            out[count++] = slot.value;
+            slot.sequence.store(head + mask_ + 1, std::memory_order_release);
+            ++head;
+        }
+        head_.store(head, std::memory_order_relaxed);
+        return count;
+    }
+    
+    /**
+     * 現在の要素数（概算、書き込み途中の要素を含む）
+     */
+    size_t size() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+    
+    /**
+     * 容量
+     */
+    size_t capacity() const {
+        return mask_ + 1;
+    }
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;   // tail と一致で書き込み可、tail + 1 で読み出し可
+        T value;
+    };
+    
+    static size_t roundUpToPowerOfTwo(size_t value) {
+        size_t result = 2;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+    
+    const size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+    
+    alignas(64) std::atomic<size_t> head_;  // 消費者が更新
+    alignas(64) std::atomic<size_t> tail_;  // 生産者が更新
+};
+
+} // namespace mser
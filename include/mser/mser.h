@@ -1,8 +1,18 @@
 #pragma once
 
 #include "types.h"
+#include "mser_workspace.h"
+#include "simd.h"
+#include "strided_view.h"
+#include <algorithm>
 #include <vector>
 #include <cstddef>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#ifdef MSER_ENABLE_METRICS
+#include <chrono>
+#endif
 
 namespace mser {
 
@@ -23,47 +33,248 @@ public:
      * デストラクター
      */
     ~MSER();
-
+    
     // ============================================================================
     // MSER計算機能
     // ============================================================================
     
     /**
      * MSER-1計算（オリジナルMSER）
+     * SUFFIX_SUM では MSERKernel<1> を使用
      * @param data 時系列データ
+     * @param algorithm 切り捨て点探索アルゴリズム
      * @return MSER計算結果
      */
-    MSERResult calculateMSER1(const TimeSeriesData& data);
+    MSERResult calculateMSER1(const TimeSeriesData& data,
+                              MSERAlgorithm algorithm = MSERAlgorithm::SUFFIX_SUM);
     
     /**
      * MSER-5計算（業界標準：バッチサイズ5）
+     * SUFFIX_SUM では MSERKernel<5> を使用
      * @param data 時系列データ
+     * @param algorithm 切り捨て点探索アルゴリズム
      * @return MSER計算結果
      */
-    MSERResult calculateMSER5(const TimeSeriesData& data);
+    MSERResult calculateMSER5(const TimeSeriesData& data,
+                              MSERAlgorithm algorithm = MSERAlgorithm::SUFFIX_SUM);
     
     /**
      * MSER-m計算（任意バッチサイズ）
+     * SUFFIX_SUM でバッチサイズ5・10の場合は MSERKernel を使用し、それ以外は汎用経路
      * @param data 時系列データ
      * @param batchSize バッチサイズ
+     * @param algorithm 切り捨て点探索アルゴリズム
      * @return MSER計算結果
      */
-    MSERResult calculateMSERm(const TimeSeriesData& data, size_t batchSize);
+    MSERResult calculateMSERm(const TimeSeriesData& data, size_t batchSize,
+                              MSERAlgorithm algorithm = MSERAlgorithm::SUFFIX_SUM);
     
     /**
      * 自動MSER計算（設定に基づく）
+     * SUFFIX_SUM は calculateParallel と同じ固定長チャンク単位の計算で、結果は threadCount によらず同一
      * @param data 時系列データ
      * @param config 設定
      * @return MSER計算結果
      */
     MSERResult calculate(const TimeSeriesData& data, const SteadyStateConfig& config);
+    
+    /**
+     * 並列MSER計算（大規模オフライン系列用）
+     * 
+     * 固定長チャンク単位でバッチ平均と部分和を並列計算し、チャンク部分和を
+     * 固定順序で結合した接尾和から各チャンクのargminを並列に求めて縮約する。
+     * チャンク分割はスレッド数に依存しないため、結果は threadCount=1 を含めスレッド数によらず同一で、
+     * SUFFIX_SUM の calculate とも一致する（calculate は config.threadCount をそのまま使用）
+     * @param data 時系列データ
+     * @param batchSize バッチサイズ（1はMSER-1）
+     * @param threadCount スレッド数（0はハードウェア並列数）
+     * @return MSER計算結果
+     */
+    MSERResult calculateParallel(const TimeSeriesData& data, size_t batchSize,
+                                 size_t threadCount = 0);
+    
+    /**
+     * 複数バッチサイズの一括MSER計算（感度分析用）
+     * 
+     * 生データを固定長チャンクごとに1回だけ走査してシフト済み累積和を作り、
+     * 全バッチサイズのバッチ平均をその累積和の差分から求める。
+     * calculateMSERm をバッチサイズごとに呼び出す場合と異なり生データの再走査がない。
+     * バッチ平均の加算順序が異なるため、MSER値は丸め誤差の範囲で個別計算と異なりうる
+     * @param data 時系列データ
+     * @param batchSizes バッチサイズ列（1はMSER-1）
+     * @return バッチサイズ列と同順のMSER計算結果
+     */
+    std::vector<MSERResult> calculateSweep(const TimeSeriesData& data,
+                                           const std::vector<size_t>& batchSizes);
+    
+    /**
+     * 時間重み付きMSER計算（不等間隔の観測）
+     * 
+     * 各値 yᵢ を次の観測までの保持時間 tᵢ₊₁ - tᵢ で重み付けし、時間重み付きバッチ平均と
+     * 重み・重み付き和・重み付き二乗和の累積和を1回の走査で求めて g(k) を最小化する
+     * （TimeWeightedMSER 参照）。格子への再標本化は不要。
+     * 最後の観測は保持時間が確定しないため含まない。等間隔の時刻では、最後の観測を除いた
+     * 系列に対する calculate と同じ切り捨て点になる
+     * @param values 観測値
+     * @param timestamps 観測時刻（values と同じ要素数、単調非減少）
+     * @param config 検出設定（variant・batchSize を使用）
+     * @return MSER計算結果（切り捨て点はバッチ単位で、開始時刻は timestamps[切り捨て点 × バッチサイズ]。
+     *         要素数の不一致・時刻の逆行・非有限値を含む場合は未収束）
+     */
+    MSERResult calculateTimeWeighted(const TimeSeriesData& values,
+                                     const TimeSeriesData& timestamps,
+                                     const SteadyStateConfig& config = SteadyStateConfig());
+    
+    /**
+     * 多変量MSER計算（各観測が d 次元の行）
+     * 
+     * 行ごとにバッチ平均を求め、次元ごとの接尾和・接尾二乗和を全次元まとめて
+     * SIMDで更新しながら、全次元共通の切り捨て点を結合基準の最小化で求める。
+     * 結合基準は単位の異なる次元をそのまま比較するため、必要に応じて次元ごとに標準化して渡す。
+     * d = 1 の場合は calculate と同じ切り捨て点になる（MSER値は丸め誤差の範囲で異なりうる）
+     * @param data 行優先の観測（要素数は dimensionCount の倍数、i 行 j 次元が data[i·d + j]）
+     * @param dimensionCount 次元数 d
+     * @param config 検出設定（variant・batchSize・preValidated を使用）
+     * @param criterion 結合基準
+     * @return 多変量MSER計算結果（次元数0・要素数が倍数でない・非有限値を含む場合は未収束）
+     */
+    MultivariateMSERResult calculateMultivariate(const TimeSeriesData& data, size_t dimensionCount,
+                                                 const SteadyStateConfig& config = SteadyStateConfig(),
+                                                 MultivariateCriterion criterion =
+                                                     MultivariateCriterion::TRACE);
+    
+    // ============================================================================
+    // 単精度入力（和・平方和は倍精度で累積）
+    // ============================================================================
+    
+    /**
+     * MSER-1計算（単精度入力）
+     */
+    MSERResult calculateMSER1(const TimeSeriesDataF32& data,
+                              MSERAlgorithm algorithm = MSERAlgorithm::SUFFIX_SUM);
+    
+    /**
+     * MSER-5計算（単精度入力）
+     */
+    MSERResult calculateMSER5(const TimeSeriesDataF32& data,
+                              MSERAlgorithm algorithm = MSERAlgorithm::SUFFIX_SUM);
+    
+    /**
+     * MSER-m計算（単精度入力）
+     */
+    MSERResult calculateMSERm(const TimeSeriesDataF32& data, size_t batchSize,
+                              MSERAlgorithm algorithm = MSERAlgorithm::SUFFIX_SUM);
+    
+    /**
+     * 自動MSER計算（単精度入力）
+     */
+    MSERResult calculate(const TimeSeriesDataF32& data, const SteadyStateConfig& config);
+    
+    // ============================================================================
+    // 作業領域付き計算（一時バッファを呼び出し側の MSERWorkspace で使い回す）
+    // ============================================================================
+    
+    /**
+     * MSER-m計算（作業領域付き）
+     * 作業領域の容量がバッチ数以上であればヒープ確保を行わない
+     * @param data 時系列データ
+     * @param batchSize バッチサイズ
+     * @param workspace 作業領域
+     * @param algorithm 切り捨て点探索アルゴリズム
+     * @return MSER計算結果
+     */
+    MSERResult calculateMSERm(const TimeSeriesData& data, size_t batchSize,
+                              MSERWorkspace& workspace,
+                              MSERAlgorithm algorithm = MSERAlgorithm::SUFFIX_SUM);
+    
+    /**
+     * 自動MSER計算（作業領域付き）
+     * チャンクの部分結果も作業領域に保持する（threadCount != 1 はスレッド生成の確保を伴う）
+     */
+    MSERResult calculate(const TimeSeriesData& data, const SteadyStateConfig& config,
+                         MSERWorkspace& workspace);
+    
+    /**
+     * 自動MSER計算（単精度入力、作業領域付き）
+     */
+    MSERResult calculate(const TimeSeriesDataF32& data, const SteadyStateConfig& config,
+                         MSERWorkspace& workspace);
+    
+    /**
+     * MSER-m計算（ビュー入力、作業領域付き）
+     */
+    template <typename T>
+    MSERResult calculateMSERm(StridedView<T> data, size_t batchSize, MSERWorkspace& workspace,
+                              MSERAlgorithm algorithm = MSERAlgorithm::SUFFIX_SUM);
+    
+    /**
+     * 自動MSER計算（ビュー入力、作業領域付き）
+     */
+    template <typename T>
+    MSERResult calculate(StridedView<T> data, const SteadyStateConfig& config,
+                         MSERWorkspace& workspace);
+    
+    // ============================================================================
+    // メトリクス機能
+    // ============================================================================
+
+#ifdef MSER_ENABLE_METRICS
+    /**
+     * 計算メトリクス取得（calculate の呼び出しを入力形式によらず集計、MSER_ENABLE_METRICS 時のみ）
+     */
+    MSERMetrics getMetrics() const;
+    
+    /**
+     * 計算メトリクスのリセット
+     */
+    void resetMetrics();
+#endif
 
+    // ============================================================================
+    // ストライド付きビュー入力（コピーなし）
+    // ============================================================================
+    
+    /**
+     * MSER-1計算（ビュー入力）
+     * float・整数型の要素は AccumulatorType<T> で累積する
+     * @param data 時系列データのビュー
+     * @param algorithm 切り捨て点探索アルゴリズム
+     * @return MSER計算結果
+     */
+    template <typename T>
+    MSERResult calculateMSER1(StridedView<T> data,
+                              MSERAlgorithm algorithm = MSERAlgorithm::SUFFIX_SUM);
+    
+    /**
+     * MSER-5計算（ビュー入力）
+     */
+    template <typename T>
+    MSERResult calculateMSER5(StridedView<T> data,
+                              MSERAlgorithm algorithm = MSERAlgorithm::SUFFIX_SUM);
+    
+    /**
+     * MSER-m計算（ビュー入力）
+     * @param data 時系列データのビュー
+     * @param batchSize バッチサイズ
+     * @param algorithm 切り捨て点探索アルゴリズム
+     * @return MSER計算結果
+     */
+    template <typename T>
+    MSERResult calculateMSERm(StridedView<T> data, size_t batchSize,
+                              MSERAlgorithm algorithm = MSERAlgorithm::SUFFIX_SUM);
+    
+    /**
+     * 自動MSER計算（ビュー入力）
+     */
+    template <typename T>
+    MSERResult calculate(StridedView<T> data, const SteadyStateConfig& config);
+    
     // ============================================================================
     // 統計計算機能
     // ============================================================================
     
     /**
-     * 基本統計量計算
+     * 基本統計量計算（RunningStatistics による1パス計算）
      * @param data データ
      * @param startIndex 開始インデックス
      * @param endIndex 終了インデックス（排他的）
@@ -74,14 +285,47 @@ public:
                                  size_t endIndex);
     
     /**
-     * バッチ統計計算
+     * バッチ統計計算（バッチ平均系列とその統計量）
      * @param data 元データ
      * @param batchSize バッチサイズ
      * @return バッチ統計
      */
     BatchStatistics calculateBatchStatistics(const TimeSeriesData& data, 
                                             size_t batchSize);
-
+    
+    /**
+     * バッチ統計計算（出力先の batchMeans の容量を再利用）
+     * @param data 元データ
+     * @param batchSize バッチサイズ
+     * @param batchStats 出力先
+     */
+    void calculateBatchStatistics(const TimeSeriesData& data, size_t batchSize,
+                                  BatchStatistics& batchStats);
+    
+    /**
+     * 基本統計量計算（ビュー入力）
+     */
+    template <typename T>
+    Statistics calculateStatistics(StridedView<T> data, size_t startIndex, size_t endIndex);
+    
+    /**
+     * バッチ統計計算（ビュー入力）
+     */
+    template <typename T>
+    BatchStatistics calculateBatchStatistics(StridedView<T> data, size_t batchSize);
+    
+    /**
+     * 連続する区間のバッチ統計の併合（生データの再走査なし）
+     * 
+     * next は batchStats の直後の区間から同じバッチサイズで計算したものとし、
+     * バッチ平均系列を連結して統計量を併合する。バッチの境界を揃えるため、
+     * batchStats の元データのサンプル数がバッチサイズの倍数である必要がある
+     * @param batchStats 併合先（空の場合は next をそのまま複製）
+     * @param next 後続区間のバッチ統計
+     * @return 併合した場合true（バッチサイズの不一致・境界のずれは false で併合先は変更しない）
+     */
+    bool mergeBatchStatistics(BatchStatistics& batchStats, const BatchStatistics& next);
+    
     // ============================================================================
     // ヘルパー機能
     // ============================================================================
@@ -89,16 +333,88 @@ public:
     /**
      * 最適な切り捨て点の検索
      * @param data データ
-     * @param maxTruncation 最大切り捨て点
+     * @param algorithm 探索アルゴリズム
      * @return 切り捨て点とMSER値のペア
      */
-    std::pair<size_t, double> findOptimalTruncationPoint(const TimeSeriesData& data);
+    std::pair<size_t, double> findOptimalTruncationPoint(
+        const TimeSeriesData& data,
+        MSERAlgorithm algorithm = MSERAlgorithm::SUFFIX_SUM);
 
 private:
+    // ============================================================================
+    // 内部状態
+    // ============================================================================
+
+#ifdef MSER_ENABLE_METRICS
+    MSERMetrics metrics_;   // 計算メトリクス
+#endif
+    bool sequential_;       // 逐次経路のみ使用（検出器の収束チェック用）
+    
+    friend class SteadyStateDetector;  // 収束チェックの計算器を逐次経路に設定する
+    
     // ============================================================================
     // 内部計算機能
     // ============================================================================
     
+    /**
+     * MSER-1計算の本体
+     * @param preValidated 有限性の検証を省略する
+     */
+    MSERResult calculateMSER1Impl(const TimeSeriesData& data, MSERAlgorithm algorithm,
+                                  bool preValidated);
+    
+    /**
+     * MSER-m計算の本体
+     * @param preValidated 有限性の検証を省略する
+     */
+    MSERResult calculateMSERmImpl(const TimeSeriesData& data, size_t batchSize,
+                                  MSERWorkspace& workspace, MSERAlgorithm algorithm,
+                                  bool preValidated);
+    
+    /**
+     * MSER-1計算の本体（ビュー入力）
+     */
+    template <typename T>
+    MSERResult calculateMSER1Impl(StridedView<T> data, MSERAlgorithm algorithm,
+                                  bool preValidated);
+    
+    /**
+     * MSER-m計算の本体（ビュー入力）
+     */
+    template <typename T>
+    MSERResult calculateMSERmImpl(StridedView<T> data, size_t batchSize,
+                                  MSERWorkspace& workspace, MSERAlgorithm algorithm,
+                                  bool preValidated);
+    
+    /**
+     * 固定長チャンク単位のMSER計算（calculate の SUFFIX_SUM・calculateParallel の本体）
+     * @param preValidated 有限性の検証を省略する
+     */
+    MSERResult calculateChunked(const TimeSeriesData& data, size_t batchSize, size_t threadCount,
+                                bool preValidated, MSERWorkspace& workspace);
+    
+    /**
+     * 変種に応じたMSER計算（calculate の本体）
+     */
+    MSERResult calculateVariant(const TimeSeriesData& data, const SteadyStateConfig& config,
+                                MSERWorkspace& workspace);
+    
+    /**
+     * 変種に応じたMSER計算（ビュー入力の calculate の本体）
+     */
+    template <typename T>
+    MSERResult calculateVariant(StridedView<T> data, const SteadyStateConfig& config,
+                                MSERWorkspace& workspace);
+
+#ifdef MSER_ENABLE_METRICS
+    /**
+     * calculate 呼び出しの記録
+     * @param sampleCount 入力サンプル数
+     * @param start 計算開始時刻
+     */
+    void recordCalculate(size_t sampleCount, std::chrono::steady_clock::time_point start);
+#endif
+
     /**
      * MSER値計算（White 1997の式）
      * gn(k) = Sn,k²/(n-k)² = 1/(n-k)² ∑j=k^(n-1) (Yj - Ȳn,k)²
@@ -106,12 +422,44 @@ private:
     double calculateMSERValue(const TimeSeriesData& data, 
                             size_t truncationPoint);
     
+    /**
+     * 直接法による切り捨て点探索（kごとにcalculateMSERValueを呼ぶ、O(n²)）
+     */
+    std::pair<size_t, double> findOptimalTruncationPointDirect(const TimeSeriesData& data);
+    
+    /**
+     * 累積和による切り捨て点探索（O(n)）
+     * 
+     * 全体平均cでシフトした接尾和 S_k=∑j≥k(Yj-c), Q_k=∑j≥k(Yj-c)² を
+     * 後方から1回の走査で累積し、各kで Sn,k² = Q_k - S_k²/(n-k) を得る。
+     * シフトにより桁落ちを抑え、直接法と同じargminを与える
+     */
+    std::pair<size_t, double> findOptimalTruncationPointSuffixSum(const TimeSeriesData& data);
+    
+    /**
+     * 固定長チャンク単位の接尾和による切り捨て点探索
+     * @param series 探索対象の系列
+     * @param count 系列長
+     * @param partials チャンクごとの部分結果（系列和を設定済み、固定順序で結合する）
+     * @param threadCount スレッド数
+     */
+    std::pair<size_t, double> findOptimalTruncationPointChunked(const double* series,
+                                                                size_t count,
+                                                                std::vector<ChunkPartial>& partials,
+                                                                size_t threadCount);
+    
     /**
      * バッチ平均系列の生成
      */
     TimeSeriesData createBatchMeans(const TimeSeriesData& data, 
                                   size_t batchSize);
     
+    /**
+     * バッチ平均系列の生成（出力先の容量を再利用）
+     */
+    void createBatchMeans(const TimeSeriesData& data, size_t batchSize,
+                          TimeSeriesData& batchMeans);
+    
     /**
      * サンプル平均計算
      */
@@ -121,9 +469,349 @@ private:
     
     /**
      * データ検証
+     * @param preValidated true の場合はサンプル数のみ検証（NaN/Inf走査を省略）
      */
     bool validateData(const TimeSeriesData& data, 
-                     size_t minRequiredSize = 10);
+                     size_t minRequiredSize = 10,
+                     bool preValidated = false);
 };
 
+// ============================================================================
+// ストライド付きビュー入力の実装
+// ============================================================================
+
+namespace detail {
+
+template <typename T>
+bool isFiniteValue(T value) {
+    if constexpr (std::is_floating_point<T>::value) {
+        return std::isfinite(value);
+    } else {
+        return true;
+    }
+}
+
+/**
+ * 連続配置の double 列か（SIMDカーネルを直接適用可能か）
+ */
+template <typename T>
+bool isContiguousDouble(StridedView<T> data) {
+    return std::is_same<T, double>::value && data.isContiguous();
+}
+
+template <typename T>
+bool validateView(StridedView<T> data, size_t minRequiredSize, bool preValidated = false) {
+    if (data.size() < minRequiredSize) {
+        return false;
+    }
+    if (preValidated) {
+        return true;
+    }
+    
+    // NaN や Inf のチェック
+    for (size_t i = 0; i < data.size(); ++i) {
+        if (!isFiniteValue(data[i])) {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+template <typename T>
+double meanView(StridedView<T> data, size_t startIndex, size_t endIndex) {
+    if (startIndex >= endIndex || endIndex > data.size()) {
+        return 0.0;
+    }
+    
+    if constexpr (std::is_same<T, double>::value) {
+        if (data.isContiguous()) {
+            return simd::sum(data.data() + startIndex, endIndex - startIndex) /
+                   (endIndex - startIndex);
+        }
+    }
+    
+    AccumulatorType<T> sum = 0;
+    for (size_t i = startIndex; i < endIndex; ++i) {
+        sum += static_cast<AccumulatorType<T>>(data[i]);
+    }
+    
+    return static_cast<double>(sum / static_cast<AccumulatorType<T>>(endIndex - startIndex));
+}
+
+template <typename T>
+double sumSquaredDeviationsView(StridedView<T> data, size_t startIndex, size_t endIndex,
+                                double mean) {
+    if constexpr (std::is_same<T, double>::value) {
+        if (data.isContiguous()) {
+            return simd::sumSquaredDeviations(data.data() + startIndex,
+                                              endIndex - startIndex, mean);
+        }
+    }
+    
+    AccumulatorType<T> sumSquaredDeviations = 0;
+    for (size_t i = startIndex; i < endIndex; ++i) {
+        AccumulatorType<T> deviation = static_cast<AccumulatorType<T>>(data[i]) - mean;
+        sumSquaredDeviations += deviation * deviation;
+    }
+    
+    return static_cast<double>(sumSquaredDeviations);
+}
+
+template <typename T>
+void batchMeansView(StridedView<T> data, size_t batchSize, TimeSeriesData& batchMeans) {
+    if (batchSize == 0) {
+        batchMeans.clear();
+        return;
+    }
+    
+    size_t numFullBatches = data.size() / batchSize;
+    batchMeans.resize(numFullBatches);
+    
+    if constexpr (std::is_same<T, double>::value) {
+        if (data.isContiguous()) {
+            simd::batchMeans(data.data(), numFullBatches, batchSize, batchMeans.data());
+            return;
+        }
+    }
+    
+    for (size_t i = 0; i < numFullBatches; ++i) {
+        AccumulatorType<T> batchSum = 0;
+        size_t startIdx = i * batchSize;
+        for (size_t j = startIdx; j < startIdx + batchSize; ++j) {
+            batchSum += static_cast<AccumulatorType<T>>(data[j]);
+        }
+        batchMeans[i] = static_cast<double>(batchSum / static_cast<AccumulatorType<T>>(batchSize));
+    }
+}
+
+template <typename T>
+TimeSeriesData batchMeansView(StridedView<T> data, size_t batchSize) {
+    TimeSeriesData batchMeans;
+    batchMeansView(data, batchSize, batchMeans);
+    return batchMeans;
+}
+
+template <typename T>
+std::pair<size_t, double> findOptimalTruncationPointView(StridedView<T> data,
+                                                         MSERAlgorithm algorithm) {
+    size_t n = data.size();
+    size_t maxK = n / 2;  // White (1997): k ≤ ⌊n/2⌋-1
+    
+    if (maxK < 2) {
+        return {0, std::numeric_limits<double>::infinity()};
+    }
+    
+    double minMSER = std::numeric_limits<double>::infinity();
+    size_t optimalK = 0;
+    
+    if (algorithm == MSERAlgorithm::DIRECT) {
+        for (size_t k = 0; k < maxK; ++k) {
+            double mean = meanView(data, k, n);
+            double effectiveN = static_cast<double>(n - k);
+            double mser = sumSquaredDeviationsView(data, k, n, mean) / (effectiveN * effectiveN);
+            
+            if (mser < minMSER) {
+                minMSER = mser;
+                optimalK = k;
+            }
+        }
+        return {optimalK, minMSER};
+    }
+    
+    // 全体平均でシフトして平方和の桁落ちを防ぐ
+    double shift = meanView(data, 0, n);
+    
+    if constexpr (std::is_same<T, double>::value) {
+        if (data.isContiguous()) {
+            return simd::scanSuffix(data.data(), n, maxK, shift);
+        }
+    }
+    
+    using Acc = AccumulatorType<T>;
+    Acc suffixSum = 0;
+    Acc suffixSumSq = 0;
+    
+    // 後方走査: kが小さい方を優先するため等号でも更新する
+    for (size_t j = n; j-- > 0; ) {
+        Acc y = static_cast<Acc>(data[j]) - shift;
+        suffixSum += y;
+        suffixSumSq += y * y;
+        
+        if (j >= maxK) {
+            continue;
+        }
+        
+        Acc effectiveN = static_cast<Acc>(n - j);
+        Acc sumSquaredDeviations = suffixSumSq - suffixSum * suffixSum / effectiveN;
+        if (sumSquaredDeviations < 0) {
+            sumSquaredDeviations = 0;  // 丸め誤差による負値を除去
+        }
+        
+        double mser = static_cast<double>(sumSquaredDeviations / (effectiveN * effectiveN));
+        if (mser <= minMSER) {
+            minMSER = mser;
+            optimalK = j;
+        }
+    }
+    
+    return {optimalK, minMSER};
+}
+
+} // namespace detail
+
+template <typename T>
+MSERResult MSER::calculateMSER1(StridedView<T> data, MSERAlgorithm algorithm) {
+    return calculateMSER1Impl(data, algorithm, false);
+}
+
+template <typename T>
+MSERResult MSER::calculateMSER1Impl(StridedView<T> data, MSERAlgorithm algorithm,
+                                    bool preValidated) {
+    MSERResult result;
+    result.variant = MSERVariant::MSER_1;
+    result.totalSamples = data.size();
+    result.effectiveBatchSize = 1;
+    
+    if (!detail::validateView(data, 10, preValidated)) {
+        result.converged = false;
+        return result;
+    }
+    
+    auto [truncPoint, mserVal] = detail::findOptimalTruncationPointView(data, algorithm);
+    
+    result.truncationPoint = truncPoint;
+    result.mserValue = mserVal;
+    result.converged = (mserVal < std::numeric_limits<double>::infinity());
+    
+    return result;
+}
+
+template <typename T>
+MSERResult MSER::calculateMSER5(StridedView<T> data, MSERAlgorithm algorithm) {
+    return calculateMSERm(data, 5, algorithm);  // 業界標準のバッチサイズ5
+}
+
+template <typename T>
+MSERResult MSER::calculateMSERm(StridedView<T> data, size_t batchSize,
+                                MSERAlgorithm algorithm) {
+    MSERWorkspace workspace;
+    return calculateMSERm(data, batchSize, workspace, algorithm);
+}
+
+template <typename T>
+MSERResult MSER::calculateMSERm(StridedView<T> data, size_t batchSize,
+                                MSERWorkspace& workspace, MSERAlgorithm algorithm) {
+    return calculateMSERmImpl(data, batchSize, workspace, algorithm, false);
+}
+
+template <typename T>
+MSERResult MSER::calculateMSERmImpl(StridedView<T> data, size_t batchSize,
+                                    MSERWorkspace& workspace, MSERAlgorithm algorithm,
+                                    bool preValidated) {
+    MSERResult result;
+    result.variant = (batchSize == 5) ? MSERVariant::MSER_5 : MSERVariant::MSER_M;
+    result.totalSamples = data.size();
+    result.effectiveBatchSize = batchSize;
+    
+    // バッチ処理には最低限のサンプル数が必要
+    if (!detail::validateView(data, batchSize * 2, preValidated)) {
+        result.converged = false;
+        return result;
+    }
+    
+    // バッチ平均系列の作成（入力のコピーは行わない）
+    TimeSeriesData& batchMeans = workspace.batchMeans();
+    detail::batchMeansView(data, batchSize, batchMeans);
+    result.batchCount = batchMeans.size();
+    
+    if (batchMeans.size() < 10) {  // 最低限のバッチ数
+        result.converged = false;
+        return result;
+    }
+    
+    auto [truncPoint, mserVal] = findOptimalTruncationPoint(batchMeans, algorithm);
+    
+    result.truncationPoint = truncPoint;
+    result.mserValue = mserVal;
+    result.converged = (mserVal < std::numeric_limits<double>::infinity());
+    
+    return result;
+}
+
+template <typename T>
+MSERResult MSER::calculate(StridedView<T> data, const SteadyStateConfig& config) {
+    MSERWorkspace workspace;
+    return calculate(data, config, workspace);
+}
+
+template <typename T>
+MSERResult MSER::calculate(StridedView<T> data, const SteadyStateConfig& config,
+                           MSERWorkspace& workspace) {
+#ifdef MSER_ENABLE_METRICS
+    auto start = std::chrono::steady_clock::now();
+    MSERResult result = calculateVariant(data, config, workspace);
+    recordCalculate(data.size(), start);
+    return result;
+#else
+    return calculateVariant(data, config, workspace);
+#endif
+}
+
+template <typename T>
+MSERResult MSER::calculateVariant(StridedView<T> data, const SteadyStateConfig& config,
+                                  MSERWorkspace& workspace) {
+    switch (config.variant) {
+        case MSERVariant::MSER_1:
+            return calculateMSER1Impl(data, config.algorithm, config.preValidated);
+        case MSERVariant::MSER_M:
+            return calculateMSERmImpl(data, config.batchSize, workspace, config.algorithm,
+                                      config.preValidated);
+        case MSERVariant::MSER_5:
+        default:
+            // 業界標準のバッチサイズ5
+            return calculateMSERmImpl(data, 5, workspace, config.algorithm, config.preValidated);
+    }
+}
+
+template <typename T>
+Statistics MSER::calculateStatistics(StridedView<T> data, size_t startIndex, size_t endIndex) {
+    Statistics stats;
+    
+    if (startIndex >= endIndex || endIndex > data.size()) {
+        return stats;  // 無効な範囲の場合はゼロ統計を返す
+    }
+    
+    // 連続配置は直接、それ以外はブロック単位で倍精度に詰め替えて1パスで集計
+    RunningStatistics running;
+    if constexpr (std::is_same<T, double>::value || std::is_same<T, float>::value) {
+        if (data.isContiguous()) {
+            running.add(data.data() + startIndex, endIndex - startIndex);
+            return Statistics(running);
+        }
+    }
+    
+    double block[RunningStatistics::kBlockSize];
+    for (size_t offset = startIndex; offset < endIndex; offset += RunningStatistics::kBlockSize) {
+        size_t blockCount = std::min(RunningStatistics::kBlockSize, endIndex - offset);
+        for (size_t i = 0; i < blockCount; ++i) {
+            block[i] = static_cast<double>(data[offset + i]);
+        }
+        running.add(block, blockCount);
+    }
+    
+    return Statistics(running);
+}
+
+template <typename T>
+BatchStatistics MSER::calculateBatchStatistics(StridedView<T> data, size_t batchSize) {
+    BatchStatistics batchStats;
+    batchStats.originalSampleCount = data.size();
+    batchStats.batchSize = batchSize;
+    batchStats.batchMeans = detail::batchMeansView(data, batchSize);
+    batchStats.meanStatistics.add(batchStats.batchMeans.data(), batchStats.batchMeans.size());
+    
+    return batchStats;
+}
+
 } // namespace mser
\ No newline at end of file
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "simd.h"
+#include "types.h"
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+namespace mser {
+
+/**
+ * バッチサイズ固定のMSERカーネル
+ *
+ * バッチサイズと変種をコンパイル時定数とし、バッチ平均は汎用経路と同じ simd::batchMeans で求める。
+ * 汎用経路（MSER::calculateMSERm）と異なり、NaN/Infの事前検証を別走査で行わず
+ * バッチ平均の総和の有限性で判定するため、生データの走査は1回で済む。
+ * 加算順序は汎用経路と同一で、結果はビット単位で一致する
+ *
+ * 1, 5, 10 は事前にインスタンス化済み（extern template）
+ */
+template <size_t BatchSize>
+class MSERKernel {
+public:
+    static_assert(BatchSize >= 1, "MSERKernel requires a positive batch size");
+    
+    static constexpr size_t kBatchSize = BatchSize;
+    static constexpr MSERVariant kVariant = (BatchSize == 1) ? MSERVariant::MSER_1
+                                          : (BatchSize == 5) ? MSERVariant::MSER_5
+                                                             : MSERVariant::MSER_M;
+    
+    /**
+     * MSER計算（累積和アルゴリズム）
+     * @param data 時系列データ
+     * @param count データ数
+     * @return MSER計算結果
+     */
+    static MSERResult calculate(const double* data, size_t count);
+    
+    /**
+     * MSER計算（バッチ平均バッファを呼び出し側から受け取る）
+     * @param data 時系列データ
+     * @param count データ数
+     * @param scratch バッチ平均用バッファ（容量内ならヒープ確保なし）
+     * @return MSER計算結果
+     */
+    static MSERResult calculate(const double* data, size_t count, TimeSeriesData& scratch);
+    
+    /**
+     * MSER計算（累積和アルゴリズム）
+     */
+    static MSERResult calculate(const TimeSeriesData& data) {
+        return calculate(data.data(), data.size());
+    }
+
+private:
+    /**
+     * 全要素の有限性検証（高速判定が不成立の場合のみ使用）
+     */
+    static bool allFinite(const double* data, size_t count);
+};
+
+// ============================================================================
+// テンプレート実装
+// ============================================================================
+
+template <size_t BatchSize>
+MSERResult MSERKernel<BatchSize>::calculate(const double* data, size_t count) {
+    TimeSeriesData scratch;
+    return calculate(data, count, scratch);
+}
+
+template <size_t BatchSize>
+MSERResult MSERKernel<BatchSize>::calculate(const double* data, size_t count,
+                                            TimeSeriesData& scratch) {
+    MSERResult result;
+    result.variant = kVariant;
+    result.totalSamples = count;
+    result.effectiveBatchSize = BatchSize;
+    
+    constexpr size_t minRequired = (BatchSize == 1) ? 10 : BatchSize * 2;
+    if (count < minRequired) {
+        result.converged = false;
+        return result;
+    }
+    
+    size_t batchCount = count / BatchSize;
+    const double* series = data;
+    if (BatchSize > 1) {
+        scratch.resize(batchCount);
+        simd::batchMeans(data, batchCount, BatchSize, scratch.data());
+        series = scratch.data();
+    }
+    
+    // 系列和が有限なら全要素が有限（非有限の場合のみ生データを再検証）
+    double sum = simd::sum(series, batchCount);
+    bool valid = std::isfinite(sum) || allFinite(data, batchCount * BatchSize);
+    if (valid && BatchSize > 1) {
+        size_t tail = batchCount * BatchSize;
+        valid = allFinite(data + tail, count - tail);  // 不完全バッチの端数
+    }
+    if (!valid) {
+        result.converged = false;
+        return result;
+    }
+    
+    if (BatchSize > 1) {
+        result.batchCount = batchCount;
+        if (batchCount < 10) {  // 最低限のバッチ数
+            result.converged = false;
+            return result;
+        }
+    }
+    
+    size_t maxK = batchCount / 2;  // White (1997): k ≤ ⌊n/2⌋-1
+    if (maxK < 2) {
+        result.mserValue = std::numeric_limits<double>::infinity();
+        result.converged = false;
+        return result;
+    }
+    
+    double shift = sum / batchCount;  // 全体平均でシフトして桁落ちを防ぐ
+    auto [truncPoint, mserVal] = simd::scanSuffix(series, batchCount, maxK, shift);
+    
+    result.truncationPoint = truncPoint;
+    result.mserValue = mserVal;
+    result.converged = (mserVal < std::numeric_limits<double>::infinity());
+    
+    return result;
+}
+
+template <size_t BatchSize>
+bool MSERKernel<BatchSize>::allFinite(const double* data, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        if (!std::isfinite(data[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+extern template class MSERKernel<1>;
+extern template class MSERKernel<5>;
+extern template class MSERKernel<10>;
+
+} // namespace mser
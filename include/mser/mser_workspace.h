@@ -0,0 +1,72 @@
+#pragma once
+
+#include "types.h"
+#include <cstddef>
+#include <vector>
+
+namespace mser {
+
+/**
+ * 固定長チャンクの部分結果（チャンク単位のMSER計算用）
+ */
+struct ChunkPartial {
+    double sum = 0.0;           // チャンクの系列和（非有限値を含む場合は NaN）
+    double suffixSum = 0.0;     // 後続チャンクのシフト済み和 ∑(x-c)
+    double suffixSumSq = 0.0;   // 後続チャンクのシフト済み二乗和 ∑(x-c)²
+    size_t optimalK = 0;        // チャンク内の切り捨て点
+    double minMSER = 0.0;       // チャンク内の最小MSER値
+};
+
+/**
+ * MSER計算の作業領域
+ *
+ * バッチ平均系列・チャンクの部分結果などの一時バッファを呼び出し側が所有し、計算間で使い回す。
+ * バッファは縮小せず容量を保持するため、予約済み容量の範囲内では
+ * 以後の計算でヒープ確保が発生しない。スレッド間で共有しないこと
+ */
+class MSERWorkspace {
+public:
+    static constexpr size_t kChunkSize = 1 << 16;  // チャンク長（系列要素数、スレッド数に依存しない）
+    
+    /**
+     * コンストラクター
+     */
+    MSERWorkspace();
+    
+    /**
+     * コンストラクター（容量予約付き）
+     * @param batchCount 想定最大バッチ数
+     */
+    explicit MSERWorkspace(size_t batchCount);
+    
+    /**
+     * デストラクター
+     */
+    ~MSERWorkspace();
+    
+    /**
+     * 想定最大バッチ数分のメモリ予約
+     */
+    void reserve(size_t batchCount);
+    
+    /**
+     * バッチ平均用バッファ取得（内容は不定、容量は保持）
+     */
+    TimeSeriesData& batchMeans();
+    
+    /**
+     * チャンクの部分結果用バッファ取得（内容は不定、容量は保持）
+     */
+    std::vector<ChunkPartial>& chunkPartials();
+    
+    /**
+     * 確保済みメモリ量取得
+     */
+    size_t getBytesHeld() const;
+
+private:
+    TimeSeriesData batchMeans_;                 // バッチ平均系列
+    std::vector<ChunkPartial> chunkPartials_;   // チャンクの部分結果
+};
+
+} // namespace mser
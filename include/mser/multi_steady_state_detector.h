@@ -0,0 +1,168 @@
+#pragma once
+
+#include "types.h"
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace mser {
+
+/**
+ * 多メトリック定常状態検出器
+ *
+ * 1ステップ分の全メトリック値（1行）をまとめて取り込み、メトリックごとの
+ * バッチ平均を列優先（メトリックごとに連続）の構造体配列で保持する。
+ * 収束チェックは未収束の各メトリック列を最終バッチ平均でシフトした後方累積で評価する
+ */
+class MultiSteadyStateDetector {
+public:
+    /**
+     * コンストラクター
+     * @param metricCount メトリック数
+     * @param config 検出設定（全メトリック共通）
+     */
+    explicit MultiSteadyStateDetector(size_t metricCount,
+                                      const SteadyStateConfig& config = SteadyStateConfig());
+    
+    /**
+     * デストラクター
+     */
+    ~MultiSteadyStateDetector();
+    
+    // ============================================================================
+    // リアルタイム検出機能
+    // ============================================================================
+    
+    /**
+     * 1ステップ分のデータ追加
+     * @param values メトリック数分の値（メトリック順）
+     * @return 全メトリックが定常状態に達した場合true
+     */
+    bool addRow(const TimeSeriesValue* values);
+    
+    /**
+     * 1ステップ分のデータ追加
+     * @param values メトリック数分の値（要素数がメトリック数と異なる場合は無視）
+     * @return 全メトリックが定常状態に達した場合true
+     */
+    bool addRow(const std::vector<TimeSeriesValue>& values);
+    
+    /**
+     * 強制検査実行（未収束の全メトリックを評価）
+     * @return 全メトリックが収束している場合true
+     */
+    bool checkConvergence();
+    
+    /**
+     * 検出器リセット
+     */
+    void reset();
+    
+    // ============================================================================
+    // 状態取得機能
+    // ============================================================================
+    
+    /**
+     * メトリック数取得
+     */
+    size_t getMetricCount() const;
+    
+    /**
+     * 現在のステップ数（行数）取得
+     */
+    size_t getCurrentSampleCount() const;
+    
+    /**
+     * 指定メトリックの最新MSER結果取得
+     */
+    const MSERResult& getLastResult(size_t metric) const;
+    
+    /**
+     * 全メトリックの最新MSER結果取得
+     */
+    const std::vector<MSERResult>& getLastResults() const;
+    
+    /**
+     * 指定メトリックの収束状態取得
+     */
+    bool hasConverged(size_t metric) const;
+    
+    /**
+     * 全メトリックの収束状態取得
+     */
+    bool allConverged() const;
+    
+    /**
+     * 収束済みメトリック数取得
+     */
+    size_t getConvergedCount() const;
+    
+    /**
+     * 最大サンプル数到達判定
+     */
+    bool hasReachedMaxSamples() const;
+    
+    /**
+     * 指定メトリックのバッチ平均系列取得（コピー）
+     */
+    TimeSeriesData getBatchMeans(size_t metric) const;
+    
+    // ============================================================================
+    // 設定機能
+    // ============================================================================
+    
+    /**
+     * コールバック設定（メトリックごとの収束検出時に呼び出される）
+     */
+    void setConvergenceCallback(std::function<void(size_t, const MSERResult&)> callback);
+
+private:
+    // ============================================================================
+    // 内部状態
+    // ============================================================================
+    
+    SteadyStateConfig config_;              // 検出設定
+    size_t metricCount_;                    // メトリック数
+    size_t batchSize_;                      // 有効バッチサイズ
+    size_t batchCapacity_;                  // メトリックあたりの最大バッチ数
+    size_t rowCount_;                       // 取り込み済みステップ数
+    size_t batchFill_;                      // 現在の部分バッチのステップ数
+    size_t batchCount_;                     // 完了バッチ数（全メトリック共通）
+    size_t lastCheckIndex_;                 // 最後のチェック位置
+    size_t convergedCount_;                 // 収束済みメトリック数
+    bool maxSamplesReached_;                // 最大サンプル数到達フラグ
+    
+    TimeSeriesData batchSums_;              // [metric] 部分バッチ和
+    TimeSeriesData batchMeans_;             // [metric][batch] 完了バッチ平均
+    std::vector<size_t> nonFiniteCounts_;   // [metric] NaN/Inf の数
+    std::vector<std::uint8_t> converged_;   // [metric] 収束フラグ
+    std::vector<MSERResult> results_;       // [metric] 最新結果
+    
+    std::function<void(size_t, const MSERResult&)> convergenceCallback_;  // コールバック
+    
+    // ============================================================================
+    // 内部機能
+    // ============================================================================
+    
+    /**
+     * 検査タイミング判定
+     */
+    bool shouldPerformCheck() const;
+    
+    /**
+     * 完了バッチの全メトリックへの登録
+     */
+    void completeBatch();
+    
+    /**
+     * 単一メトリックのMSER評価
+     */
+    MSERResult evaluateMetric(size_t metric) const;
+    
+    /**
+     * メトリック列の先頭位置（バッチ平均配列内）
+     */
+    size_t columnOffset(size_t metric) const;
+};
+
+} // namespace mser
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstddef>
+
+namespace mser {
+
+class CheckpointReader;
+class CheckpointWriter;
+
+/**
+ * 併合可能な一次・二次統計量（サンプル数・平均・平方偏差和 M2）
+ *
+ * 1点ずつの追加は Welford の更新、部分結果どうしの併合は Chan らの公式
+ *   n = nₐ + n_b, δ = x̄_b - x̄ₐ, x̄ = x̄ₐ + δ·n_b/n, M2 = M2ₐ + M2_b + δ²·nₐ·n_b/n
+ * で行い、和・二乗和の差による桁落ちを避ける。
+ * スレッドごと・プロセスごとの部分結果を、生データを再走査せずに1つに集約できる
+ * （プロセス間はチェックポイント形式で受け渡す）
+ */
+class RunningStatistics {
+public:
+    /**
+     * 配列一括追加のブロック長（ブロック内は L1 上で2パス、主記憶の走査は1回）
+     */
+    static constexpr size_t kBlockSize = 512;
+    
+    /**
+     * コンストラクター（空の統計量）
+     */
+    RunningStatistics();
+    
+    /**
+     * 部分結果からの構築
+     * @param count サンプル数
+     * @param mean 平均
+     * @param m2 平方偏差和 ∑(xᵢ - x̄)²
+     */
+    RunningStatistics(size_t count, double mean, double m2);
+    
+    // ============================================================================
+    // データ更新機能
+    // ============================================================================
+    
+    /**
+     * データ点の追加（Welford、O(1)）
+     */
+    void add(double value);
+    
+    /**
+     * 配列の一括追加（1パス）
+     * kBlockSize ごとにSIMDカーネルでブロックの平均・平方偏差和を求めて併合する
+     */
+    void add(const double* data, size_t count);
+    
+    /**
+     * 単精度配列の一括追加（1パス、累積は倍精度）
+     */
+    void add(const float* data, size_t count);
+    
+    /**
+     * 部分結果の併合（Chan、O(1)）
+     */
+    void merge(const RunningStatistics& other);
+    
+    /**
+     * リセット
+     */
+    void reset();
+    
+    // ============================================================================
+    // 状態取得機能
+    // ============================================================================
+    
+    /**
+     * サンプル数取得
+     */
+    size_t getCount() const;
+    
+    /**
+     * 平均取得（空の場合0）
+     */
+    double getMean() const;
+    
+    /**
+     * 平方偏差和 M2 取得
+     */
+    double getM2() const;
+    
+    /**
+     * 不偏分散取得（サンプル数1以下の場合0）
+     */
+    double getVariance() const;
+    
+    /**
+     * 平均の標準誤差取得（サンプル数1以下の場合0）
+     */
+    double getStandardError() const;
+    
+    // ============================================================================
+    // チェックポイント機能
+    // ============================================================================
+    
+    /**
+     * 状態の書き込み
+     */
+    void serialize(CheckpointWriter& writer) const;
+    
+    /**
+     * 状態の読み込み（失敗時は状態を変更しない）
+     */
+    bool deserialize(CheckpointReader& reader);
+
+private:
+    // ============================================================================
+    // 内部状態
+    // ============================================================================
+    
+    size_t count_;      // サンプル数
+    double mean_;       // 平均
+    double m2_;         // 平方偏差和
+};
+
+/**
+ * 2つの部分結果の併合
+ */
+RunningStatistics merge(const RunningStatistics& a, const RunningStatistics& b);
+
+} // namespace mser
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+namespace mser {
+namespace simd {
+
+/**
+ * SIMD命令セット
+ */
+enum class InstructionSet {
+    SCALAR,     // スカラー実装（参照実装）
+    SSE2,       // SSE2 (128bit)
+    AVX2,       // AVX2 + FMA (256bit)
+    AVX512      // AVX-512F (512bit)
+};
+
+/**
+ * スカラー実装との許容相対誤差
+ *
+ * SIMD実装は加算順序が異なるため結果はビット単位では一致しない。
+ * 総和系は ∑|xᵢ| に対する相対誤差、gₙ(k) は値そのものに対する相対誤差で評価する
+ */
+constexpr double kRelativeTolerance = 1e-10;
+
+// ============================================================================
+// 命令セット選択機能
+// ============================================================================
+
+/**
+ * CPUが対応する最上位の命令セットを検出
+ */
+InstructionSet detectInstructionSet();
+
+/**
+ * 現在使用中の命令セット取得（初回呼び出し時にCPU機能から自動選択）
+ */
+InstructionSet getInstructionSet();
+
+/**
+ * 使用する命令セットを強制設定（CPU非対応の場合は対応する最上位に丸める）
+ * @param isa 命令セット
+ * @return 実際に設定された命令セット
+ */
+InstructionSet setInstructionSet(InstructionSet isa);
+
+/**
+ * 命令セット名取得
+ */
+const char* toString(InstructionSet isa);
+
+/**
+ * 現在の命令セットの結果をスカラー実装と比較検証
+ * 走査系カーネルは切り捨て点の一致も確認する
+ * @param sampleCount 検証用データ長
+ * @param tolerance 許容相対誤差
+ * @return すべてのカーネルが許容誤差内かつ切り捨て点が一致する場合true
+ */
+bool validateAgainstScalar(size_t sampleCount = 4096,
+                           double tolerance = kRelativeTolerance);
+
+// ============================================================================
+// 計算カーネル（実行時に選択された命令セットで実行）
+// ============================================================================
+
+/**
+ * 総和 ∑xᵢ
+ */
+double sum(const double* data, size_t count);
+
+/**
+ * 平方偏差和 ∑(xᵢ - mean)²
+ */
+double sumSquaredDeviations(const double* data, size_t count, double mean);
+
+/**
+ * シフト済み和と二乗和 (∑(xᵢ - c), ∑(xᵢ - c)²) を1回の走査で求める
+ * 総和から n·c を差し引く場合と異なり、c が平均に近くても桁落ちしない
+ */
+std::pair<double, double> shiftedSums(const double* data, size_t count, double shift);
+
+/**
+ * バッチ平均 out[i] = 1/m ∑j xᵢₘ₊ⱼ（i < batchCount）
+ * バッチサイズ5はgather/reduceの専用カーネルを使用
+ */
+void batchMeans(const double* data, size_t batchCount, size_t batchSize, double* out);
+
+/**
+ * 接尾和の後方走査による切り捨て点探索
+ *
+ * c=shift として S_k=∑j≥k(xⱼ-c), Q_k=∑j≥k(xⱼ-c)² を後方から累積し、
+ * gₙ(k) = (Q_k - S_k²/(n-k)) / (n-k)² の 0≤k<maxK における最小値を求める
+ * @return 切り捨て点とMSER値のペア（同値の場合は最小のk）
+ */
+std::pair<size_t, double> scanSuffix(const double* data, size_t count,
+                                     size_t maxK, double shift);
+
+/**
+ * 接尾和の後方走査の区間実行（scanSuffix の分割実行用）
+ *
+ * *suffixSum, *suffixSumSq に S_endK, Q_endK を与えると、endK-1 から beginK まで後方に累積して
+ * beginK≤k<endK の gₙ(k) の最小値を求め、終了時に S_beginK, Q_beginK に更新する。
+ * 区間を後方から順に呼び出すと scanSuffix と同じ走査になる（レーン分割の違いによる丸め誤差を除く）
+ * @return 区間内の切り捨て点とMSER値のペア（同値の場合は最小のk）
+ */
+std::pair<size_t, double> scanSuffixRange(const double* data, size_t count, size_t beginK,
+                                          size_t endK, double shift, double* suffixSum,
+                                          double* suffixSumSq);
+
+/**
+ * 重み付き接尾和の後方走査による切り捨て点探索
+ *
+ * c=shift として W_k=∑j≥k wⱼ, S_k=∑j≥k wⱼ(xⱼ-c), Q_k=∑j≥k wⱼ(xⱼ-c)² を後方から累積し、
+ * g(k) = (Q_k - S_k²/W_k) / (W_k·(count-k)) の 0≤k<maxK における最小値を求める
+ * （重み付き分散を接尾の要素数で割った値で、重みの単位によらない）。
+ * 重みがすべて等しい場合は scanSuffix と同じ値になる
+ * @return 切り捨て点とMSER値のペア（同値の場合は最小のk、W_k=0 の k は選ばれない）
+ */
+std::pair<size_t, double> scanSuffixWeighted(const double* data, const double* weight,
+                                             size_t count, size_t maxK, double shift);
+
+/**
+ * 多変量バッチ平均1行分の接尾統計量の評価と除去（次元方向に並列）
+ *
+ * 次元 j ごとに現在の接尾統計量 S_j=suffixSum[j], Q_j=suffixSumSq[j]（要素数 m=suffixCount）から
+ * gⱼ = (Q_j - S_j²/m) / m² を values[j] に書き込み、その後 yⱼ = row[j] - shift[j] を
+ * 接尾から取り除く（S_j -= yⱼ, Q_j -= yⱼ²）。前方に1行ずつ呼び出すと m の大きい順に
+ * 全切り捨て点を走査できる
+ * @return 次元の総和 ∑ⱼ gⱼ（useMax の場合は最大値 maxⱼ gⱼ）
+ */
+double scanMultivariateRow(const double* row, const double* shift, size_t dimensionCount,
+                           double suffixCount, bool useMax, double* suffixSum,
+                           double* suffixSumSq, double* values);
+
+} // namespace simd
+} // namespace mser
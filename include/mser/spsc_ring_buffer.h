@@ -0,0 +1,104 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace mser {
+
+/**
+ * 単一生産者・単一消費者（SPSC）リングバッファ
+ *
+ * 生産者側の tryPush は待機なし（wait-free）で、満杯時は即座に false を返す。
+ * 容量は2のべき乗に切り上げられる
+ */
+template <typename T>
+class SpscRingBuffer {
+public:
+    /**
+     * コンストラクター
+     * @param capacity 最小容量（2のべき乗に切り上げ）
+     */
+    explicit SpscRingBuffer(size_t capacity)
+        : mask_(roundUpToPowerOfTwo(capacity) - 1), buffer_(mask_ + 1), head_(0), tail_(0) {
+    }
+    
+    SpscRingBuffer(const SpscRingBuffer&) = delete;
+    SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+    
+    /**
+     * 要素追加（生産者スレッド専用、wait-free）
+     * @return 満杯の場合false
+     */
+    bool tryPush(const T& value) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) > mask_) {
+            return false;
+        }
+        buffer_[tail & mask_] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+    
+    /**
+     * 要素取り出し（消費者スレッド専用）
+     * @return 空の場合false
+     */
+    bool tryPop(T& value) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        value = buffer_[head & mask_];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+    
+    /**
+     * 一括取り出し（消費者スレッド専用）
+     * @param out 出力先
+     * @param maxCount 最大取り出し数
+     * @return 取り出した要素数
+     */
+    size_t popBulk(T* out, size_t maxCount) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        size_t available = tail_.load(std::memory_order_acquire) - head;
+        size_t count = available < maxCount ? available : maxCount;
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = buffer_[(head + i) & mask_];
+        }
+        head_.store(head + count, std::memory_order_release);
+        return count;
+    }
+    
+    /**
+     * 現在の要素数（概算）
+     */
+    size_t size() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+    
+    /**
+     * 容量
+     */
+    size_t capacity() const {
+        return mask_ + 1;
+    }
+
+private:
+    static size_t roundUpToPowerOfTwo(size_t value) {
+        size_t result = 2;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+    
+    const size_t mask_;
+    std::vector<T> buffer_;
+    
+    alignas(64) std::atomic<size_t> head_;  // 消費者が更新
+    alignas(64) std::atomic<size_t> tail_;  // 生産者が更新
+};
+
+} // namespace mser
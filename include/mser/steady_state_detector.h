@@ -1,7 +1,13 @@
 #pragma once
 
 #include "mser.h"
+#include "checkpoint.h"
+#include "event_dispatcher.h"
+#include "incremental_mser.h"
+#include "time_weighted_mser.h"
 #include "types.h"
+#include <chrono>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
@@ -26,18 +32,30 @@ public:
      * デストラクター
      */
     ~SteadyStateDetector();
-
+    
     // ============================================================================
     // リアルタイム検出機能
     // ============================================================================
     
     /**
      * データポイント追加
+     * NaN/Inf は config.nonFinitePolicy に従って取り込み時に処理する
      * @param value 新しいデータ値
      * @return 定常状態に達した場合true
      */
     bool addDataPoint(TimeSeriesValue value);
     
+    /**
+     * 時刻付きデータポイント追加（不等間隔の観測）
+     * config.timeWeighted=true の場合、各値を次の観測までの保持時間で重み付けする。
+     * 時刻が非有限・直前の観測時刻より前の観測は破棄し、getNonFiniteCount() に計上する。
+     * timeWeighted=false の場合、時刻は無視される
+     * @param value 新しいデータ値
+     * @param timestamp 観測時刻（単調非減少）
+     * @return 定常状態に達した場合true
+     */
+    bool addDataPoint(TimeSeriesValue value, double timestamp);
+    
     /**
      * 複数データポイント追加
      * @param values データ値の配列
@@ -47,6 +65,7 @@ public:
     
     /**
      * 強制検査実行
+     * checkSliceBudget > 0 の場合は走査を開始（走査中は継続）し、予算分のみ実行する
      * @return 現在の収束状態
      */
     bool checkConvergence();
@@ -55,7 +74,7 @@ public:
      * 検出器リセット
      */
     void reset();
-
+    
     // ============================================================================
     // 状態取得機能
     // ============================================================================
@@ -65,6 +84,18 @@ public:
      */
     size_t getCurrentSampleCount() const;
     
+    /**
+     * 取り込み時に検出した非有限値（NaN/Inf）の数
+     * nonFinitePolicy=RESET による再開では保持され、reset() でリセットされる
+     */
+    size_t getNonFiniteCount() const;
+    
+    /**
+     * 蓄積データ中の非有限値の数（nonFinitePolicy=REJECT で取り込んだもの）
+     * 0より大きい間のチェックは未収束となる。reset() でリセットされる
+     */
+    size_t getRejectedCount() const;
+    
     /**
      * 最新のMSER結果取得
      */
@@ -76,16 +107,29 @@ public:
     bool hasConverged() const;
     
     /**
-     * 現在の統計量取得
+     * 分割実行中のチェックの有無取得（走査中は以後の取り込みごとに予算分ずつ継続される）
+     */
+    bool isCheckPending() const;
+    
+    /**
+     * 最新結果の切り捨て時刻取得（timeWeighted 時のみ、それ以外は0）
+     * 切り捨て点のバッチの開始時刻を返す
+     */
+    double getTruncationTime() const;
+    
+    /**
+     * 現在の統計量取得（取り込み時に更新済みの統計量を返す O(1)）
+     * ストリーミングモードでも破棄済みの生データを含む全取り込みサンプルの統計量を返す
      */
     Statistics getCurrentStatistics() const;
-
+    
     // ============================================================================
     // 設定機能
     // ============================================================================
     
     /**
      * 設定更新
+     * ストリーミングモードを無効にした場合は蓄積データを復元できないため reset() 後の状態から再開する
      */
     void updateConfig(const SteadyStateConfig& config);
     
@@ -93,20 +137,103 @@ public:
      * コールバック設定（収束検出時に呼び出される）
      */
     void setConvergenceCallback(std::function<void(const MSERResult&)> callback);
-
+    
+    /**
+     * イベント配信先設定（収束・最大サンプル数到達をキューに発行するのみで、入出力は配信側で行う）
+     * ディスパッチャーは検出器より長く生存すること
+     * @param dispatcher 配信先（nullptr で発行しない）
+     * @param sourceName イベントの発行元名
+     */
+    void setEventDispatcher(EventDispatcher* dispatcher, const std::string& sourceName);
+    
     // ============================================================================
     // データアクセス機能
     // ============================================================================
     
     /**
      * 蓄積データ取得（コピー）
+     * ストリーミングモードでは保持しているバッチ平均系列を返す。
+     * 単精度格納時は倍精度に変換して返す
      */
     TimeSeriesData getAccumulatedData() const;
     
     /**
-     * 現在の平均値取得
+     * 蓄積データ取得（出力先の容量を再利用）
+     * @param out 出力先
+     */
+    void getAccumulatedData(TimeSeriesData& out) const;
+    
+    /**
+     * 現在の平均値取得（O(1)）
      */
     double getCurrentMean() const;
+    
+    // ============================================================================
+    // メトリクス機能
+    // ============================================================================
+    
+    /**
+     * 蓄積データ・インクリメンタル状態・作業領域の確保バイト数
+     */
+    size_t getBytesHeld() const;
+
+#ifdef MSER_ENABLE_METRICS
+    /**
+     * 実行時メトリクスのスナップショット取得（MSER_ENABLE_METRICS 時のみ）
+     */
+    DetectorMetrics getMetrics() const;
+    
+    /**
+     * 実行時メトリクスのリセット（reset() ではリセットされない）
+     */
+    void resetMetrics();
+#endif
+
+    /**
+     * チェックスケジュール統計取得（常時収集、reset() でリセット）
+     */
+    ScheduleStatistics getScheduleStatistics() const;
+    
+    // ============================================================================
+    // チェックポイント機能
+    // ============================================================================
+    
+    /**
+     * 検出器の全状態をバイト列に書き出し
+     * 
+     * 設定・蓄積データ（またはストリーミング時のバッチ平均）・インクリメンタル状態・
+     * 最新結果・チェック位置・収束フラグ・スケジュール統計を含む。
+     * コールバックと実行時メトリクスは含まない
+     * @return バージョン付きチェックポイント
+     */
+    std::vector<std::uint8_t> serialize() const;
+    
+    /**
+     * チェックポイントからの状態復元（再計算・チェックなし）
+     * @param data チェックポイント
+     * @param size バイト数
+     * @return 復元できた場合true（失敗時は状態を変更しない）
+     */
+    bool deserialize(const std::uint8_t* data, size_t size);
+    
+    /**
+     * チェックポイントからの状態復元
+     */
+    bool deserialize(const std::vector<std::uint8_t>& buffer);
+    
+    /**
+     * チェックポイントのファイル保存
+     * @param path 保存先
+     * @return 書き込みに成功した場合true
+     */
+    bool saveCheckpoint(const std::string& path) const;
+    
+    /**
+     * ファイルからの状態復元
+     * @param path チェックポイントファイル
+     * @return 復元できた場合true（失敗時は状態を変更しない）
+     */
+    bool loadCheckpoint(const std::string& path);
 
 private:
     // ============================================================================
@@ -115,22 +242,62 @@ private:
     
     SteadyStateConfig config_;              // 検出設定
     TimeSeriesData data_;                   // 蓄積データ
+    TimeSeriesDataF32 dataF32_;             // 蓄積データ（storage=FLOAT32時）
     MSERResult lastResult_;                 // 最新結果
     bool converged_;                        // 収束フラグ
     size_t lastCheckIndex_;                 // 最後のチェック位置
+    size_t nonFiniteCount_;                 // 取り込み時に検出した非有限値の数
+    size_t rejectedCount_;                  // 蓄積データ中の非有限値の数（REJECT時）
+    TimeSeriesValue lastFiniteValue_;       // 直前の有限値（CLAMP時の置換値）
+    bool hasFiniteValue_;                   // 有限値を取り込み済みか
     
     std::unique_ptr<MSER> mserCalculator_;  // MSER計算器
+    IncrementalMSER incremental_;           // インクリメンタル状態（enableIncremental時）
+    TimeWeightedMSER timeWeighted_;         // 時間重み付き状態（timeWeighted時）
+    TruncationScan scan_;                   // 分割実行中の切り捨て点探索（checkSliceBudget > 0 時）
+    TimeSeriesData timestamps_;             // 観測時刻（timeWeighted かつ非ストリーミング時、再構築用）
+    RunningStatistics statistics_;          // 取り込み済みサンプルの統計量（取り込みごとに更新）
+    MSERWorkspace workspace_;               // 全再計算時の作業領域（maxSamples 分を予約）
     std::function<void(const MSERResult&)> convergenceCallback_;  // コールバック
+    EventDispatcher* eventDispatcher_;      // イベント配信先（nullptr で発行しない）
+    const char* eventSource_;               // イベントの発行元名（配信先が保持）
+#ifdef MSER_ENABLE_METRICS
+    DetectorMetrics metrics_;               // 実行時メトリクス
+#endif
+    ScheduleStatistics schedule_;           // チェックスケジュール統計
+    std::chrono::steady_clock::time_point startTime_;  // 最初のサンプルの取り込み時刻
     
     // ============================================================================
     // 内部機能
     // ============================================================================
     
+    /**
+     * サンプル取り込みの本体（timeWeighted 以外では時刻を使用しない）
+     */
+    bool addSample(TimeSeriesValue value, double timestamp);
+    
+    /**
+     * 非有限値の取り込み方針の適用
+     * @param value 取り込む値（CLAMP時は置換される）
+     * @return 値を取り込む場合true
+     */
+    bool admitValue(TimeSeriesValue& value);
+    
     /**
      * 検査タイミング判定
      */
     bool shouldPerformCheck() const;
     
+    /**
+     * スケジュールに基づく次回チェックまでの最小サンプル数
+     */
+    size_t scheduledInterval() const;
+    
+    /**
+     * 時間予算内判定（チェック時間 ≤ checkTimeBudget × 経過時間）
+     */
+    bool withinTimeBudget() const;
+    
     /**
      * ウォーミングアップ期間判定
      */
@@ -142,9 +309,90 @@ private:
     bool evaluateConvergence(const MSERResult& result);
     
     /**
-     * コールバック呼び出し
+     * コールバック呼び出しとイベント発行
+     */
+    void triggerCallback(const MSERResult& result, DetectorEventType type);
+    
+    /**
+     * インクリメンタル状態を蓄積データから再構築
+     */
+    void rebuildIncrementalState();
+    
+    /**
+     * 時間重み付き状態を蓄積データと観測時刻から再構築
+     * 観測時刻を保持していない場合は等間隔（0, 1, 2, ...）とみなす
+     */
+    void rebuildTimeWeightedState();
+    
+    /**
+     * 蓄積データの統計量を再計算（格納精度の変換時）
+     */
+    void rebuildStatistics();
+
+#ifdef MSER_ENABLE_METRICS
+    /**
+     * サンプル取り込みの記録（チェック間隔ごとに見送り理由を集計）
+     */
+    void recordSample();
+    
+    /**
+     * 収束チェック時間の記録
+     */
+    void recordCheckTime(std::uint64_t elapsedNs);
+#endif
+
+    /**
+     * 単精度格納判定（storage=FLOAT32 かつ非ストリーミング）
+     */
+    bool usesFloatStorage() const;
+    
+    /**
+     * 生データの格納先を現在の storage 設定に合わせて移し替え
+     */
+    void convertStorage();
+    
+    /**
+     * 全再計算用の作業領域の予約（チェック時のヒープ確保を避ける）
+     */
+    void reserveWorkspace();
+    
+    /**
+     * インクリメンタル状態使用判定（enableIncremental または enableStreaming、timeWeighted 時を除く）
+     */
+    bool usesIncrementalState() const;
+    
+    /**
+     * 時間重み付き判定
+     */
+    bool usesTimeWeighting() const;
+    
+    /**
+     * チェックの分割実行判定（checkSliceBudget > 0 かつ SUFFIX_SUM、timeWeighted 時を除く）
+     */
+    bool usesSlicedCheck() const;
+    
+    /**
+     * 分割実行中のチェックの1スライス分の実行
+     * @return 走査が完了し、定常状態が検出された場合true
+     */
+    bool continueSlicedCheck();
+    
+    /**
+     * チェック所要時間の記録
+     */
+    void recordCheckElapsed(std::chrono::steady_clock::time_point start);
+    
+    /**
+     * lastResult_ によるチェックの完了処理（収束判定・コールバック）
+     * @param checkIndex 結果の対象とするサンプル数
+     * @return 定常状態が検出された場合true
+     */
+    bool completeCheck(size_t checkIndex);
+    
+    /**
+     * ストリーミング時に保持しているバッチ平均系列
      */
-    void triggerCallback(const MSERResult& result);
+    const TimeSeriesData& streamingBatchMeans() const;
 };
 
 /**
@@ -154,21 +402,27 @@ namespace integration {
 
 /**
  * PhysXシミュレーション用の定常状態検出器作成
+ * 収束・最大サンプル数到達はディスパッチャーに発行され、ログ出力はディスパッチスレッドで行われる
  * @param config 設定
+ * @param dispatcher イベント配信先（nullptr で defaultEventDispatcher()）
  * @return 検出器のユニークポインタ
  */
 std::unique_ptr<SteadyStateDetector> createForPhysXSimulation(
-    const SteadyStateConfig& config = SteadyStateConfig());
+    const SteadyStateConfig& config = SteadyStateConfig(),
+    EventDispatcher* dispatcher = nullptr);
 
 /**
  * 汎用シミュレーション用の定常状態検出器作成
- * @param metricName 検出対象メトリック名
+ * 収束・最大サンプル数到達はディスパッチャーに発行され、ログ出力はディスパッチスレッドで行われる
+ * @param metricName 検出対象メトリック名（イベントの発行元名）
  * @param config 設定
+ * @param dispatcher イベント配信先（nullptr で defaultEventDispatcher()）
  * @return 検出器のユニークポインタ
  */
 std::unique_ptr<SteadyStateDetector> createForGenericSimulation(
     const std::string& metricName,
-    const SteadyStateConfig& config = SteadyStateConfig());
+    const SteadyStateConfig& config = SteadyStateConfig(),
+    EventDispatcher* dispatcher = nullptr);
 
 } // namespace integration
 
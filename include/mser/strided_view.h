@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace mser {
+
+/**
+ * 要素型ごとの累積計算型
+ *
+ * float・整数型は double で累積し、long double はそのまま long double で累積する
+ */
+template <typename T>
+struct AccumulatorTraits {
+    static_assert(std::is_arithmetic<T>::value, "StridedView requires an arithmetic element type");
+    using type = double;
+};
+
+template <>
+struct AccumulatorTraits<long double> {
+    using type = long double;
+};
+
+template <typename T>
+using AccumulatorType = typename AccumulatorTraits<T>::type;
+
+/**
+ * ストライド付き読み取り専用ビュー（ポインタ・要素数・バイト単位ストライド）
+ *
+ * 構造体配列（AoS）のメンバ列や float 配列をコピーせずにMSER計算へ渡すための軽量ビュー。
+ * ビューは参照先データを所有しない
+ */
+template <typename T>
+class StridedView {
+public:
+    using value_type = T;
+    
+    /**
+     * 空のビュー
+     */
+    StridedView() : data_(nullptr), size_(0), strideBytes_(sizeof(T)) {}
+    
+    /**
+     * コンストラクター
+     * @param data 先頭要素へのポインタ
+     * @param size 要素数
+     * @param strideBytes 隣接要素間のバイト数（既定は連続配置）
+     */
+    StridedView(const T* data, size_t size, size_t strideBytes = sizeof(T))
+        : data_(data), size_(size), strideBytes_(strideBytes) {}
+    
+    /**
+     * 連続配列からのビュー
+     */
+    StridedView(const std::vector<T>& values)
+        : data_(values.data()), size_(values.size()), strideBytes_(sizeof(T)) {}
+    
+    /**
+     * 要素アクセス
+     */
+    const T& operator[](size_t index) const {
+        return *reinterpret_cast<const T*>(
+            reinterpret_cast<const unsigned char*>(data_) + index * strideBytes_);
+    }
+    
+    /**
+     * 部分ビュー [offset, offset + count)
+     */
+    StridedView subview(size_t offset, size_t count) const {
+        return StridedView(&(*this)[offset], count, strideBytes_);
+    }
+    
+    const T* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t strideBytes() const { return strideBytes_; }
+    bool isContiguous() const { return strideBytes_ == sizeof(T); }
+
+private:
+    const T* data_;         // 先頭要素
+    size_t size_;           // 要素数
+    size_t strideBytes_;    // 要素間バイト数
+};
+
+/**
+ * 構造体配列のメンバ列ビュー作成
+ * @param records 構造体配列の先頭
+ * @param count 構造体数
+ * @param field 対象メンバへのポインタ
+ *
+ * 例: makeFieldView(bodies.data(), bodies.size(), &Body::kineticEnergy)
+ */
+template <typename Record, typename T>
+StridedView<T> makeFieldView(const Record* records, size_t count, T Record::*field) {
+    if (count == 0) {
+        return StridedView<T>();
+    }
+    return StridedView<T>(&(records->*field), count, sizeof(Record));
+}
+
+} // namespace mser
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mser {
+
+/**
+ * ワークスティーリング・スレッドプール
+ *
+ * parallelFor のタスク範囲をワーカーごとに分割し、自分の範囲を使い切ったワーカーは
+ * 他のワーカーの残り範囲の後半を奪って実行する。タスクごとのコストが不均一
+ * （長さの異なる時系列など）でも負荷が偏らない。呼び出しスレッドもワーカーとして参加する
+ */
+class ThreadPool {
+public:
+    /**
+     * コンストラクター
+     * @param threadCount 呼び出しスレッドを含むワーカー数（0はハードウェア並列数）
+     */
+    explicit ThreadPool(size_t threadCount = 0);
+    
+    /**
+     * デストラクター（ワーカースレッドを停止）
+     */
+    ~ThreadPool();
+    
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    
+    /**
+     * タスク 0..taskCount-1 を並列実行し、全タスクの完了まで待機
+     * 複数スレッドからの同時呼び出しは逐次化され、タスク内からの入れ子呼び出しは
+     * 呼び出しスレッド上で逐次実行される
+     * @param taskCount タスク数
+     * @param task タスク本体（タスク番号を受け取る）
+     */
+    void parallelFor(size_t taskCount, const std::function<void(size_t)>& task);
+    
+    /**
+     * ワーカー数取得（呼び出しスレッドを含む）
+     */
+    size_t getThreadCount() const;
+
+private:
+    // ============================================================================
+    // 内部状態
+    // ============================================================================
+    
+    /**
+     * ワーカーごとの未実行タスク範囲 [begin, end)
+     */
+    struct WorkRange {
+        std::mutex mutex;
+        size_t begin = 0;
+        size_t end = 0;
+    };
+    
+    size_t threadCount_;                                // ワーカー数
+    std::vector<std::unique_ptr<WorkRange>> ranges_;    // [worker] タスク範囲
+    std::vector<std::thread> threads_;                  // ワーカースレッド（呼び出しスレッド以外）
+    
+    std::mutex jobMutex_;                               // parallelFor の逐次化
+    std::mutex stateMutex_;                             // 以下のジョブ状態を保護
+    std::condition_variable jobReady_;                  // ジョブ開始通知
+    std::condition_variable jobDone_;                   // ジョブ完了通知
+    const std::function<void(size_t)>* task_;           // 実行中のタスク
+    size_t generation_;                                 // ジョブ世代
+    size_t activeWorkers_;                              // ジョブ参加中のワーカー数
+    bool stopping_;                                     // 停止フラグ
+    std::atomic<size_t> pendingTasks_;                  // 未完了タスク数
+    
+    // ============================================================================
+    // 内部機能
+    // ============================================================================
+    
+    /**
+     * ワーカースレッド本体
+     */
+    void workerLoop(size_t worker);
+    
+    /**
+     * タスク範囲が尽きるまで実行（自分の範囲→他ワーカーからの奪取）
+     */
+    void runTasks(size_t worker, const std::function<void(size_t)>& task);
+    
+    /**
+     * 自分の範囲の先頭タスク取得
+     */
+    bool popLocal(size_t worker, size_t& index);
+    
+    /**
+     * 他ワーカーの残り範囲の後半を奪取
+     */
+    bool steal(size_t worker);
+};
+
+} // namespace mser
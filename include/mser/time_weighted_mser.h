@@ -0,0 +1,202 @@
+#pragma once
+
+#include "checkpoint.h"
+#include "types.h"
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace mser {
+
+/**
+ * 時間重み付きインクリメンタルMSER状態
+ *
+ * 不等間隔に観測される (tᵢ, yᵢ) を区分定数の時系列とみなし、各値 yᵢ を
+ * 次の観測までの保持時間 wᵢ = tᵢ₊₁ - tᵢ で重み付けする（離散事象シミュレーションの
+ * 時間平均統計量と同じ扱い）。最後の観測は次の観測が届くまで保持時間が確定しない。
+ *
+ * B個の観測ごとに時間重み付きバッチ平均 X̄ⱼ = ∑wᵢyᵢ / ∑wᵢ とバッチの保持時間 Wⱼ を O(1) で
+ * 登録する。切り捨て点は g(k) = [∑j≥k Wⱼ(X̄ⱼ - Ȳₖ)² / ∑j≥k Wⱼ] / (b - k) の最小化で求め、
+ * 接尾和は現在の時間重み付き平均でシフトした後方累積で求める（O(b) の走査のみ）。
+ * 重み付き分散を残りのバッチ数で割るため時間の単位によらず、等間隔の観測では
+ * IncrementalMSER と同じ値になる
+ *
+ * バッチ数上限を設定すると、上限到達時に隣接バッチを保持時間で重み付けして統合し、
+ * バッチサイズを倍増させる（動的バッチング）
+ */
+class TimeWeightedMSER {
+public:
+    /**
+     * コンストラクター
+     * @param batchSize バッチサイズ（観測数、1で時間重み付きMSER-1）
+     */
+    explicit TimeWeightedMSER(size_t batchSize = 5);
+    
+    /**
+     * デストラクター
+     */
+    ~TimeWeightedMSER();
+    
+    /**
+     * コピー・ムーブ（配列に格納した際の再配置で状態を複製しないようムーブを明示）
+     */
+    TimeWeightedMSER(const TimeWeightedMSER&) = default;
+    TimeWeightedMSER& operator=(const TimeWeightedMSER&) = default;
+    TimeWeightedMSER(TimeWeightedMSER&&) noexcept = default;
+    TimeWeightedMSER& operator=(TimeWeightedMSER&&) noexcept = default;
+    
+    // ============================================================================
+    // データ更新機能
+    // ============================================================================
+    
+    /**
+     * 時刻付きデータポイント追加（O(1)）
+     * 直前の観測の保持時間が確定し、重み付き観測として登録される
+     * @param value 新しいデータ値
+     * @param timestamp 観測時刻（直前の観測時刻以上）
+     * @return 時刻が有限かつ単調非減少で取り込んだ場合true
+     */
+    bool addValue(TimeSeriesValue value, double timestamp);
+    
+    /**
+     * 状態リセット（確保済みメモリは保持）
+     */
+    void reset();
+    
+    /**
+     * バッチサイズ変更（状態はリセットされる）
+     */
+    void setBatchSize(size_t batchSize);
+    
+    /**
+     * 想定バッチ数分のメモリ予約
+     */
+    void reserve(size_t batchCount);
+    
+    /**
+     * 保持バッチ数上限の設定（0で無制限）
+     * 上限は20以上の偶数に丸められる
+     */
+    void setBatchLimit(size_t maxBatches);
+    
+    // ============================================================================
+    // MSER計算機能
+    // ============================================================================
+    
+    /**
+     * 最適な切り捨て点の検索（バッチ平均系列上、O(b)）
+     * 現在の時間重み付き平均でシフトした重み付き後方累積で接尾和を求める
+     * @return 切り捨て点（バッチ単位）とMSER値のペア
+     */
+    std::pair<size_t, double> findOptimalTruncationPoint() const;
+    
+    /**
+     * 現在の状態に対する時間重み付きMSER計算
+     * サンプル数・バッチ数の検証条件は MSER::calculate と同じ
+     * @param variant 結果に記録するMSER変種
+     * @return MSER計算結果（切り捨て点はバッチ単位）
+     */
+    MSERResult evaluate(MSERVariant variant) const;
+    
+    // ============================================================================
+    // 状態取得機能
+    // ============================================================================
+    
+    /**
+     * 現在の実効バッチサイズ取得（圧縮により初期値の2のべき乗倍になる）
+     */
+    size_t getBatchSize() const;
+    
+    /**
+     * 保持バッチ数上限取得（0は無制限）
+     */
+    size_t getBatchLimit() const;
+    
+    /**
+     * 総サンプル数取得（保持時間が未確定の最後の観測を含む）
+     */
+    size_t getSampleCount() const;
+    
+    /**
+     * 完了バッチ数取得
+     */
+    size_t getBatchCount() const;
+    
+    /**
+     * 完了バッチの時間重み付き平均系列取得（保持時間0のバッチは0）
+     */
+    const TimeSeriesData& getBatchMeans() const;
+    
+    /**
+     * 完了バッチの保持時間系列取得
+     */
+    const TimeSeriesData& getBatchWeights() const;
+    
+    /**
+     * 切り捨て点に対応する時刻取得
+     * @param batchIndex 切り捨て点（バッチ単位）
+     * @return 切り捨て点のバッチの開始時刻（最初の観測時刻 + 切り捨てた保持時間）
+     */
+    double getTruncationTime(size_t batchIndex) const;
+    
+    /**
+     * 直前の観測時刻取得（未観測の場合0）
+     */
+    double getLastTimestamp() const;
+    
+    /**
+     * 確保済みメモリ量取得（バッチ平均・保持時間配列の容量）
+     */
+    size_t getBytesHeld() const;
+    
+    // ============================================================================
+    // チェックポイント機能
+    // ============================================================================
+    
+    /**
+     * 状態の書き込み（部分バッチ・バッチ平均・保持時間をそのまま保存）
+     */
+    void serialize(CheckpointWriter& writer) const;
+    
+    /**
+     * 状態の読み込み（再計算なし、失敗時は状態を変更しない）
+     */
+    bool deserialize(CheckpointReader& reader);
+
+private:
+    // ============================================================================
+    // 内部状態
+    // ============================================================================
+    
+    size_t baseBatchSize_;          // 初期バッチサイズ
+    size_t batchSize_;              // 実効バッチサイズ
+    size_t batchLimit_;             // 保持バッチ数上限（0は無制限）
+    size_t sampleCount_;            // 総サンプル数
+    size_t batchFill_;              // 現在の部分バッチの観測数
+    size_t nonFiniteCount_;         // NaN/Inf の数
+    double batchWeightedSum_;       // 現在の部分バッチの ∑wᵢyᵢ
+    double batchWeight_;            // 現在の部分バッチの ∑wᵢ
+    double pendingValue_;           // 保持時間が未確定の最後の観測値
+    double lastTimestamp_;          // 最後の観測時刻
+    double firstTimestamp_;         // 最初の観測時刻
+    
+    TimeSeriesData batchMeans_;     // 完了バッチの時間重み付き平均
+    TimeSeriesData batchWeights_;   // 完了バッチの保持時間
+    
+    /**
+     * 保持時間の確定した観測の登録
+     */
+    void addWeighted(double value, double weight);
+    
+    /**
+     * 完了バッチの登録
+     */
+    void appendBatch(double batchMean, double batchWeight);
+    
+    /**
+     * 隣接バッチの統合（バッチサイズ倍増）
+     */
+    void compact();
+};
+
+} // namespace mser
@@ -1,7 +1,10 @@
 #pragma once
 
+#include "running_statistics.h"
+#include <array>
 #include <vector>
 #include <cstddef>
+#include <cstdint>
 #include <string>
 
 namespace mser {
@@ -11,6 +14,7 @@ namespace mser {
  */
 using TimeSeriesValue = double;
 using TimeSeriesData = std::vector<TimeSeriesValue>;
+using TimeSeriesDataF32 = std::vector<float>;    // 単精度格納（累積は倍精度）
 
 /**
  * MSER変種の種類
@@ -21,6 +25,57 @@ enum class MSERVariant {
     MSER_M      // 任意バッチサイズのMSER-m
 };
 
+/**
+ * 切り捨て点探索アルゴリズム
+ */
+enum class MSERAlgorithm {
+    DIRECT,     // 各kで平均・平方和を再計算（O(n²)、参照実装）
+    SUFFIX_SUM  // シフト済み累積和による一括走査（O(n)）
+};
+
+/**
+ * 検出器の生データ格納精度
+ */
+enum class SampleStorage {
+    FLOAT64,    // 倍精度（既定）
+    FLOAT32     // 単精度（メモリ・帯域を半減、和・平方和は倍精度で累積）
+};
+
+/**
+ * 収束チェックのスケジュール
+ */
+enum class CheckSchedule {
+    FIXED,          // checkInterval サンプルごと（従来動作）
+    GEOMETRIC,      // 前回チェック時のサンプル数 n に対し n·(1+ε) でチェック（チェック回数 O(log n)）
+    TIME_BUDGET     // チェック所要時間が経過時間の一定割合を超えないよう間隔を調整
+};
+
+/**
+ * 分割実行する収束チェックの予算の単位
+ */
+enum class CheckSliceUnit {
+    OPERATIONS,     // 1回の取り込みで走査するバッチ平均の数
+    NANOSECONDS     // 1回の取り込みで走査に使う時間（一定数の走査位置ごとに確認）
+};
+
+/**
+ * 非有限値（NaN/Inf）の取り込み方針
+ */
+enum class NonFinitePolicy {
+    REJECT,     // 取り込むが以後のチェックは未収束（reset() まで、従来動作）
+    SKIP,       // 取り込まずに破棄
+    CLAMP,      // 直前の有限値に置換（有限値が未取り込みの場合は破棄）
+    RESET       // 蓄積データを破棄して検出をやり直す
+};
+
+/**
+ * 多変量MSERの結合基準
+ */
+enum class MultivariateCriterion {
+    TRACE,      // 次元ごとの gₙ(k) の総和（バッチ平均の共分散行列のトレース）
+    MAX         // 次元ごとの gₙ(k) の最大値（最も遅く収束する次元に合わせる）
+};
+
 /**
  * MSER計算結果
  */
@@ -31,9 +86,25 @@ struct MSERResult {
     size_t totalSamples;        // 総サンプル数
     size_t batchCount;          // バッチ数（MSER-m用）
     MSERVariant variant;        // 使用したMSER変種
+    size_t effectiveBatchSize;  // 実効バッチサイズ（ストリーミング時は圧縮により増加）
     
     MSERResult() : truncationPoint(0), mserValue(0.0), converged(false), 
-                   totalSamples(0), batchCount(0), variant(MSERVariant::MSER_5) {}
+                   totalSamples(0), batchCount(0), variant(MSERVariant::MSER_5),
+                   effectiveBatchSize(0) {}
+};
+
+/**
+ * 多変量MSER計算結果
+ *
+ * truncationPoint・mserValue は結合基準による全次元共通の切り捨て点とその値
+ */
+struct MultivariateMSERResult : MSERResult {
+    size_t dimensionCount;              // 次元数
+    MultivariateCriterion criterion;    // 結合基準
+    std::vector<double> dimensionValues;    // 共通の切り捨て点における次元ごとの gₙ(d̂)
+    std::vector<double> dimensionMeans;     // 切り捨て後の次元ごとの平均
+    
+    MultivariateMSERResult() : dimensionCount(0), criterion(MultivariateCriterion::TRACE) {}
 };
 
 /**
@@ -48,6 +119,20 @@ struct SteadyStateConfig {
     size_t checkInterval = 50;                  // チェック間隔
     bool enableWarming = true;                  // ウォーミングアップ有効化
     size_t warmingSteps = 50;                   // ウォーミングアップステップ数
+    MSERAlgorithm algorithm = MSERAlgorithm::SUFFIX_SUM;  // 切り捨て点探索アルゴリズム
+    bool enableIncremental = false;             // インクリメンタル計算有効化
+    bool enableStreaming = false;               // ストリーミング（固定メモリ）モード有効化
+    size_t streamingBudget = 1024;              // ストリーミング時の最大保持バッチ数
+    size_t threadCount = 1;                     // オフライン計算のスレッド数（0=ハードウェア並列数、結果はスレッド数によらず同一、検出器のチェックは常に逐次）
+    SampleStorage storage = SampleStorage::FLOAT64;  // 検出器の生データ格納精度
+    CheckSchedule checkSchedule = CheckSchedule::FIXED;  // 収束チェックのスケジュール
+    double geometricGrowth = 0.1;               // GEOMETRIC 時の増加率 ε
+    double checkTimeBudget = 0.05;              // TIME_BUDGET 時のチェック時間の上限割合（0〜1）
+    NonFinitePolicy nonFinitePolicy = NonFinitePolicy::REJECT;  // 検出器の非有限値の取り込み方針
+    bool preValidated = false;                  // 入力が有限値のみと保証済み（calculate のNaN/Inf走査を省略）
+    bool timeWeighted = false;                  // 検出器の時間重み付きMSER（観測時刻の間隔で重み付け）
+    size_t checkSliceBudget = 0;                // 収束チェックを分割実行する際の取り込み1回あたりの予算（0で一括実行）
+    CheckSliceUnit checkSliceUnit = CheckSliceUnit::OPERATIONS;  // checkSliceBudget の単位
     
     SteadyStateConfig() = default;
 };
@@ -62,6 +147,24 @@ struct Statistics {
     size_t sampleCount;     // サンプル数
     
     Statistics() : mean(0.0), variance(0.0), standardError(0.0), sampleCount(0) {}
+    
+    explicit Statistics(const RunningStatistics& running)
+        : mean(running.getMean()), variance(running.getVariance()),
+          standardError(running.getStandardError()), sampleCount(running.getCount()) {}
+};
+
+/**
+ * チェックスケジュール統計（検出遅延とチェックコストの比較用）
+ */
+struct ScheduleStatistics {
+    size_t checksPerformed;             // 実行した収束チェック回数
+    std::uint64_t checkTimeNs;          // 収束チェックの累積所要時間 [ns]
+    std::uint64_t elapsedTimeNs;        // 最初のサンプルからの経過時間 [ns]
+    size_t detectionSample;             // 収束を検出したサンプル数（未収束は0）
+    size_t detectionLatency;            // 収束検出チェックと直前のチェックの間隔 [サンプル]（検出遅延の上限）
+    
+    ScheduleStatistics() : checksPerformed(0), checkTimeNs(0), elapsedTimeNs(0),
+                           detectionSample(0), detectionLatency(0) {}
 };
 
 /**
@@ -71,8 +174,60 @@ struct BatchStatistics {
     TimeSeriesData batchMeans;  // バッチ平均の系列
     size_t originalSampleCount; // 元データのサンプル数
     size_t batchSize;           // バッチサイズ
+    RunningStatistics meanStatistics;   // バッチ平均の統計量（分散はバッチ平均法の推定に使用）
     
     BatchStatistics() : originalSampleCount(0), batchSize(0) {}
 };
 
+// ============================================================================
+// 実行時メトリクス
+// ============================================================================
+
+/**
+ * メトリクス収集の有効化（CMakeオプション MSER_ENABLE_METRICS）
+ *
+ * 無効時はメトリクスの保持メンバ・取得関数・更新処理がコンパイルされない
+ * クラスのレイアウトが変わるため、ライブラリ利用側も同じ定義でビルドすること
+ */
+#ifdef MSER_ENABLE_METRICS
+constexpr bool kMetricsEnabled = true;
+#else
+constexpr bool kMetricsEnabled = false;
+#endif
+
+/**
+ * チェック遅延ヒストグラムのビン数（ビン i は [2^i, 2^(i+1)) ナノ秒）
+ */
+constexpr size_t kLatencyHistogramBins = 40;
+
+/**
+ * MSER計算メトリクス（calculate 呼び出し単位）
+ */
+struct MSERMetrics {
+    std::uint64_t calculateCalls;       // calculate 呼び出し回数
+    std::uint64_t samplesProcessed;     // 処理したサンプル数の累計
+    std::uint64_t totalTimeNs;          // 累積計算時間 [ns]
+    std::uint64_t maxTimeNs;            // 最大計算時間 [ns]
+    
+    MSERMetrics() : calculateCalls(0), samplesProcessed(0), totalTimeNs(0), maxTimeNs(0) {}
+};
+
+/**
+ * 定常状態検出器メトリクス（スナップショット）
+ */
+struct DetectorMetrics {
+    std::uint64_t samplesIngested;          // 取り込んだサンプル数
+    std::uint64_t checksPerformed;          // 実行した収束チェック数（分割実行時はスライス数）
+    std::uint64_t checksSkippedWarming;     // ウォーミングアップ中に見送ったチェック数
+    std::uint64_t checksSkippedMinSamples;  // 最小サンプル数未満で見送ったチェック数
+    std::uint64_t totalCheckTimeNs;         // MSER計算の累積時間 [ns]
+    std::uint64_t maxCheckTimeNs;           // MSER計算の最大時間 [ns]（分割実行時はスライス単位）
+    std::array<std::uint64_t, kLatencyHistogramBins> checkLatencyHistogram;  // log2ヒストグラム
+    size_t bytesHeld;                       // 蓄積データ・インクリメンタル状態の確保バイト数
+    
+    DetectorMetrics() : samplesIngested(0), checksPerformed(0), checksSkippedWarming(0),
+                        checksSkippedMinSamples(0), totalCheckTimeNs(0), maxCheckTimeNs(0),
+                        checkLatencyHistogram(), bytesHeld(0) {}
+};
+
 } // namespace mser
\ No newline at end of file
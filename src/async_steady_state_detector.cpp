@@ -0,0 +1,170 @@
+#include "mser/async_steady_state_detector.h"
+#include <chrono>
+#include <utility>
+
+namespace mser {
+
+namespace {
+
+constexpr size_t kDrainChunkSize = 256;     // 1回の取り出し数
+constexpr int kIdleSpinCount = 64;          // スリープ前のyield回数
+constexpr auto kIdleSleep = std::chrono::microseconds(100);
+
+} // namespace
+
+AsyncSteadyStateDetector::AsyncSteadyStateDetector(const SteadyStateConfig& config,
+                                                   size_t bufferCapacity)
+    : buffer_(bufferCapacity), detector_(config), pushedCount_(0),
+      running_(true), converged_(false), processedCount_(0), droppedCount_(0) {
+    detector_.setConvergenceCallback([this](const MSERResult& result) {
+        {
+            std::lock_guard<std::mutex> lock(resultMutex_);
+            lastResult_ = result;
+        }
+        converged_.store(true, std::memory_order_release);
+        
+        // 呼び出し中に設定が変更されてもよいよう、複製してからロック外で呼び出す
+        std::function<void(const MSERResult&)> callback;
+        {
+            std::lock_guard<std::mutex> lock(callbackMutex_);
+            callback = convergenceCallback_;
+        }
+        if (callback) {
+            callback(result);
+        }
+    });
+    
+    worker_ = std::thread(&AsyncSteadyStateDetector::run, this);
+}
+
+AsyncSteadyStateDetector::~AsyncSteadyStateDetector() {
+    stop();
+}
+
+// ============================================================================
+// リアルタイム検出機能の実装
+// ============================================================================
+
+bool AsyncSteadyStateDetector::addDataPoint(TimeSeriesValue value) {
+    if (converged_.load(std::memory_order_relaxed)) {
+        return true;  // 既に収束済み
+    }
+    
+    if (buffer_.tryPush(value)) {
+        ++pushedCount_;
+    } else {
+        droppedCount_.fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    return false;
+}
+
+void AsyncSteadyStateDetector::flush() {
+    size_t target = pushedCount_;
+    std::unique_lock<std::mutex> lock(progressMutex_);
+    progressChanged_.wait(lock, [this, target] {
+        return !running_.load(std::memory_order_acquire) ||
+               converged_.load(std::memory_order_acquire) ||
+               processedCount_.load(std::memory_order_acquire) >= target;
+    });
+}
+
+void AsyncSteadyStateDetector::stop() {
+    if (!worker_.joinable()) {
+        return;
+    }
+    
+    running_.store(false, std::memory_order_release);
+    worker_.join();
+    notifyProgress();
+}
+
+// ============================================================================
+// 状態取得機能の実装
+// ============================================================================
+
+bool AsyncSteadyStateDetector::hasConverged() const {
+    return converged_.load(std::memory_order_acquire);
+}
+
+MSERResult AsyncSteadyStateDetector::getLastResult() const {
+    std::lock_guard<std::mutex> lock(resultMutex_);
+    return lastResult_;
+}
+
+size_t AsyncSteadyStateDetector::getProcessedCount() const {
+    return processedCount_.load(std::memory_order_acquire);
+}
+
+size_t AsyncSteadyStateDetector::getDroppedCount() const {
+    return droppedCount_.load(std::memory_order_relaxed);
+}
+
+// ============================================================================
+// 設定機能の実装
+// ============================================================================
+
+void AsyncSteadyStateDetector::setConvergenceCallback(
+    std::function<void(const MSERResult&)> callback) {
+    std::lock_guard<std::mutex> lock(callbackMutex_);
+    convergenceCallback_ = std::move(callback);
+}
+
+// ============================================================================
+// 内部機能の実装
+// ============================================================================
+
+void AsyncSteadyStateDetector::run() {
+    int idleCount = 0;
+    
+    while (running_.load(std::memory_order_acquire)) {
+        if (drain() > 0) {
+            idleCount = 0;
+            continue;
+        }
+        
+        // データがない間はyield、その後短時間スリープ
+        if (++idleCount < kIdleSpinCount) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(kIdleSleep);
+        }
+    }
+    
+    // 停止前に残りを処理
+    while (drain() > 0) {
+    }
+}
+
+size_t AsyncSteadyStateDetector::drain() {
+    TimeSeriesValue chunk[kDrainChunkSize];
+    size_t count = buffer_.popBulk(chunk, kDrainChunkSize);
+    if (count == 0) {
+        return 0;
+    }
+    
+    size_t checkIndex = detector_.getLastResult().totalSamples;
+    for (size_t i = 0; i < count && !detector_.hasConverged(); ++i) {
+        detector_.addDataPoint(chunk[i]);
+    }
+    
+    // チェックが行われた場合のみ結果を公開
+    if (detector_.getLastResult().totalSamples != checkIndex) {
+        std::lock_guard<std::mutex> lock(resultMutex_);
+        lastResult_ = detector_.getLastResult();
+    }
+    
+    processedCount_.fetch_add(count, std::memory_order_release);
+    notifyProgress();
+    return count;
+}
+
+void AsyncSteadyStateDetector::notifyProgress() {
+    // 待機側の条件判定と通知の間で通知が失われないよう、ロックを経由してから通知
+    {
+        std::lock_guard<std::mutex> lock(progressMutex_);
+    }
+    progressChanged_.notify_all();
+}
+
+} // namespace mser
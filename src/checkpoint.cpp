@@ -0,0 +1,134 @@
+#include "mser/checkpoint.h"
+#include <fstream>
+
+namespace mser {
+
+namespace {
+
+/**
+ * 列挙値の読み込み（count 未満の値のみ受け付ける）
+ */
+template <typename Enum>
+bool readEnum(CheckpointReader& reader, Enum& value, std::uint32_t count) {
+    std::uint32_t raw = 0;
+    if (!reader.read(raw) || raw >= count) {
+        return false;
+    }
+    value = static_cast<Enum>(raw);
+    return true;
+}
+
+template <typename Enum>
+void writeEnum(CheckpointWriter& writer, Enum value) {
+    writer.write(static_cast<std::uint32_t>(value));
+}
+
+} // namespace
+
+// ============================================================================
+// 共通構造体のシリアライズの実装
+// ============================================================================
+
+void writeConfig(CheckpointWriter& writer, const SteadyStateConfig& config) {
+    writeEnum(writer, config.variant);
+    writer.writeSize(config.batchSize);
+    writer.writeSize(config.minSamples);
+    writer.writeSize(config.maxSamples);
+    writer.write(config.convergenceThreshold);
+    writer.writeSize(config.checkInterval);
+    writer.writeBool(config.enableWarming);
+    writer.writeSize(config.warmingSteps);
+    writeEnum(writer, config.algorithm);
+    writer.writeBool(config.enableIncremental);
+    writer.writeBool(config.enableStreaming);
+    writer.writeSize(config.streamingBudget);
+    writer.writeSize(config.threadCount);
+    writeEnum(writer, config.storage);
+    writeEnum(writer, config.checkSchedule);
+    writer.write(config.geometricGrowth);
+    writer.write(config.checkTimeBudget);
+    writeEnum(writer, config.nonFinitePolicy);
+    writer.writeBool(config.preValidated);
+    writer.writeBool(config.timeWeighted);
+    writer.writeSize(config.checkSliceBudget);
+    writeEnum(writer, config.checkSliceUnit);
+}
+
+bool readConfig(CheckpointReader& reader, SteadyStateConfig& config) {
+    return readEnum(reader, config.variant, 3) &&
+           reader.readSize(config.batchSize) &&
+           reader.readSize(config.minSamples) &&
+           reader.readSize(config.maxSamples) &&
+           reader.read(config.convergenceThreshold) &&
+           reader.readSize(config.checkInterval) &&
+           reader.readBool(config.enableWarming) &&
+           reader.readSize(config.warmingSteps) &&
+           readEnum(reader, config.algorithm, 2) &&
+           reader.readBool(config.enableIncremental) &&
+           reader.readBool(config.enableStreaming) &&
+           reader.readSize(config.streamingBudget) &&
+           reader.readSize(config.threadCount) &&
+           readEnum(reader, config.storage, 2) &&
+           readEnum(reader, config.checkSchedule, 3) &&
+           reader.read(config.geometricGrowth) &&
+           reader.read(config.checkTimeBudget) &&
+           readEnum(reader, config.nonFinitePolicy, 4) &&
+           reader.readBool(config.preValidated) &&
+           reader.readBool(config.timeWeighted) &&
+           reader.readSize(config.checkSliceBudget) &&
+           readEnum(reader, config.checkSliceUnit, 2);
+}
+
+void writeResult(CheckpointWriter& writer, const MSERResult& result) {
+    writer.writeSize(result.truncationPoint);
+    writer.write(result.mserValue);
+    writer.writeBool(result.converged);
+    writer.writeSize(result.totalSamples);
+    writer.writeSize(result.batchCount);
+    writeEnum(writer, result.variant);
+    writer.writeSize(result.effectiveBatchSize);
+}
+
+bool readResult(CheckpointReader& reader, MSERResult& result) {
+    return reader.readSize(result.truncationPoint) &&
+           reader.read(result.mserValue) &&
+           reader.readBool(result.converged) &&
+           reader.readSize(result.totalSamples) &&
+           reader.readSize(result.batchCount) &&
+           readEnum(reader, result.variant, 3) &&
+           reader.readSize(result.effectiveBatchSize);
+}
+
+// ============================================================================
+// ファイル入出力の実装
+// ============================================================================
+
+bool writeCheckpointFile(const std::string& path, const std::vector<std::uint8_t>& buffer) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(buffer.data()),
+               static_cast<std::streamsize>(buffer.size()));
+    file.close();
+    return static_cast<bool>(file);
+}
+
+bool readCheckpointFile(const std::string& path, std::vector<std::uint8_t>& buffer) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return false;
+    }
+    
+    std::streamoff size = file.tellg();
+    if (size < 0) {
+        return false;
+    }
+    file.seekg(0, std::ios::beg);
+    
+    buffer.resize(static_cast<size_t>(size));
+    file.read(reinterpret_cast<char*>(buffer.data()), size);
+    return static_cast<bool>(file) || (size == 0);
+}
+
+} // namespace mser
@@ -0,0 +1,323 @@
+#include "mser/detector_registry.h"
+#include <algorithm>
+#include <cmath>
+
+namespace mser {
+
+namespace {
+
+constexpr size_t kDefaultShardCount = 64;   // 既定のシャード数
+constexpr size_t kCheckBatchSize = 64;      // 作業バッチあたりのチェック数
+
+} // namespace
+
+DetectorRegistry::Entry::Entry(DetectorId entryId, const SteadyStateConfig& config)
+    : id(entryId), state(IncrementalMSER::batchSizeFor(config)), lastCheckIndex(0),
+      lastFiniteValue(0.0), hasFiniteValue(false), converged(false),
+      maxSamplesReached(false), due(false) {
+    if (config.enableStreaming) {
+        state.setBatchLimit(config.streamingBudget);
+    }
+}
+
+DetectorRegistry::DetectorRegistry(const SteadyStateConfig& config, size_t shardCount,
+                                   size_t threadCount)
+    : config_(config), convergedCount_(0),
+      pool_(std::make_unique<ThreadPool>(threadCount)) {
+    // シャード数は2のべき乗（IDハッシュの下位ビットで振り分け）
+    size_t requested = (shardCount == 0) ? kDefaultShardCount : shardCount;
+    size_t count = 1;
+    while (count < requested) {
+        count <<= 1;
+    }
+    shardMask_ = count - 1;
+    shards_.resize(count);
+}
+
+DetectorRegistry::~DetectorRegistry() {
+}
+
+// ============================================================================
+// リアルタイム検出機能の実装
+// ============================================================================
+
+const std::vector<DetectorId>& DetectorRegistry::ingest(const DetectorSample* samples,
+                                                        size_t count) {
+    convergedIds_.clear();
+    if (count == 0) {
+        return convergedIds_;
+    }
+    
+    // サンプルをシャード順に安定に振り分け（計数ソート）
+    size_t shardCount = shards_.size();
+    shardOffsets_.assign(shardCount + 1, 0);
+    for (size_t i = 0; i < count; ++i) {
+        ++shardOffsets_[shardOf(samples[i].id) + 1];
+    }
+    for (size_t s = 0; s < shardCount; ++s) {
+        shardOffsets_[s + 1] += shardOffsets_[s];
+    }
+    sampleOrder_.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        sampleOrder_[shardOffsets_[shardOf(samples[i].id)]++] = i;
+    }
+    for (size_t s = shardCount; s > 0; --s) {
+        shardOffsets_[s] = shardOffsets_[s - 1];  // 書き込み位置を各シャードの先頭に戻す
+    }
+    shardOffsets_[0] = 0;
+    
+    // シャード単位の並列取り込み（シャードの状態は担当タスクのみが更新）
+    pool_->parallelFor(shardCount, [this, samples](size_t shard) {
+        ingestShard(shard, samples);
+    });
+    
+    // チェック対象を作業バッチにまとめて並列評価
+    dueChecks_.clear();
+    for (size_t s = 0; s < shardCount; ++s) {
+        for (size_t slot : shards_[s].due) {
+            dueChecks_.push_back({s, slot});
+        }
+        shards_[s].due.clear();
+    }
+    
+    size_t batchCount = (dueChecks_.size() + kCheckBatchSize - 1) / kCheckBatchSize;
+    pool_->parallelFor(batchCount, [this](size_t batch) {
+        size_t begin = batch * kCheckBatchSize;
+        size_t end = std::min(begin + kCheckBatchSize, dueChecks_.size());
+        for (size_t i = begin; i < end; ++i) {
+            checkConvergence(shards_[dueChecks_[i].shard].entries[dueChecks_[i].slot]);
+        }
+    });
+    
+    // 新たに収束した検出器の収集（チェック対象は未収束のもののみ）
+    for (const DueCheck& check : dueChecks_) {
+        Entry& entry = shards_[check.shard].entries[check.slot];
+        entry.due = false;
+        if (entry.converged) {
+            convergedIds_.push_back(entry.id);
+            ++convergedCount_;
+        }
+    }
+    
+    return convergedIds_;
+}
+
+const std::vector<DetectorId>& DetectorRegistry::ingest(const std::vector<DetectorSample>& samples) {
+    return ingest(samples.data(), samples.size());
+}
+
+bool DetectorRegistry::remove(DetectorId id) {
+    Shard& shard = shards_[shardOf(id)];
+    auto it = shard.index.find(id);
+    if (it == shard.index.end()) {
+        return false;
+    }
+    
+    size_t slot = it->second;
+    shard.index.erase(it);
+    if (shard.entries[slot].converged) {
+        --convergedCount_;
+    }
+    
+    // 末尾の検出器を空いた位置に移して連続配列を保つ
+    size_t last = shard.entries.size() - 1;
+    if (slot != last) {
+        shard.entries[slot] = std::move(shard.entries[last]);
+        shard.index[shard.entries[slot].id] = slot;
+    }
+    shard.entries.pop_back();
+    return true;
+}
+
+void DetectorRegistry::clear() {
+    for (Shard& shard : shards_) {
+        shard.entries.clear();
+        shard.index.clear();
+        shard.due.clear();
+    }
+    convergedCount_ = 0;
+    convergedIds_.clear();
+}
+
+// ============================================================================
+// 状態取得機能の実装
+// ============================================================================
+
+size_t DetectorRegistry::size() const {
+    size_t total = 0;
+    for (const Shard& shard : shards_) {
+        total += shard.entries.size();
+    }
+    return total;
+}
+
+bool DetectorRegistry::contains(DetectorId id) const {
+    return find(id) != nullptr;
+}
+
+bool DetectorRegistry::hasConverged(DetectorId id) const {
+    const Entry* entry = find(id);
+    return entry != nullptr && entry->converged;
+}
+
+bool DetectorRegistry::hasReachedMaxSamples(DetectorId id) const {
+    const Entry* entry = find(id);
+    return entry != nullptr && entry->maxSamplesReached;
+}
+
+size_t DetectorRegistry::getSampleCount(DetectorId id) const {
+    const Entry* entry = find(id);
+    return (entry != nullptr) ? entry->state.getSampleCount() : 0;
+}
+
+const MSERResult* DetectorRegistry::getLastResult(DetectorId id) const {
+    const Entry* entry = find(id);
+    return (entry != nullptr) ? &entry->lastResult : nullptr;
+}
+
+size_t DetectorRegistry::getConvergedCount() const {
+    return convergedCount_;
+}
+
+size_t DetectorRegistry::getShardCount() const {
+    return shards_.size();
+}
+
+size_t DetectorRegistry::getThreadCount() const {
+    return pool_->getThreadCount();
+}
+
+size_t DetectorRegistry::getBytesHeld() const {
+    size_t bytes = shards_.capacity() * sizeof(Shard) +
+                   shardOffsets_.capacity() * sizeof(size_t) +
+                   sampleOrder_.capacity() * sizeof(size_t) +
+                   dueChecks_.capacity() * sizeof(DueCheck) +
+                   convergedIds_.capacity() * sizeof(DetectorId);
+    for (const Shard& shard : shards_) {
+        bytes += shard.entries.capacity() * sizeof(Entry) +
+                 shard.due.capacity() * sizeof(size_t);
+        for (const Entry& entry : shard.entries) {
+            bytes += entry.state.getBytesHeld();
+        }
+        // 索引はノード（キー・値・次ノードへのポインタ）とバケット配列の概算
+        bytes += shard.index.size() * (sizeof(DetectorId) + sizeof(size_t) + sizeof(void*)) +
+                 shard.index.bucket_count() * sizeof(void*);
+    }
+    return bytes;
+}
+
+// ============================================================================
+// 内部機能の実装
+// ============================================================================
+
+size_t DetectorRegistry::shardOf(DetectorId id) const {
+    // splitmix64 の最終混合（連番IDでもシャードが偏らない）
+    std::uint64_t h = id;
+    h ^= h >> 30;
+    h *= 0xbf58476d1ce4e5b9ULL;
+    h ^= h >> 27;
+    h *= 0x94d049bb133111ebULL;
+    h ^= h >> 31;
+    return static_cast<size_t>(h) & shardMask_;
+}
+
+const DetectorRegistry::Entry* DetectorRegistry::find(DetectorId id) const {
+    const Shard& shard = shards_[shardOf(id)];
+    auto it = shard.index.find(id);
+    return (it != shard.index.end()) ? &shard.entries[it->second] : nullptr;
+}
+
+void DetectorRegistry::ingestShard(size_t shard, const DetectorSample* samples) {
+    Shard& target = shards_[shard];
+    for (size_t k = shardOffsets_[shard]; k < shardOffsets_[shard + 1]; ++k) {
+        const DetectorSample& sample = samples[sampleOrder_[k]];
+        
+        // 未登録のIDは初回サンプルで生成
+        auto [it, inserted] = target.index.try_emplace(sample.id, target.entries.size());
+        if (inserted) {
+            target.entries.emplace_back(sample.id, config_);
+        }
+        
+        size_t slot = it->second;
+        Entry& entry = target.entries[slot];
+        if (entry.converged || entry.maxSamplesReached) {
+            continue;
+        }
+        
+        addValue(entry, sample.value);
+        
+        // チェックは ingest の最後に、その時点の全サンプルで1回だけ行う
+        if (!entry.due && shouldPerformCheck(entry)) {
+            entry.due = true;
+            target.due.push_back(slot);
+        }
+    }
+}
+
+void DetectorRegistry::addValue(Entry& entry, TimeSeriesValue value) {
+    if (std::isfinite(value)) {
+        entry.lastFiniteValue = value;
+        entry.hasFiniteValue = true;
+    } else {
+        switch (config_.nonFinitePolicy) {
+            case NonFinitePolicy::SKIP:
+                return;
+            case NonFinitePolicy::CLAMP:
+                if (!entry.hasFiniteValue) {
+                    return;
+                }
+                value = entry.lastFiniteValue;
+                break;
+            case NonFinitePolicy::RESET:
+                entry.state.reset();
+                entry.lastResult = MSERResult();
+                entry.lastCheckIndex = 0;
+                entry.hasFiniteValue = false;
+                return;
+            case NonFinitePolicy::REJECT:
+            default:
+                break;  // 取り込み、以後のチェックは未収束
+        }
+    }
+    
+    // 最大サンプル数制限（ストリーミングは無期限、以降のサンプルは取り込まない）
+    if (!config_.enableStreaming && entry.state.getSampleCount() >= config_.maxSamples) {
+        entry.maxSamplesReached = true;
+        return;
+    }
+    
+    entry.state.addValue(value);
+}
+
+bool DetectorRegistry::shouldPerformCheck(const Entry& entry) const {
+    size_t sampleCount = entry.state.getSampleCount();
+    
+    // ウォーミングアップ期間中・最小サンプル数未満はチェックしない
+    if (config_.enableWarming && sampleCount < config_.warmingSteps) {
+        return false;
+    }
+    if (sampleCount < config_.minSamples) {
+        return false;
+    }
+    
+    // GEOMETRIC は前回チェック時のサンプル数 n に対し n·(1+ε)、それ以外は checkInterval ごと
+    // （TIME_BUDGET は検出器ごとに時刻を計測しないため FIXED と同じ）
+    size_t interval = config_.checkInterval;
+    if (config_.checkSchedule == CheckSchedule::GEOMETRIC) {
+        auto growth = static_cast<size_t>(
+            std::ceil(static_cast<double>(entry.lastCheckIndex) * config_.geometricGrowth));
+        interval = std::max(interval, growth);
+    }
+    return sampleCount - entry.lastCheckIndex >= interval;
+}
+
+void DetectorRegistry::checkConvergence(Entry& entry) const {
+    entry.lastCheckIndex = entry.state.getSampleCount();
+    entry.lastResult = entry.state.evaluate(config_.variant);
+    
+    // MSER値が収束閾値以下かどうか
+    entry.converged = entry.lastResult.converged &&
+                      entry.lastResult.mserValue <= config_.convergenceThreshold;
+}
+
+} // namespace mser
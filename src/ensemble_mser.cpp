@@ -0,0 +1,152 @@
+#include "mser/ensemble_mser.h"
+#include "mser/mser.h"
+#include "mser/simd.h"
+#include <algorithm>
+#include <cmath>
+
+namespace mser {
+
+namespace {
+
+constexpr size_t kAverageChunkSize = 1 << 14;  // 平均系列計算のチャンク長
+
+} // namespace
+
+EnsembleMSER::EnsembleMSER(size_t threadCount)
+    : pool_(std::make_unique<ThreadPool>(threadCount)) {
+}
+
+EnsembleMSER::~EnsembleMSER() {
+}
+
+// ============================================================================
+// 解析機能の実装
+// ============================================================================
+
+EnsembleResult EnsembleMSER::analyze(const std::vector<TimeSeriesData>& replications,
+                                     const SteadyStateConfig& config) {
+    EnsembleResult result;
+    size_t replicationCount = replications.size();
+    if (replicationCount == 0) {
+        return result;
+    }
+    
+    // 並列化はプールで行うため、個々の計算は1スレッドで実行
+    SteadyStateConfig serialConfig = config;
+    serialConfig.threadCount = 1;
+    
+    // 平均系列は全レプリケーションに共通する区間（最短長）で作成
+    size_t averageLength = replications.front().size();
+    for (const auto& replication : replications) {
+        averageLength = std::min(averageLength, replication.size());
+    }
+    result.averageLength = averageLength;
+    
+    // 1. レプリケーションごとのMSERと平均系列のチャンクを同一プールで実行
+    result.replications.resize(replicationCount);
+    TimeSeriesData averageSeries(averageLength, 0.0);
+    size_t chunkCount = (averageLength + kAverageChunkSize - 1) / kAverageChunkSize;
+    
+    pool_->parallelFor(replicationCount + chunkCount, [&](size_t task) {
+        if (task < replicationCount) {
+            MSER calculator;
+            result.replications[task] = calculator.calculate(replications[task], serialConfig);
+            return;
+        }
+        
+        // レプリケーション順に加算（スレッド数によらず同一の加算順序）
+        size_t begin = (task - replicationCount) * kAverageChunkSize;
+        size_t end = std::min(begin + kAverageChunkSize, averageLength);
+        for (const auto& replication : replications) {
+            for (size_t i = begin; i < end; ++i) {
+                averageSeries[i] += replication[i];
+            }
+        }
+        for (size_t i = begin; i < end; ++i) {
+            averageSeries[i] /= static_cast<double>(replicationCount);
+        }
+    });
+    
+    summarizeTruncations(result);
+    
+    // 2. 平均系列の切り捨て点（共通切り捨て点）
+    MSER calculator;
+    result.averageResult = calculator.calculate(averageSeries, serialConfig);
+    if (result.averageResult.converged) {
+        result.truncationSample = result.averageResult.truncationPoint *
+                                  std::max<size_t>(result.averageResult.effectiveBatchSize, 1);
+    }
+    
+    // 3. 共通切り捨て点以降のレプリケーション平均
+    TimeSeriesData replicationMeans(replicationCount, 0.0);
+    size_t truncationSample = result.truncationSample;
+    pool_->parallelFor(replicationCount, [&](size_t r) {
+        const TimeSeriesData& replication = replications[r];
+        if (replication.size() > truncationSample) {
+            size_t count = replication.size() - truncationSample;
+            replicationMeans[r] = simd::sum(replication.data() + truncationSample, count) / count;
+        }
+    });
+    
+    double meanSum = 0.0;
+    for (double mean : replicationMeans) {
+        meanSum += mean;
+    }
+    result.pooledMean = meanSum / replicationCount;
+    
+    if (replicationCount > 1) {
+        double sumSquaredDeviations = simd::sumSquaredDeviations(replicationMeans.data(),
+                                                                 replicationCount,
+                                                                 result.pooledMean);
+        double variance = sumSquaredDeviations / (replicationCount - 1);
+        result.standardError = std::sqrt(variance / replicationCount);
+    }
+    
+    return result;
+}
+
+size_t EnsembleMSER::getThreadCount() const {
+    return pool_->getThreadCount();
+}
+
+// ============================================================================
+// 内部機能の実装
+// ============================================================================
+
+void EnsembleMSER::summarizeTruncations(EnsembleResult& result) {
+    std::vector<size_t> truncations;
+    truncations.reserve(result.replications.size());
+    for (const auto& replication : result.replications) {
+        if (replication.converged) {
+            truncations.push_back(replication.truncationPoint *
+                                  std::max<size_t>(replication.effectiveBatchSize, 1));
+        }
+    }
+    
+    result.convergedCount = truncations.size();
+    if (truncations.empty()) {
+        return;
+    }
+    
+    std::sort(truncations.begin(), truncations.end());
+    result.truncationMin = truncations.front();
+    result.truncationMax = truncations.back();
+    result.truncationMedian = truncations[(truncations.size() - 1) / 2];
+    
+    double sum = 0.0;
+    for (size_t truncation : truncations) {
+        sum += static_cast<double>(truncation);
+    }
+    result.truncationMean = sum / truncations.size();
+    
+    if (truncations.size() > 1) {
+        double sumSquaredDeviations = 0.0;
+        for (size_t truncation : truncations) {
+            double deviation = static_cast<double>(truncation) - result.truncationMean;
+            sumSquaredDeviations += deviation * deviation;
+        }
+        result.truncationStdDev = std::sqrt(sumSquaredDeviations / (truncations.size() - 1));
+    }
+}
+
+} // namespace mser
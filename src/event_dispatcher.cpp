@@ -0,0 +1,308 @@
+#include "mser/event_dispatcher.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <utility>
+
+namespace mser {
+
+namespace {
+
+constexpr size_t kDispatchChunkSize = 64;   // 1回の取り出し数（シンクへの1回の書き込み単位）
+constexpr int kIdleSpinCount = 16;          // スリープ前のyield回数
+constexpr auto kIdleSleep = std::chrono::milliseconds(1);
+
+const char* variantName(MSERVariant variant) {
+    switch (variant) {
+        case MSERVariant::MSER_1: return "MSER-1";
+        case MSERVariant::MSER_5: return "MSER-5";
+        case MSERVariant::MSER_M: return "MSER-m";
+    }
+    return "unknown";
+}
+
+const char* eventTypeName(DetectorEventType type) {
+    switch (type) {
+        case DetectorEventType::CONVERGED: return "converged";
+        case DetectorEventType::MAX_SAMPLES_REACHED: return "max_samples_reached";
+    }
+    return "unknown";
+}
+
+void writeJsonString(std::ostream& out, const char* text) {
+    static const char kHexDigits[] = "0123456789abcdef";
+    
+    out << '"';
+    for (const char* p = text; *p != '\0'; ++p) {
+        unsigned char c = static_cast<unsigned char>(*p);
+        switch (c) {
+            case '"': out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\r': out << "\\r"; break;
+            case '\t': out << "\\t"; break;
+            default:
+                if (c < 0x20) {
+                    out << "\\u00" << kHexDigits[c >> 4] << kHexDigits[c & 0xF];
+                } else {
+                    out << *p;
+                }
+        }
+    }
+    out << '"';
+}
+
+void writeJsonNumber(std::ostream& out, double value) {
+    // JSON は NaN/Inf を表現できない
+    if (std::isfinite(value)) {
+        out << value;
+    } else {
+        out << "null";
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// ログ出力機能の実装
+// ============================================================================
+
+StreamEventSink::StreamEventSink(std::ostream& out, EventLogFormat format)
+    : out_(out), format_(format) {
+}
+
+StreamEventSink::StreamEventSink(const std::string& path, EventLogFormat format)
+    : file_(std::make_unique<std::ofstream>(path, std::ios::app)), out_(*file_), format_(format) {
+}
+
+void StreamEventSink::write(const DetectorEvent* events, size_t count) {
+    buffer_.str(std::string());
+    buffer_.clear();
+    
+    for (size_t i = 0; i < count; ++i) {
+        if (format_ == EventLogFormat::JSON) {
+            formatJson(events[i]);
+        } else {
+            formatText(events[i]);
+        }
+    }
+    
+    // バッチごとに1回の書き込みとフラッシュ
+    out_ << buffer_.str();
+    out_.flush();
+}
+
+bool StreamEventSink::isOpen() const {
+    return file_ ? file_->is_open() && out_.good() : out_.good();
+}
+
+EventLogFormat StreamEventSink::getFormat() const {
+    return format_;
+}
+
+void StreamEventSink::formatText(const DetectorEvent& event) {
+    const MSERResult& result = event.result;
+    
+    buffer_ << "[定常状態検出] " << event.source;
+    if (event.type == DetectorEventType::CONVERGED) {
+        buffer_ << " が収束しました\n";
+    } else {
+        buffer_ << " が収束前に最大サンプル数に到達しました\n";
+    }
+    buffer_ << "  MSER変種: " << variantName(result.variant) << '\n';
+    buffer_ << "  切り捨て点: " << result.truncationPoint << '\n';
+    buffer_ << "  MSER値: " << result.mserValue << '\n';
+    buffer_ << "  総サンプル数: " << result.totalSamples << '\n';
+    
+    if (result.variant != MSERVariant::MSER_1) {
+        buffer_ << "  バッチ数: " << result.batchCount << '\n';
+    }
+    
+    buffer_ << "  収束状態: " << (result.converged ? "成功" : "失敗") << '\n';
+}
+
+void StreamEventSink::formatJson(const DetectorEvent& event) {
+    const MSERResult& result = event.result;
+    
+    buffer_ << "{\"event\":\"" << eventTypeName(event.type) << "\",\"source\":";
+    writeJsonString(buffer_, event.source);
+    buffer_ << ",\"sequence\":" << event.sequence
+            << ",\"timestampNs\":" << event.timestampNs
+            << ",\"variant\":\"" << variantName(result.variant) << '"'
+            << ",\"truncationPoint\":" << result.truncationPoint
+            << ",\"mserValue\":";
+    buffer_.precision(std::numeric_limits<double>::max_digits10);
+    writeJsonNumber(buffer_, result.mserValue);
+    buffer_.precision(6);
+    buffer_ << ",\"totalSamples\":" << result.totalSamples
+            << ",\"batchCount\":" << result.batchCount
+            << ",\"effectiveBatchSize\":" << result.effectiveBatchSize
+            << ",\"converged\":" << (result.converged ? "true" : "false") << "}\n";
+}
+
+// ============================================================================
+// イベント配信機能の実装
+// ============================================================================
+
+EventDispatcher::EventDispatcher(size_t queueCapacity)
+    : queue_(queueCapacity), running_(true), sequence_(0), publishedCount_(0),
+      deliveredCount_(0), droppedCount_(0) {
+    worker_ = std::thread(&EventDispatcher::run, this);
+}
+
+EventDispatcher::~EventDispatcher() {
+    stop();
+}
+
+bool EventDispatcher::publish(DetectorEventType type, const char* source, const MSERResult& result) {
+    DetectorEvent event;
+    event.type = type;
+    event.source = source ? source : "";
+    event.sequence = sequence_.fetch_add(1, std::memory_order_relaxed);
+    event.timestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    event.result = result;
+    
+    if (!queue_.tryPush(event)) {
+        droppedCount_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    
+    publishedCount_.fetch_add(1, std::memory_order_release);
+    return true;
+}
+
+const char* EventDispatcher::registerSource(const std::string& name) {
+    std::lock_guard<std::mutex> lock(subscribersMutex_);
+    for (const std::string& source : sources_) {
+        if (source == name) {
+            return source.c_str();
+        }
+    }
+    sources_.push_back(name);
+    return sources_.back().c_str();
+}
+
+// ============================================================================
+// 配信先設定機能の実装
+// ============================================================================
+
+void EventDispatcher::subscribe(std::function<void(const DetectorEvent&)> callback) {
+    std::lock_guard<std::mutex> lock(subscribersMutex_);
+    callbacks_.push_back(std::move(callback));
+}
+
+void EventDispatcher::addSink(std::shared_ptr<EventSink> sink) {
+    std::lock_guard<std::mutex> lock(subscribersMutex_);
+    sinks_.push_back(std::move(sink));
+}
+
+// ============================================================================
+// 制御機能の実装
+// ============================================================================
+
+void EventDispatcher::flush() {
+    size_t target = publishedCount_.load(std::memory_order_acquire);
+    std::unique_lock<std::mutex> lock(progressMutex_);
+    progressChanged_.wait(lock, [this, target] {
+        return !running_.load(std::memory_order_acquire) ||
+               deliveredCount_.load(std::memory_order_acquire) >= target;
+    });
+}
+
+void EventDispatcher::stop() {
+    if (!worker_.joinable()) {
+        return;
+    }
+    
+    running_.store(false, std::memory_order_release);
+    worker_.join();
+    notifyProgress();
+}
+
+// ============================================================================
+// 状態取得機能の実装
+// ============================================================================
+
+size_t EventDispatcher::getPublishedCount() const {
+    return publishedCount_.load(std::memory_order_acquire);
+}
+
+size_t EventDispatcher::getDeliveredCount() const {
+    return deliveredCount_.load(std::memory_order_acquire);
+}
+
+size_t EventDispatcher::getDroppedCount() const {
+    return droppedCount_.load(std::memory_order_acquire);
+}
+
+// ============================================================================
+// 内部機能の実装
+// ============================================================================
+
+void EventDispatcher::run() {
+    int idleCount = 0;
+    
+    while (running_.load(std::memory_order_acquire)) {
+        if (drain() > 0) {
+            idleCount = 0;
+            continue;
+        }
+        
+        // イベントがない間はyield、その後スリープ（発行側からの通知は行わない）
+        if (++idleCount < kIdleSpinCount) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(kIdleSleep);
+        }
+    }
+    
+    // 停止前に残りを配信
+    while (drain() > 0) {
+    }
+}
+
+size_t EventDispatcher::drain() {
+    DetectorEvent chunk[kDispatchChunkSize];
+    size_t count = queue_.popBulk(chunk, kDispatchChunkSize);
+    if (count == 0) {
+        return 0;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(subscribersMutex_);
+        for (size_t i = 0; i < count; ++i) {
+            for (const auto& callback : callbacks_) {
+                callback(chunk[i]);
+            }
+        }
+        for (const auto& sink : sinks_) {
+            sink->write(chunk, count);
+        }
+    }
+    
+    deliveredCount_.fetch_add(count, std::memory_order_release);
+    notifyProgress();
+    return count;
+}
+
+void EventDispatcher::notifyProgress() {
+    // 待機側の条件判定と通知の間で通知が失われないよう、ロックを経由してから通知
+    {
+        std::lock_guard<std::mutex> lock(progressMutex_);
+    }
+    progressChanged_.notify_all();
+}
+
+EventDispatcher& defaultEventDispatcher() {
+    static EventDispatcher dispatcher;
+    static const bool initialized = [] {
+        dispatcher.addSink(std::make_shared<StreamEventSink>(std::cout, EventLogFormat::TEXT));
+        return true;
+    }();
+    (void)initialized;
+    return dispatcher;
+}
+
+} // namespace mser
@@ -0,0 +1,361 @@
+#include "mser/incremental_mser.h"
+#include "mser/simd.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace mser {
+
+IncrementalMSER::IncrementalMSER(size_t batchSize)
+    : baseBatchSize_(std::max<size_t>(batchSize, 1)), batchSize_(baseBatchSize_),
+      batchLimit_(0), sampleCount_(0), batchFill_(0),
+      nonFiniteCount_(0), batchSum_(0.0), revision_(0) {
+}
+
+IncrementalMSER::~IncrementalMSER() {
+}
+
+// ============================================================================
+// データ更新機能の実装
+// ============================================================================
+
+void IncrementalMSER::addValue(TimeSeriesValue value) {
+    ++sampleCount_;
+    
+    if (!std::isfinite(value)) {
+        ++nonFiniteCount_;
+    }
+    
+    batchSum_ += value;
+    if (++batchFill_ < batchSize_) {
+        return;
+    }
+    
+    appendBatchMean(batchSum_ / batchSize_);
+    batchSum_ = 0.0;
+    batchFill_ = 0;
+}
+
+void IncrementalMSER::reset() {
+    batchSize_ = baseBatchSize_;
+    sampleCount_ = 0;
+    batchFill_ = 0;
+    nonFiniteCount_ = 0;
+    batchSum_ = 0.0;
+    ++revision_;
+    batchMeans_.clear();
+}
+
+void IncrementalMSER::setBatchSize(size_t batchSize) {
+    baseBatchSize_ = std::max<size_t>(batchSize, 1);
+    reset();
+}
+
+void IncrementalMSER::reserve(size_t batchCount) {
+    batchMeans_.reserve(batchCount);
+}
+
+void IncrementalMSER::setBatchLimit(size_t maxBatches) {
+    if (maxBatches == 0) {
+        batchLimit_ = 0;
+        return;
+    }
+    
+    // 統合後も最低限のバッチ数（10）を確保できるよう偶数かつ20以上
+    batchLimit_ = std::max<size_t>(maxBatches + (maxBatches & 1), 20);
+    reserve(batchLimit_);
+    
+    while (batchMeans_.size() >= batchLimit_) {
+        compact();
+    }
+}
+
+// ============================================================================
+// MSER計算機能の実装
+// ============================================================================
+
+std::pair<size_t, double> IncrementalMSER::findOptimalTruncationPoint() const {
+    size_t n = batchMeans_.size();
+    size_t maxK = n / 2;  // White (1997): k ≤ ⌊n/2⌋-1
+    
+    if (maxK < 2) {
+        return {0, std::numeric_limits<double>::infinity()};
+    }
+    
+    // 全体平均でシフトした後方累積（MSER::calculate の SUFFIX_SUM と同じ走査）
+    // 接頭和の差による接尾和は大きな初期過渡で桁落ちするため用いない
+    double shift = simd::sum(batchMeans_.data(), n) / static_cast<double>(n);
+    return simd::scanSuffix(batchMeans_.data(), n, maxK, shift);
+}
+
+bool IncrementalMSER::prepareEvaluation(MSERVariant variant, MSERResult& result) const {
+    result = MSERResult();
+    result.variant = variant;
+    result.totalSamples = sampleCount_;
+    result.effectiveBatchSize = batchSize_;
+    
+    // MSER::calculate と同じ検証条件
+    bool batched = (variant != MSERVariant::MSER_1 || batchSize_ > 1);
+    size_t minRequiredSize = batched ? batchSize_ * 2 : 10;
+    if (sampleCount_ < minRequiredSize || nonFiniteCount_ > 0) {
+        result.converged = false;
+        return false;
+    }
+    
+    if (batched) {
+        result.batchCount = batchMeans_.size();
+        
+        if (batchMeans_.size() < 10) {  // 最低限のバッチ数
+            result.converged = false;
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+MSERResult IncrementalMSER::evaluate(MSERVariant variant) const {
+    MSERResult result;
+    if (!prepareEvaluation(variant, result)) {
+        return result;
+    }
+    
+    auto [truncPoint, mserVal] = findOptimalTruncationPoint();
+    
+    result.truncationPoint = truncPoint;
+    result.mserValue = mserVal;
+    result.converged = (mserVal < std::numeric_limits<double>::infinity());
+    
+    return result;
+}
+
+// ============================================================================
+// 状態取得機能の実装
+// ============================================================================
+
+size_t IncrementalMSER::getBatchSize() const {
+    return batchSize_;
+}
+
+size_t IncrementalMSER::getBatchLimit() const {
+    return batchLimit_;
+}
+
+size_t IncrementalMSER::getSampleCount() const {
+    return sampleCount_;
+}
+
+size_t IncrementalMSER::getBatchCount() const {
+    return batchMeans_.size();
+}
+
+const TimeSeriesData& IncrementalMSER::getBatchMeans() const {
+    return batchMeans_;
+}
+
+size_t IncrementalMSER::getRevision() const {
+    return revision_;
+}
+
+size_t IncrementalMSER::getBytesHeld() const {
+    return batchMeans_.capacity() * sizeof(TimeSeriesValue);
+}
+
+size_t IncrementalMSER::batchSizeFor(const SteadyStateConfig& config) {
+    switch (config.variant) {
+        case MSERVariant::MSER_1:
+            return 1;
+        case MSERVariant::MSER_M:
+            return std::max<size_t>(config.batchSize, 1);
+        case MSERVariant::MSER_5:
+        default:
+            return 5;
+    }
+}
+
+// ============================================================================
+// チェックポイント機能の実装
+// ============================================================================
+
+void IncrementalMSER::serialize(CheckpointWriter& writer) const {
+    writer.writeSize(baseBatchSize_);
+    writer.writeSize(batchSize_);
+    writer.writeSize(batchLimit_);
+    writer.writeSize(sampleCount_);
+    writer.writeSize(batchFill_);
+    writer.writeSize(nonFiniteCount_);
+    writer.write(batchSum_);
+    writer.writeArray(batchMeans_);
+}
+
+bool IncrementalMSER::deserialize(CheckpointReader& reader) {
+    size_t baseBatchSize = 0;
+    size_t batchSize = 0;
+    size_t batchLimit = 0;
+    size_t sampleCount = 0;
+    size_t batchFill = 0;
+    size_t nonFiniteCount = 0;
+    double batchSum = 0.0;
+    TimeSeriesData batchMeans;
+    
+    bool valid = reader.readSize(baseBatchSize) && reader.readSize(batchSize) &&
+                 reader.readSize(batchLimit) && reader.readSize(sampleCount) &&
+                 reader.readSize(batchFill) && reader.readSize(nonFiniteCount) &&
+                 reader.read(batchSum) && reader.readArray(batchMeans);
+    
+    // 内部不変条件の検証
+    valid = valid && baseBatchSize >= 1 && batchSize >= baseBatchSize &&
+            batchFill < batchSize && nonFiniteCount <= sampleCount &&
+            (batchLimit == 0 || batchMeans.size() < batchLimit);
+    if (!valid) {
+        return false;
+    }
+    
+    baseBatchSize_ = baseBatchSize;
+    batchSize_ = batchSize;
+    batchLimit_ = batchLimit;
+    sampleCount_ = sampleCount;
+    batchFill_ = batchFill;
+    nonFiniteCount_ = nonFiniteCount;
+    batchSum_ = batchSum;
+    batchMeans_ = std::move(batchMeans);
+    ++revision_;
+    
+    if (batchLimit_ > 0) {
+        reserve(batchLimit_);
+    }
+    
+    return true;
+}
+
+// ============================================================================
+// 内部機能の実装
+// ============================================================================
+
+void IncrementalMSER::appendBatchMean(double batchMean) {
+    batchMeans_.push_back(batchMean);
+    
+    if (batchLimit_ > 0 && batchMeans_.size() >= batchLimit_) {
+        compact();
+    }
+}
+
+void IncrementalMSER::compact() {
+    size_t merged = batchMeans_.size() / 2;
+    
+    // 奇数個の場合、末尾のバッチは新しいバッチサイズの部分バッチに戻す
+    if (batchMeans_.size() % 2 != 0) {
+        batchSum_ += batchMeans_.back() * batchSize_;
+        batchFill_ += batchSize_;
+    }
+    
+    // 隣接する2バッチの平均 = 倍サイズのバッチ平均
+    for (size_t i = 0; i < merged; ++i) {
+        batchMeans_[i] = 0.5 * (batchMeans_[2 * i] + batchMeans_[2 * i + 1]);
+    }
+    batchMeans_.resize(merged);
+    batchSize_ *= 2;  // 部分バッチは新しいバッチサイズに向けてそのまま累積を継続する
+    ++revision_;
+}
+
+// ============================================================================
+// 分割走査機能の実装
+// ============================================================================
+
+TruncationScan::TruncationScan()
+    : batchCount_(0), revision_(0), position_(0), endK_(0), shift_(0.0),
+      suffixSum_(0.0), suffixSumSq_(0.0), pending_(false) {
+}
+
+void TruncationScan::begin(const IncrementalMSER& state, MSERVariant variant) {
+    batchCount_ = state.getBatchCount();
+    revision_ = state.getRevision();
+    position_ = batchCount_;
+    endK_ = batchCount_ / 2;  // White (1997): k ≤ ⌊n/2⌋-1
+    suffixSum_ = 0.0;
+    suffixSumSq_ = 0.0;
+    pending_ = state.prepareEvaluation(variant, result_);
+    
+    if (pending_) {
+        result_.truncationPoint = 0;
+        result_.mserValue = std::numeric_limits<double>::infinity();
+        
+        // findOptimalTruncationPoint と同じく候補が2未満の場合は走査しない
+        if (endK_ < 2) {
+            result_.converged = false;
+            pending_ = false;
+            return;
+        }
+        
+        // 全体平均は O(b) の走査を要するため、末尾（定常値に近い）のバッチ平均でシフトする
+        shift_ = state.getBatchMeans()[batchCount_ - 1];
+    }
+}
+
+bool TruncationScan::advance(const IncrementalMSER& state, size_t maxPositions) {
+    if (!pending_) {
+        return true;
+    }
+    
+    // バッチ平均が書き換えられた場合、スナップショットは失われるため現在の状態でやり直す
+    if (state.getRevision() != revision_ || state.getBatchCount() < batchCount_) {
+        begin(state, result_.variant);
+        if (!pending_) {
+            return true;
+        }
+    }
+    
+    const double* batchMeans = state.getBatchMeans().data();
+    size_t budget = std::max<size_t>(maxPositions, 1);
+    
+    // 切り捨て候補外（k ≥ ⌊b/2⌋）の末尾は接尾和の累積のみ
+    while (budget > 0 && position_ > endK_) {
+        double y = batchMeans[--position_] - shift_;
+        suffixSum_ += y;
+        suffixSumSq_ += y * y;
+        --budget;
+    }
+    
+    if (budget > 0 && position_ > 0) {
+        size_t beginK = position_ - std::min(budget, position_);
+        auto [truncPoint, mserVal] = simd::scanSuffixRange(batchMeans, batchCount_, beginK,
+                                                           position_, shift_, &suffixSum_,
+                                                           &suffixSumSq_);
+        
+        // 後方に走査するため、区間をまたいで同値の場合は後の区間（小さいk）を採用
+        if (mserVal <= result_.mserValue) {
+            result_.truncationPoint = truncPoint;
+            result_.mserValue = mserVal;
+        }
+        position_ = beginK;
+    }
+    
+    if (position_ > 0) {
+        return false;
+    }
+    
+    result_.converged = (result_.mserValue < std::numeric_limits<double>::infinity());
+    pending_ = false;
+    return true;
+}
+
+void TruncationScan::cancel() {
+    pending_ = false;
+    position_ = 0;
+    endK_ = 0;
+}
+
+bool TruncationScan::isPending() const {
+    return pending_;
+}
+
+size_t TruncationScan::getRemaining() const {
+    return pending_ ? position_ : 0;
+}
+
+const MSERResult& TruncationScan::getResult() const {
+    return result_;
+}
+
+} // namespace mser
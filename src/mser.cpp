@@ -1,12 +1,80 @@
 #include "mser/mser.h"
+#include "mser/incremental_mser.h"
+#include "mser/mser_kernel.h"
+#include "mser/simd.h"
+#include "mser/time_weighted_mser.h"
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cmath>
 #include <limits>
 #include <stdexcept>
+#include <thread>
 
 namespace mser {
 
-MSER::MSER() {
+namespace {
+
+constexpr size_t kSweepChunkSize = 1 << 12;     // 感度掃引の累積和チャンク長（L1キャッシュに収まる長さ）
+
+/**
+ * 有効スレッド数（0はハードウェア並列数）
+ */
+size_t resolveThreadCount(size_t threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    return threadCount;
+}
+
+/**
+ * タスク番号 0..taskCount-1 を複数スレッドで実行（呼び出しスレッドも参加）
+ * 各タスクの出力先はタスク番号で決まるため、割り当て順は結果に影響しない
+ */
+template <typename Task>
+void parallelFor(size_t taskCount, size_t threadCount, const Task& task) {
+    size_t workerCount = std::min(threadCount, taskCount);
+    if (workerCount <= 1) {
+        for (size_t i = 0; i < taskCount; ++i) {
+            task(i);
+        }
+        return;
+    }
+    
+    std::atomic<size_t> nextTask(0);
+    auto worker = [&]() {
+        for (size_t i = nextTask.fetch_add(1); i < taskCount; i = nextTask.fetch_add(1)) {
+            task(i);
+        }
+    };
+    
+    std::vector<std::thread> threads;
+    threads.reserve(workerCount - 1);
+    for (size_t t = 1; t < workerCount; ++t) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+/**
+ * 全要素の有限性検証
+ */
+bool allFinite(const double* data, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        if (!std::isfinite(data[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+MSER::MSER() : sequential_(false) {
 }
 
 MSER::~MSER() {
@@ -16,17 +84,27 @@ MSER::~MSER() {
 // MSER計算機能の実装
 // ============================================================================
 
-MSERResult MSER::calculateMSER1(const TimeSeriesData& data) {
+MSERResult MSER::calculateMSER1(const TimeSeriesData& data, MSERAlgorithm algorithm) {
+    return calculateMSER1Impl(data, algorithm, false);
+}
+
+MSERResult MSER::calculateMSER1Impl(const TimeSeriesData& data, MSERAlgorithm algorithm,
+                                    bool preValidated) {
+    if (algorithm == MSERAlgorithm::SUFFIX_SUM) {
+        return MSERKernel<1>::calculate(data);  // 検証は系列和に融合済み（追加の走査なし）
+    }
+    
     MSERResult result;
     result.variant = MSERVariant::MSER_1;
     result.totalSamples = data.size();
+    result.effectiveBatchSize = 1;
     
-    if (!validateData(data)) {
+    if (!validateData(data, 10, preValidated)) {
         result.converged = false;
         return result;
     }
     
-    auto [truncPoint, mserVal] = findOptimalTruncationPoint(data);
+    auto [truncPoint, mserVal] = findOptimalTruncationPoint(data, algorithm);
     
     result.truncationPoint = truncPoint;
     result.mserValue = mserVal;
@@ -35,22 +113,53 @@ MSERResult MSER::calculateMSER1(const TimeSeriesData& data) {
     return result;
 }
 
-MSERResult MSER::calculateMSER5(const TimeSeriesData& data) {
-    return calculateMSERm(data, 5);  // 業界標準のバッチサイズ5
+MSERResult MSER::calculateMSER5(const TimeSeriesData& data, MSERAlgorithm algorithm) {
+    if (algorithm == MSERAlgorithm::SUFFIX_SUM) {
+        return MSERKernel<5>::calculate(data);  // 最頻用途のため直接呼び出す
+    }
+    return calculateMSERm(data, 5, algorithm);  // 業界標準のバッチサイズ5
+}
+
+MSERResult MSER::calculateMSERm(const TimeSeriesData& data, size_t batchSize,
+                                MSERAlgorithm algorithm) {
+    MSERWorkspace workspace;
+    return calculateMSERm(data, batchSize, workspace, algorithm);
+}
+
+MSERResult MSER::calculateMSERm(const TimeSeriesData& data, size_t batchSize,
+                                MSERWorkspace& workspace, MSERAlgorithm algorithm) {
+    return calculateMSERmImpl(data, batchSize, workspace, algorithm, false);
 }
 
-MSERResult MSER::calculateMSERm(const TimeSeriesData& data, size_t batchSize) {
+MSERResult MSER::calculateMSERmImpl(const TimeSeriesData& data, size_t batchSize,
+                                    MSERWorkspace& workspace, MSERAlgorithm algorithm,
+                                    bool preValidated) {
+    // 事前インスタンス化済みのバッチサイズはコンパイル時特殊化カーネルへ
+    if (algorithm == MSERAlgorithm::SUFFIX_SUM) {
+        switch (batchSize) {
+            case 5:
+                return MSERKernel<5>::calculate(data.data(), data.size(), workspace.batchMeans());
+            case 10:
+                return MSERKernel<10>::calculate(data.data(), data.size(), workspace.batchMeans());
+            default:
+                break;
+        }
+    }
+    
     MSERResult result;
     result.variant = (batchSize == 5) ? MSERVariant::MSER_5 : MSERVariant::MSER_M;
     result.totalSamples = data.size();
+    result.effectiveBatchSize = batchSize;
     
-    if (!validateData(data, batchSize * 2)) {  // バッチ処理には最低限のサンプル数が必要
+    // バッチ処理には最低限のサンプル数が必要
+    if (!validateData(data, batchSize * 2, preValidated)) {
         result.converged = false;
         return result;
     }
     
     // バッチ平均系列の作成
-    TimeSeriesData batchMeans = createBatchMeans(data, batchSize);
+    TimeSeriesData& batchMeans = workspace.batchMeans();
+    createBatchMeans(data, batchSize, batchMeans);
     result.batchCount = batchMeans.size();
     
     if (batchMeans.size() < 10) {  // 最低限のバッチ数
@@ -59,7 +168,7 @@ MSERResult MSER::calculateMSERm(const TimeSeriesData& data, size_t batchSize) {
     }
     
     // バッチ平均系列に対してMSER-1を適用
-    auto [truncPoint, mserVal] = findOptimalTruncationPoint(batchMeans);
+    auto [truncPoint, mserVal] = findOptimalTruncationPoint(batchMeans, algorithm);
     
     result.truncationPoint = truncPoint;
     result.mserValue = mserVal;
@@ -69,18 +178,431 @@ MSERResult MSER::calculateMSERm(const TimeSeriesData& data, size_t batchSize) {
 }
 
 MSERResult MSER::calculate(const TimeSeriesData& data, const SteadyStateConfig& config) {
+    MSERWorkspace workspace;
+    return calculate(data, config, workspace);
+}
+
+MSERResult MSER::calculate(const TimeSeriesData& data, const SteadyStateConfig& config,
+                           MSERWorkspace& workspace) {
+#ifdef MSER_ENABLE_METRICS
+    auto start = std::chrono::steady_clock::now();
+    MSERResult result = calculateVariant(data, config, workspace);
+    recordCalculate(data.size(), start);
+    return result;
+#else
+    return calculateVariant(data, config, workspace);
+#endif
+}
+
+MSERResult MSER::calculateVariant(const TimeSeriesData& data, const SteadyStateConfig& config,
+                                  MSERWorkspace& workspace) {
+    // 接尾和はスレッド数によらず固定長チャンク単位で計算（threadCount=1 を含め結果は同一）
+    if (!sequential_ && config.algorithm == MSERAlgorithm::SUFFIX_SUM) {
+        size_t batchSize = 5;  // デフォルトは業界標準のMSER-5
+        if (config.variant == MSERVariant::MSER_1) {
+            batchSize = 1;
+        } else if (config.variant == MSERVariant::MSER_M) {
+            batchSize = config.batchSize;
+        }
+        return calculateChunked(data, batchSize, config.threadCount, config.preValidated,
+                                workspace);
+    }
+    
     switch (config.variant) {
         case MSERVariant::MSER_1:
-            return calculateMSER1(data);
-        case MSERVariant::MSER_5:
-            return calculateMSER5(data);
+            return calculateMSER1Impl(data, config.algorithm, config.preValidated);
         case MSERVariant::MSER_M:
-            return calculateMSERm(data, config.batchSize);
+            return calculateMSERmImpl(data, config.batchSize, workspace, config.algorithm,
+                                      config.preValidated);
+        case MSERVariant::MSER_5:
         default:
-            return calculateMSER5(data);  // デフォルトは業界標準のMSER-5
+            // デフォルトは業界標準のMSER-5
+            return calculateMSERmImpl(data, 5, workspace, config.algorithm, config.preValidated);
     }
 }
 
+MSERResult MSER::calculateParallel(const TimeSeriesData& data, size_t batchSize,
+                                   size_t threadCount) {
+    MSERWorkspace workspace;
+    return calculateChunked(data, batchSize, threadCount, false, workspace);
+}
+
+MSERResult MSER::calculateChunked(const TimeSeriesData& data, size_t batchSize,
+                                  size_t threadCount, bool preValidated,
+                                  MSERWorkspace& workspace) {
+    MSERResult result;
+    result.variant = (batchSize == 1) ? MSERVariant::MSER_1
+                   : (batchSize == 5) ? MSERVariant::MSER_5 : MSERVariant::MSER_M;
+    result.totalSamples = data.size();
+    result.effectiveBatchSize = batchSize;
+    
+    bool batched = batchSize > 1;
+    size_t minRequired = batched ? batchSize * 2 : 10;
+    if (batchSize == 0 || data.size() < minRequired) {
+        result.converged = false;
+        return result;
+    }
+    
+    threadCount = resolveThreadCount(threadCount);
+    
+    // 1. チャンク単位のバッチ平均・系列和・NaN/Infチェック（MSERKernel と同じく系列和の有限性で判定）
+    const size_t chunkSize = MSERWorkspace::kChunkSize;
+    size_t seriesCount = data.size() / batchSize;
+    size_t chunkCount = (seriesCount + chunkSize - 1) / chunkSize;
+    
+    TimeSeriesData& batchMeans = workspace.batchMeans();
+    if (batched) {
+        batchMeans.resize(seriesCount);
+    }
+    const double* series = batched ? batchMeans.data() : data.data();
+    
+    std::vector<ChunkPartial>& partials = workspace.chunkPartials();
+    partials.resize(chunkCount);
+    
+    parallelFor(chunkCount, threadCount, [&](size_t chunk) {
+        size_t begin = chunk * chunkSize;
+        size_t end = std::min(begin + chunkSize, seriesCount);
+        
+        size_t rawBegin = begin * batchSize;
+        size_t rawEnd = end * batchSize;
+        if (batched) {
+            simd::batchMeans(data.data() + rawBegin, end - begin, batchSize,
+                             batchMeans.data() + begin);
+        }
+        double sum = simd::sum(series + begin, end - begin);
+        
+        // 系列和が有限なら全要素が有限（非有限の場合のみ生データを再検証、最終チャンクは端数も検証）
+        if (!preValidated) {
+            bool valid = std::isfinite(sum) || allFinite(data.data() + rawBegin, rawEnd - rawBegin);
+            if (valid && chunk + 1 == chunkCount) {
+                valid = allFinite(data.data() + rawEnd, data.size() - rawEnd);
+            }
+            if (!valid) {
+                sum = std::numeric_limits<double>::quiet_NaN();
+            }
+        }
+        partials[chunk].sum = sum;
+    });
+    
+    for (const ChunkPartial& partial : partials) {
+        if (std::isnan(partial.sum)) {
+            result.converged = false;
+            return result;
+        }
+    }
+    
+    if (batched) {
+        result.batchCount = seriesCount;
+        if (seriesCount < 10) {  // 最低限のバッチ数
+            result.converged = false;
+            return result;
+        }
+    }
+    
+    // 2-3. 接尾和の結合とargminの縮約
+    auto [truncPoint, mserVal] = findOptimalTruncationPointChunked(series, seriesCount,
+                                                                   partials, threadCount);
+    
+    result.truncationPoint = truncPoint;
+    result.mserValue = mserVal;
+    result.converged = (mserVal < std::numeric_limits<double>::infinity());
+    
+    return result;
+}
+
+// ============================================================================
+// 感度掃引機能の実装
+// ============================================================================
+
+std::vector<MSERResult> MSER::calculateSweep(const TimeSeriesData& data,
+                                             const std::vector<size_t>& batchSizes) {
+    size_t n = data.size();
+    size_t sweepCount = batchSizes.size();
+    std::vector<MSERResult> results(sweepCount);
+    for (size_t i = 0; i < sweepCount; ++i) {
+        size_t batchSize = batchSizes[i];
+        results[i].variant = (batchSize == 1) ? MSERVariant::MSER_1
+                           : (batchSize == 5) ? MSERVariant::MSER_5 : MSERVariant::MSER_M;
+        results[i].totalSamples = n;
+        results[i].effectiveBatchSize = batchSize;
+    }
+    
+    if (n == 0 || sweepCount == 0) {
+        return results;
+    }
+    
+    // バッチ平均系列を作成するバッチサイズ（サンプル数・バッチ数の下限を満たすもの）
+    std::vector<TimeSeriesData> batchMeans(sweepCount);
+    std::vector<double> carries(sweepCount, 0.0);    // チャンクをまたぐバッチの部分和
+    for (size_t i = 0; i < sweepCount; ++i) {
+        size_t batchSize = batchSizes[i];
+        if (batchSize > 1 && n >= batchSize * 2 && n / batchSize >= 10) {
+            batchMeans[i].resize(n / batchSize);
+        }
+    }
+    
+    // 先頭チャンクの平均でシフトして累積和の桁落ちを防ぐ
+    size_t headLength = std::min(kSweepChunkSize, n);
+    double shift = simd::sum(data.data(), headLength) / headLength;
+    
+    // 生データを1回だけ走査し、チャンク内累積和の差分から全バッチサイズのバッチ平均を作成
+    TimeSeriesData prefix(kSweepChunkSize + 1);
+    double total = 0.0;
+    for (size_t begin = 0; begin < n; begin += kSweepChunkSize) {
+        size_t length = std::min(kSweepChunkSize, n - begin);
+        prefix[0] = 0.0;
+        for (size_t j = 0; j < length; ++j) {
+            prefix[j + 1] = prefix[j] + (data[begin + j] - shift);
+        }
+        total += prefix[length];
+        
+        for (size_t i = 0; i < sweepCount; ++i) {
+            TimeSeriesData& means = batchMeans[i];
+            if (means.empty()) {
+                continue;
+            }
+            
+            size_t batchSize = batchSizes[i];
+            size_t batch = begin / batchSize;
+            size_t batchEnd = (batch + 1) * batchSize;
+            size_t localStart = 0;
+            double carry = carries[i];
+            while (batch < means.size() && batchEnd <= begin + length) {
+                size_t localEnd = batchEnd - begin;
+                double batchSum = carry + (prefix[localEnd] - prefix[localStart]);
+                means[batch] = batchSum / batchSize + shift;
+                carry = 0.0;
+                localStart = localEnd;
+                ++batch;
+                batchEnd += batchSize;
+            }
+            carries[i] = carry + (prefix[length] - prefix[localStart]);
+        }
+    }
+    
+    // 総和が有限なら全要素が有限（NaN/Infを含む系列はすべて未収束）
+    if (!std::isfinite(total)) {
+        return results;
+    }
+    
+    for (size_t i = 0; i < sweepCount; ++i) {
+        size_t batchSize = batchSizes[i];
+        MSERResult& result = results[i];
+        
+        if (batchSize == 1) {
+            result = calculateMSER1(data);  // バッチ平均系列は生データそのもの
+            continue;
+        }
+        if (batchSize == 0 || n < batchSize * 2) {
+            continue;
+        }
+        
+        const TimeSeriesData& means = batchMeans[i];
+        result.batchCount = n / batchSize;
+        if (means.empty()) {  // 最低限のバッチ数に満たない
+            continue;
+        }
+        
+        auto [truncPoint, mserVal] = findOptimalTruncationPointSuffixSum(means);
+        
+        result.truncationPoint = truncPoint;
+        result.mserValue = mserVal;
+        result.converged = (mserVal < std::numeric_limits<double>::infinity());
+    }
+    
+    return results;
+}
+
+MSERResult MSER::calculateTimeWeighted(const TimeSeriesData& values,
+                                       const TimeSeriesData& timestamps,
+                                       const SteadyStateConfig& config) {
+    MSERResult result;
+    result.variant = config.variant;
+    result.totalSamples = values.empty() ? 0 : values.size() - 1;
+    
+    if (values.size() != timestamps.size()) {
+        result.converged = false;
+        return result;
+    }
+    
+    // 時刻付きの観測を1回だけ走査して重み付き累積和を更新
+    TimeWeightedMSER state(IncrementalMSER::batchSizeFor(config));
+    state.reserve(values.size() / state.getBatchSize());
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (!state.addValue(values[i], timestamps[i])) {
+            result.converged = false;  // 時刻が非有限または逆行
+            return result;
+        }
+    }
+    
+    return state.evaluate(config.variant);
+}
+
+MultivariateMSERResult MSER::calculateMultivariate(const TimeSeriesData& data,
+                                                   size_t dimensionCount,
+                                                   const SteadyStateConfig& config,
+                                                   MultivariateCriterion criterion) {
+    MultivariateMSERResult result;
+    result.variant = config.variant;
+    result.dimensionCount = dimensionCount;
+    result.criterion = criterion;
+    
+    if (dimensionCount == 0 || data.size() % dimensionCount != 0) {
+        result.converged = false;
+        return result;
+    }
+    
+    size_t rowCount = data.size() / dimensionCount;
+    size_t batchSize = IncrementalMSER::batchSizeFor(config);
+    result.totalSamples = rowCount;
+    result.effectiveBatchSize = batchSize;
+    
+    // MSER::calculate と同じ検証条件（行数で判定）
+    bool batched = (config.variant != MSERVariant::MSER_1 || batchSize > 1);
+    size_t minRequiredRows = batched ? batchSize * 2 : 10;
+    if (!validateData(data, minRequiredRows * dimensionCount, config.preValidated)) {
+        result.converged = false;
+        return result;
+    }
+    
+    size_t batchCount = rowCount / batchSize;
+    if (batched) {
+        result.batchCount = batchCount;
+        
+        if (batchCount < 10) {  // 最低限のバッチ数
+            result.converged = false;
+            return result;
+        }
+    }
+    
+    // 行単位のバッチ平均（バッチサイズ1は入力をそのまま使用）
+    TimeSeriesData batchMeans;
+    const double* rows = data.data();
+    if (batchSize > 1) {
+        batchMeans.assign(batchCount * dimensionCount, 0.0);
+        for (size_t i = 0; i < batchCount; ++i) {
+            double* out = batchMeans.data() + i * dimensionCount;
+            const double* batch = data.data() + i * batchSize * dimensionCount;
+            for (size_t r = 0; r < batchSize; ++r) {
+                for (size_t j = 0; j < dimensionCount; ++j) {
+                    out[j] += batch[r * dimensionCount + j];
+                }
+            }
+            for (size_t j = 0; j < dimensionCount; ++j) {
+                out[j] /= batchSize;
+            }
+        }
+        rows = batchMeans.data();
+    }
+    
+    // 次元ごとの全体平均をシフト量として接尾和の初期値（k = 0）を計算
+    TimeSeriesData shift(dimensionCount, 0.0);
+    TimeSeriesData suffixSum(dimensionCount, 0.0);
+    TimeSeriesData suffixSumSq(dimensionCount, 0.0);
+    for (size_t i = 0; i < batchCount; ++i) {
+        for (size_t j = 0; j < dimensionCount; ++j) {
+            shift[j] += rows[i * dimensionCount + j];
+        }
+    }
+    for (size_t j = 0; j < dimensionCount; ++j) {
+        shift[j] /= batchCount;
+    }
+    for (size_t i = 0; i < batchCount; ++i) {
+        for (size_t j = 0; j < dimensionCount; ++j) {
+            double y = rows[i * dimensionCount + j] - shift[j];
+            suffixSum[j] += y;
+            suffixSumSq[j] += y * y;
+        }
+    }
+    
+    // 前方走査で k 行目を接尾から取り除きながら結合基準を評価（同値の場合は最小のk）
+    size_t maxK = batchCount / 2;  // White (1997): k ≤ ⌊n/2⌋-1
+    bool useMax = (criterion == MultivariateCriterion::MAX);
+    TimeSeriesData values(dimensionCount);
+    double minValue = std::numeric_limits<double>::infinity();
+    size_t optimalK = 0;
+    for (size_t k = 0; k < maxK; ++k) {
+        double value = simd::scanMultivariateRow(rows + k * dimensionCount, shift.data(),
+                                                 dimensionCount,
+                                                 static_cast<double>(batchCount - k), useMax,
+                                                 suffixSum.data(), suffixSumSq.data(),
+                                                 values.data());
+        if (value < minValue) {
+            minValue = value;
+            optimalK = k;
+            result.dimensionValues.assign(values.begin(), values.end());
+        }
+    }
+    
+    // 切り捨て後の次元ごとの平均
+    result.dimensionMeans.assign(dimensionCount, 0.0);
+    for (size_t i = optimalK; i < batchCount; ++i) {
+        for (size_t j = 0; j < dimensionCount; ++j) {
+            result.dimensionMeans[j] += rows[i * dimensionCount + j];
+        }
+    }
+    for (size_t j = 0; j < dimensionCount; ++j) {
+        result.dimensionMeans[j] /= (batchCount - optimalK);
+    }
+    
+    result.truncationPoint = optimalK;
+    result.mserValue = minValue;
+    result.converged = (minValue < std::numeric_limits<double>::infinity());
+    
+    return result;
+}
+
+// ============================================================================
+// 単精度入力の実装
+// ============================================================================
+
+MSERResult MSER::calculateMSER1(const TimeSeriesDataF32& data, MSERAlgorithm algorithm) {
+    return calculateMSER1(StridedView<float>(data), algorithm);
+}
+
+MSERResult MSER::calculateMSER5(const TimeSeriesDataF32& data, MSERAlgorithm algorithm) {
+    return calculateMSER5(StridedView<float>(data), algorithm);
+}
+
+MSERResult MSER::calculateMSERm(const TimeSeriesDataF32& data, size_t batchSize,
+                                MSERAlgorithm algorithm) {
+    return calculateMSERm(StridedView<float>(data), batchSize, algorithm);
+}
+
+MSERResult MSER::calculate(const TimeSeriesDataF32& data, const SteadyStateConfig& config) {
+    return calculate(StridedView<float>(data), config);
+}
+
+MSERResult MSER::calculate(const TimeSeriesDataF32& data, const SteadyStateConfig& config,
+                           MSERWorkspace& workspace) {
+    return calculate(StridedView<float>(data), config, workspace);
+}
+
+// ============================================================================
+// メトリクス機能の実装
+// ============================================================================
+
+#ifdef MSER_ENABLE_METRICS
+MSERMetrics MSER::getMetrics() const {
+    return metrics_;
+}
+
+void MSER::resetMetrics() {
+    metrics_ = MSERMetrics();
+}
+
+void MSER::recordCalculate(size_t sampleCount, std::chrono::steady_clock::time_point start) {
+    auto elapsed = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count());
+    
+    ++metrics_.calculateCalls;
+    metrics_.samplesProcessed += sampleCount;
+    metrics_.totalTimeNs += elapsed;
+    metrics_.maxTimeNs = std::max(metrics_.maxTimeNs, elapsed);
+}
+#endif
+
 // ============================================================================
 // 統計計算機能の実装
 // ============================================================================
@@ -94,25 +616,11 @@ Statistics MSER::calculateStatistics(const TimeSeriesData& data,
         return stats;  // 無効な範囲の場合はゼロ統計を返す
     }
     
-    size_t n = endIndex - startIndex;
-    stats.sampleCount = n;
-    
-    // 平均値計算
-    stats.mean = calculateMean(data, startIndex, endIndex);
-    
-    // 分散計算
-    double sumSquaredDeviations = 0.0;
-    for (size_t i = startIndex; i < endIndex; ++i) {
-        double deviation = data[i] - stats.mean;
-        sumSquaredDeviations += deviation * deviation;
-    }
-    
-    if (n > 1) {
-        stats.variance = sumSquaredDeviations / (n - 1);
-        stats.standardError = std::sqrt(stats.variance / n);
-    }
+    // 平均・平方偏差和をブロック単位で求めて併合（主記憶の走査は1回）
+    RunningStatistics running;
+    running.add(data.data() + startIndex, endIndex - startIndex);
     
-    return stats;
+    return Statistics(running);
 }
 
 BatchStatistics MSER::calculateBatchStatistics(const TimeSeriesData& data, 
@@ -121,15 +629,57 @@ BatchStatistics MSER::calculateBatchStatistics(const TimeSeriesData& data,
     batchStats.originalSampleCount = data.size();
     batchStats.batchSize = batchSize;
     batchStats.batchMeans = createBatchMeans(data, batchSize);
+    batchStats.meanStatistics.add(batchStats.batchMeans.data(), batchStats.batchMeans.size());
     
     return batchStats;
 }
 
+void MSER::calculateBatchStatistics(const TimeSeriesData& data, size_t batchSize,
+                                    BatchStatistics& batchStats) {
+    batchStats.originalSampleCount = data.size();
+    batchStats.batchSize = batchSize;
+    createBatchMeans(data, batchSize, batchStats.batchMeans);
+    batchStats.meanStatistics.reset();
+    batchStats.meanStatistics.add(batchStats.batchMeans.data(), batchStats.batchMeans.size());
+}
+
+bool MSER::mergeBatchStatistics(BatchStatistics& batchStats, const BatchStatistics& next) {
+    if (batchStats.originalSampleCount == 0) {
+        batchStats = next;
+        return true;
+    }
+    if (next.batchSize != batchStats.batchSize || batchStats.batchSize == 0 ||
+        batchStats.originalSampleCount % batchStats.batchSize != 0) {
+        return false;  // 後続区間のバッチ境界が併合先の境界と揃わない
+    }
+    
+    batchStats.batchMeans.insert(batchStats.batchMeans.end(),
+                                 next.batchMeans.begin(), next.batchMeans.end());
+    batchStats.originalSampleCount += next.originalSampleCount;
+    batchStats.meanStatistics.merge(next.meanStatistics);
+    return true;
+}
+
 // ============================================================================
 // ヘルパー機能の実装
 // ============================================================================
 
-std::pair<size_t, double> MSER::findOptimalTruncationPoint(const TimeSeriesData& data) {
+std::pair<size_t, double> MSER::findOptimalTruncationPoint(const TimeSeriesData& data,
+                                                           MSERAlgorithm algorithm) {
+    switch (algorithm) {
+        case MSERAlgorithm::DIRECT:
+            return findOptimalTruncationPointDirect(data);
+        case MSERAlgorithm::SUFFIX_SUM:
+        default:
+            return findOptimalTruncationPointSuffixSum(data);
+    }
+}
+
+// ============================================================================
+// 内部計算機能の実装
+// ============================================================================
+
+std::pair<size_t, double> MSER::findOptimalTruncationPointDirect(const TimeSeriesData& data) {
     size_t n = data.size();
     size_t maxK = n / 2;  // White (1997): k ≤ ⌊n/2⌋-1
     
@@ -153,9 +703,91 @@ std::pair<size_t, double> MSER::findOptimalTruncationPoint(const TimeSeriesData&
     return {optimalK, minMSER};
 }
 
-// ============================================================================
-// 内部計算機能の実装
-// ============================================================================
+std::pair<size_t, double> MSER::findOptimalTruncationPointSuffixSum(const TimeSeriesData& data) {
+    size_t n = data.size();
+    size_t maxK = n / 2;  // White (1997): k ≤ ⌊n/2⌋-1
+    
+    if (maxK < 2) {
+        return {0, std::numeric_limits<double>::infinity()};
+    }
+    
+    // 全体平均でシフトして平方和の桁落ちを防ぐ
+    double shift = calculateMean(data, 0, n);
+    
+    // 後方走査（SIMDカーネル、同値の場合は最小のk）
+    return simd::scanSuffix(data.data(), n, maxK, shift);
+}
+
+std::pair<size_t, double> MSER::findOptimalTruncationPointChunked(
+    const double* series, size_t count, std::vector<ChunkPartial>& partials, size_t threadCount) {
+    size_t maxK = count / 2;  // White (1997): k ≤ ⌊n/2⌋-1
+    
+    if (maxK < 2) {
+        return {0, std::numeric_limits<double>::infinity()};
+    }
+    
+    const size_t chunkSize = MSERWorkspace::kChunkSize;
+    size_t chunkCount = partials.size();
+    
+    // 全体平均（チャンク和を固定順序で結合）でシフトして平方和の桁落ちを防ぐ
+    double total = 0.0;
+    for (const ChunkPartial& partial : partials) {
+        total += partial.sum;
+    }
+    double shift = total / count;
+    
+    // チャンクごとのシフト済み和・二乗和（∑(x-c) も1回の走査で求め、∑x - n·c の桁落ちを避ける）
+    parallelFor(chunkCount, threadCount, [&](size_t chunk) {
+        size_t begin = chunk * chunkSize;
+        size_t length = std::min(begin + chunkSize, count) - begin;
+        auto [shiftedSum, shiftedSumSq] = simd::shiftedSums(series + begin, length, shift);
+        partials[chunk].suffixSum = shiftedSum;
+        partials[chunk].suffixSumSq = shiftedSumSq;
+    });
+    
+    // 後続チャンクの接尾和に置き換える（後方から固定順序で累積）
+    double carrySum = 0.0;
+    double carrySumSq = 0.0;
+    for (size_t chunk = chunkCount; chunk-- > 0; ) {
+        double chunkSum = partials[chunk].suffixSum;
+        double chunkSumSq = partials[chunk].suffixSumSq;
+        partials[chunk].suffixSum = carrySum;
+        partials[chunk].suffixSumSq = carrySumSq;
+        carrySum += chunkSum;
+        carrySumSq += chunkSumSq;
+    }
+    
+    // k < maxK を含むチャンクのみ走査（SIMDカーネル、同値の場合は最小のk）
+    size_t scanChunkCount = (maxK + chunkSize - 1) / chunkSize;
+    parallelFor(scanChunkCount, threadCount, [&](size_t chunk) {
+        size_t begin = chunk * chunkSize;
+        size_t end = std::min(begin + chunkSize, count);
+        
+        double suffixSum = partials[chunk].suffixSum;
+        double suffixSumSq = partials[chunk].suffixSumSq;
+        if (end > maxK) {
+            auto [tailSum, tailSumSq] = simd::shiftedSums(series + maxK, end - maxK, shift);
+            suffixSum += tailSum;
+            suffixSumSq += tailSumSq;
+            end = maxK;
+        }
+        
+        auto [optimalK, minMSER] = simd::scanSuffixRange(series, count, begin, end, shift,
+                                                         &suffixSum, &suffixSumSq);
+        partials[chunk].optimalK = optimalK;
+        partials[chunk].minMSER = minMSER;
+    });
+    
+    // チャンク順の縮約（厳密に小さい場合のみ更新し、最小のkを優先）
+    std::pair<size_t, double> best = {0, std::numeric_limits<double>::infinity()};
+    for (size_t chunk = 0; chunk < scanChunkCount; ++chunk) {
+        if (partials[chunk].minMSER < best.second) {
+            best = {partials[chunk].optimalK, partials[chunk].minMSER};
+        }
+    }
+    
+    return best;
+}
 
 double MSER::calculateMSERValue(const TimeSeriesData& data, size_t truncationPoint) {
     size_t n = data.size();
@@ -173,11 +805,8 @@ double MSER::calculateMSERValue(const TimeSeriesData& data, size_t truncationPoi
     double mean = calculateMean(data, truncationPoint, n);
     
     // Sn,k² の計算（切り捨て後の平方和）
-    double sumSquaredDeviations = 0.0;
-    for (size_t j = truncationPoint; j < n; ++j) {
-        double deviation = data[j] - mean;
-        sumSquaredDeviations += deviation * deviation;
-    }
+    double sumSquaredDeviations = simd::sumSquaredDeviations(data.data() + truncationPoint,
+                                                             effectiveN, mean);
     
     // gn(k) = Sn,k²/(n-k)² の計算
     double mser = sumSquaredDeviations / (effectiveN * effectiveN);
@@ -187,27 +816,21 @@ double MSER::calculateMSERValue(const TimeSeriesData& data, size_t truncationPoi
 
 TimeSeriesData MSER::createBatchMeans(const TimeSeriesData& data, size_t batchSize) {
     TimeSeriesData batchMeans;
-    
+    createBatchMeans(data, batchSize, batchMeans);
+    return batchMeans;
+}
+
+void MSER::createBatchMeans(const TimeSeriesData& data, size_t batchSize,
+                            TimeSeriesData& batchMeans) {
     if (batchSize == 0) {
-        return batchMeans;
+        batchMeans.clear();
+        return;
     }
     
     size_t numFullBatches = data.size() / batchSize;
-    batchMeans.reserve(numFullBatches);
+    batchMeans.resize(numFullBatches);
     
-    for (size_t i = 0; i < numFullBatches; ++i) {
-        double batchSum = 0.0;
-        size_t startIdx = i * batchSize;
-        size_t endIdx = startIdx + batchSize;
-        
-        for (size_t j = startIdx; j < endIdx; ++j) {
-            batchSum += data[j];
-        }
-        
-        batchMeans.push_back(batchSum / batchSize);
-    }
-    
-    return batchMeans;
+    simd::batchMeans(data.data(), numFullBatches, batchSize, batchMeans.data());
 }
 
 double MSER::calculateMean(const TimeSeriesData& data, size_t startIndex, size_t endIndex) {
@@ -215,18 +838,18 @@ double MSER::calculateMean(const TimeSeriesData& data, size_t startIndex, size_t
         return 0.0;
     }
     
-    double sum = 0.0;
-    for (size_t i = startIndex; i < endIndex; ++i) {
-        sum += data[i];
-    }
+    double sum = simd::sum(data.data() + startIndex, endIndex - startIndex);
     
     return sum / (endIndex - startIndex);
 }
 
-bool MSER::validateData(const TimeSeriesData& data, size_t minRequiredSize) {
+bool MSER::validateData(const TimeSeriesData& data, size_t minRequiredSize, bool preValidated) {
     if (data.size() < minRequiredSize) {
         return false;
     }
+    if (preValidated) {
+        return true;  // 呼び出し側が有限性を保証済み
+    }
     
     // NaN や Inf のチェック
     for (const auto& value : data) {
@@ -0,0 +1,13 @@
+#include "mser/mser_kernel.h"
+
+namespace mser {
+
+// ============================================================================
+// 事前インスタンス化（MSER-1, MSER-5, MSER-10）
+// ============================================================================
+
+template class MSERKernel<1>;
+template class MSERKernel<5>;
+template class MSERKernel<10>;
+
+} // namespace mser
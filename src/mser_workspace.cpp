@@ -0,0 +1,37 @@
+#include "mser/mser_workspace.h"
+
+namespace mser {
+
+MSERWorkspace::MSERWorkspace() {
+}
+
+MSERWorkspace::MSERWorkspace(size_t batchCount) {
+    reserve(batchCount);
+}
+
+MSERWorkspace::~MSERWorkspace() {
+}
+
+// ============================================================================
+// バッファ管理機能の実装
+// ============================================================================
+
+void MSERWorkspace::reserve(size_t batchCount) {
+    batchMeans_.reserve(batchCount);
+    chunkPartials_.reserve(batchCount / kChunkSize + 1);
+}
+
+TimeSeriesData& MSERWorkspace::batchMeans() {
+    return batchMeans_;
+}
+
+std::vector<ChunkPartial>& MSERWorkspace::chunkPartials() {
+    return chunkPartials_;
+}
+
+size_t MSERWorkspace::getBytesHeld() const {
+    return batchMeans_.capacity() * sizeof(TimeSeriesValue) +
+           chunkPartials_.capacity() * sizeof(ChunkPartial);
+}
+
+} // namespace mser
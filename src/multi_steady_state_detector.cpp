@@ -0,0 +1,245 @@
+#include "mser/multi_steady_state_detector.h"
+#include "mser/incremental_mser.h"
+#include "mser/simd.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace mser {
+
+MultiSteadyStateDetector::MultiSteadyStateDetector(size_t metricCount,
+                                                   const SteadyStateConfig& config)
+    : config_(config), metricCount_(metricCount),
+      batchSize_(IncrementalMSER::batchSizeFor(config)),
+      batchCapacity_(config.maxSamples / IncrementalMSER::batchSizeFor(config)),
+      rowCount_(0), batchFill_(0), batchCount_(0), lastCheckIndex_(0),
+      convergedCount_(0), maxSamplesReached_(false) {
+    batchSums_.assign(metricCount_, 0.0);
+    batchMeans_.assign(metricCount_ * batchCapacity_, 0.0);
+    nonFiniteCounts_.assign(metricCount_, 0);
+    converged_.assign(metricCount_, 0);
+    results_.assign(metricCount_, MSERResult());
+}
+
+MultiSteadyStateDetector::~MultiSteadyStateDetector() {
+}
+
+// ============================================================================
+// リアルタイム検出機能の実装
+// ============================================================================
+
+bool MultiSteadyStateDetector::addRow(const TimeSeriesValue* values) {
+    if (allConverged() || maxSamplesReached_) {
+        return allConverged();
+    }
+    
+    // 最大サンプル数制限（以降の行は取り込まない）
+    if (rowCount_ >= config_.maxSamples) {
+        maxSamplesReached_ = true;
+        return false;
+    }
+    
+    ++rowCount_;
+    
+    // 行をメトリック方向に連続して加算（ベクトル化可能なループ）
+    double* sums = batchSums_.data();
+    for (size_t m = 0; m < metricCount_; ++m) {
+        sums[m] += values[m];
+    }
+    
+    if (++batchFill_ == batchSize_) {
+        completeBatch();
+    }
+    
+    if (shouldPerformCheck()) {
+        return checkConvergence();
+    }
+    
+    return false;
+}
+
+bool MultiSteadyStateDetector::addRow(const std::vector<TimeSeriesValue>& values) {
+    if (values.size() != metricCount_) {
+        return allConverged();
+    }
+    return addRow(values.data());
+}
+
+bool MultiSteadyStateDetector::checkConvergence() {
+    if (allConverged()) {
+        return true;
+    }
+    
+    if (config_.enableWarming && rowCount_ < config_.warmingSteps) {
+        return false;
+    }
+    
+    if (rowCount_ < config_.minSamples) {
+        return false;
+    }
+    
+    lastCheckIndex_ = rowCount_;
+    
+    // 未収束メトリックを列ごとに連続走査
+    for (size_t m = 0; m < metricCount_; ++m) {
+        if (converged_[m]) {
+            continue;
+        }
+        
+        results_[m] = evaluateMetric(m);
+        
+        if (results_[m].converged && results_[m].mserValue <= config_.convergenceThreshold) {
+            converged_[m] = 1;
+            ++convergedCount_;
+            if (convergenceCallback_) {
+                convergenceCallback_(m, results_[m]);
+            }
+        }
+    }
+    
+    return allConverged();
+}
+
+void MultiSteadyStateDetector::reset() {
+    std::fill(batchSums_.begin(), batchSums_.end(), 0.0);
+    std::fill(nonFiniteCounts_.begin(), nonFiniteCounts_.end(), 0);
+    std::fill(converged_.begin(), converged_.end(), 0);
+    std::fill(results_.begin(), results_.end(), MSERResult());
+    rowCount_ = 0;
+    batchFill_ = 0;
+    batchCount_ = 0;
+    lastCheckIndex_ = 0;
+    convergedCount_ = 0;
+    maxSamplesReached_ = false;
+}
+
+// ============================================================================
+// 状態取得機能の実装
+// ============================================================================
+
+size_t MultiSteadyStateDetector::getMetricCount() const {
+    return metricCount_;
+}
+
+size_t MultiSteadyStateDetector::getCurrentSampleCount() const {
+    return rowCount_;
+}
+
+const MSERResult& MultiSteadyStateDetector::getLastResult(size_t metric) const {
+    return results_[metric];
+}
+
+const std::vector<MSERResult>& MultiSteadyStateDetector::getLastResults() const {
+    return results_;
+}
+
+bool MultiSteadyStateDetector::hasConverged(size_t metric) const {
+    return converged_[metric] != 0;
+}
+
+bool MultiSteadyStateDetector::allConverged() const {
+    return metricCount_ > 0 && convergedCount_ == metricCount_;
+}
+
+size_t MultiSteadyStateDetector::getConvergedCount() const {
+    return convergedCount_;
+}
+
+bool MultiSteadyStateDetector::hasReachedMaxSamples() const {
+    return maxSamplesReached_;
+}
+
+TimeSeriesData MultiSteadyStateDetector::getBatchMeans(size_t metric) const {
+    const double* column = batchMeans_.data() + columnOffset(metric);
+    return TimeSeriesData(column, column + batchCount_);
+}
+
+// ============================================================================
+// 設定機能の実装
+// ============================================================================
+
+void MultiSteadyStateDetector::setConvergenceCallback(
+    std::function<void(size_t, const MSERResult&)> callback) {
+    convergenceCallback_ = callback;
+}
+
+// ============================================================================
+// 内部機能の実装
+// ============================================================================
+
+bool MultiSteadyStateDetector::shouldPerformCheck() const {
+    if (config_.enableWarming && rowCount_ < config_.warmingSteps) {
+        return false;
+    }
+    
+    if (rowCount_ < config_.minSamples) {
+        return false;
+    }
+    
+    return rowCount_ - lastCheckIndex_ >= config_.checkInterval;
+}
+
+void MultiSteadyStateDetector::completeBatch() {
+    for (size_t m = 0; m < metricCount_; ++m) {
+        double batchMean = batchSums_[m] / batchSize_;
+        batchSums_[m] = 0.0;
+        
+        if (!std::isfinite(batchMean)) {
+            ++nonFiniteCounts_[m];
+        }
+        
+        batchMeans_[columnOffset(m) + batchCount_] = batchMean;
+    }
+    
+    ++batchCount_;
+    batchFill_ = 0;
+}
+
+MSERResult MultiSteadyStateDetector::evaluateMetric(size_t metric) const {
+    MSERResult result;
+    result.variant = config_.variant;
+    result.totalSamples = rowCount_;
+    result.effectiveBatchSize = batchSize_;
+    
+    // MSER::calculate と同じ検証条件
+    bool batched = (config_.variant != MSERVariant::MSER_1);
+    size_t minRequiredSize = batched ? batchSize_ * 2 : 10;
+    if (rowCount_ < minRequiredSize || nonFiniteCounts_[metric] > 0) {
+        result.converged = false;
+        return result;
+    }
+    
+    if (batched) {
+        result.batchCount = batchCount_;
+        
+        if (batchCount_ < 10) {  // 最低限のバッチ数
+            result.converged = false;
+            return result;
+        }
+    }
+    
+    size_t maxK = batchCount_ / 2;  // White (1997): k ≤ ⌊n/2⌋-1
+    if (maxK < 2) {
+        result.mserValue = std::numeric_limits<double>::infinity();
+        result.converged = false;
+        return result;
+    }
+    
+    // 定常側の最終バッチ平均でシフトした後方累積（1回の走査、全体平均のための事前の総和は不要）
+    // 選ばれる切り捨て点以降は定常側のため、接尾和の桁落ちは大きな初期過渡の大きさによらない
+    const double* column = batchMeans_.data() + columnOffset(metric);
+    double shift = column[batchCount_ - 1];
+    auto [truncPoint, mserVal] = simd::scanSuffix(column, batchCount_, maxK, shift);
+    
+    result.truncationPoint = truncPoint;
+    result.mserValue = mserVal;
+    result.converged = (mserVal < std::numeric_limits<double>::infinity());
+    
+    return result;
+}
+
+size_t MultiSteadyStateDetector::columnOffset(size_t metric) const {
+    return metric * batchCapacity_;
+}
+
+} // namespace mser
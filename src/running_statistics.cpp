@@ -0,0 +1,128 @@
+#include "mser/running_statistics.h"
+#include "mser/checkpoint.h"
+#include "mser/simd.h"
+#include <algorithm>
+#include <cmath>
+
+namespace mser {
+
+RunningStatistics::RunningStatistics() : count_(0), mean_(0.0), m2_(0.0) {
+}
+
+RunningStatistics::RunningStatistics(size_t count, double mean, double m2)
+    : count_(count), mean_(count > 0 ? mean : 0.0), m2_(count > 0 ? m2 : 0.0) {
+}
+
+// ============================================================================
+// データ更新機能の実装
+// ============================================================================
+
+void RunningStatistics::add(double value) {
+    ++count_;
+    double delta = value - mean_;
+    mean_ += delta / count_;
+    m2_ += delta * (value - mean_);
+}
+
+void RunningStatistics::add(const double* data, size_t count) {
+    for (size_t offset = 0; offset < count; offset += kBlockSize) {
+        size_t blockCount = std::min(kBlockSize, count - offset);
+        const double* block = data + offset;
+        double blockMean = simd::sum(block, blockCount) / blockCount;
+        merge(RunningStatistics(blockCount, blockMean,
+                                simd::sumSquaredDeviations(block, blockCount, blockMean)));
+    }
+}
+
+void RunningStatistics::add(const float* data, size_t count) {
+    double block[kBlockSize];
+    for (size_t offset = 0; offset < count; offset += kBlockSize) {
+        size_t blockCount = std::min(kBlockSize, count - offset);
+        for (size_t i = 0; i < blockCount; ++i) {
+            block[i] = data[offset + i];
+        }
+        add(block, blockCount);
+    }
+}
+
+void RunningStatistics::merge(const RunningStatistics& other) {
+    if (other.count_ == 0) {
+        return;
+    }
+    if (count_ == 0) {
+        *this = other;
+        return;
+    }
+    
+    size_t count = count_ + other.count_;
+    double delta = other.mean_ - mean_;
+    double otherFraction = static_cast<double>(other.count_) / count;
+    mean_ += delta * otherFraction;
+    m2_ += other.m2_ + delta * delta * static_cast<double>(count_) * otherFraction;
+    count_ = count;
+}
+
+void RunningStatistics::reset() {
+    count_ = 0;
+    mean_ = 0.0;
+    m2_ = 0.0;
+}
+
+// ============================================================================
+// 状態取得機能の実装
+// ============================================================================
+
+size_t RunningStatistics::getCount() const {
+    return count_;
+}
+
+double RunningStatistics::getMean() const {
+    return mean_;
+}
+
+double RunningStatistics::getM2() const {
+    return m2_;
+}
+
+double RunningStatistics::getVariance() const {
+    return (count_ > 1) ? m2_ / (count_ - 1) : 0.0;
+}
+
+double RunningStatistics::getStandardError() const {
+    return (count_ > 1) ? std::sqrt(getVariance() / count_) : 0.0;
+}
+
+// ============================================================================
+// チェックポイント機能の実装
+// ============================================================================
+
+void RunningStatistics::serialize(CheckpointWriter& writer) const {
+    writer.writeSize(count_);
+    writer.write(mean_);
+    writer.write(m2_);
+}
+
+bool RunningStatistics::deserialize(CheckpointReader& reader) {
+    size_t count = 0;
+    double mean = 0.0;
+    double m2 = 0.0;
+    
+    // 平方偏差和は負にならない（非有限値を含む蓄積は NaN のまま受け付ける）
+    if (!reader.readSize(count) || !reader.read(mean) || !reader.read(m2) || m2 < 0.0 ||
+        (count == 0 && (mean != 0.0 || m2 != 0.0))) {
+        return false;
+    }
+    
+    count_ = count;
+    mean_ = mean;
+    m2_ = m2;
+    return true;
+}
+
+RunningStatistics merge(const RunningStatistics& a, const RunningStatistics& b) {
+    RunningStatistics merged = a;
+    merged.merge(b);
+    return merged;
+}
+
+} // namespace mser
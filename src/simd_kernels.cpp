@@ -0,0 +1,1479 @@
+#include "mser/simd.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#if !defined(MSER_DISABLE_SIMD) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MSER_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace mser {
+namespace simd {
+
+namespace {
+
+constexpr double kInfinity = std::numeric_limits<double>::infinity();
+
+/**
+ * 計算カーネル表（命令セットごとに1つ）
+ */
+struct KernelTable {
+    InstructionSet isa;
+    double (*sum)(const double*, size_t);
+    double (*sumSquaredDeviations)(const double*, size_t, double);
+    std::pair<double, double> (*shiftedSums)(const double*, size_t, double);
+    void (*batchMeans)(const double*, size_t, size_t, double*);
+    std::pair<size_t, double> (*scanSuffix)(const double*, size_t, size_t, double);
+    std::pair<size_t, double> (*scanSuffixRange)(const double*, size_t, size_t, size_t, double,
+                                                  double*, double*);
+    std::pair<size_t, double> (*scanSuffixWeighted)(const double*, const double*, size_t, size_t,
+                                                     double);
+    double (*scanMultivariateRow)(const double*, const double*, size_t, double, bool,
+                                  double*, double*, double*);
+};
+
+/**
+ * 接尾統計量からのMSER値 gₙ(k) = (Q - S²/m) / m²
+ */
+inline double mserFromSuffix(double suffixSum, double suffixSumSq, double effectiveN) {
+    double sumSquaredDeviations = suffixSumSq - suffixSum * suffixSum / effectiveN;
+    if (sumSquaredDeviations < 0.0) {
+        sumSquaredDeviations = 0.0;  // 丸め誤差による負値を除去
+    }
+    return sumSquaredDeviations / (effectiveN * effectiveN);
+}
+
+/**
+ * 重み付き接尾統計量からのMSER値 g(k) = (Q - S²/W) / (W·m)（m は接尾の要素数）
+ */
+inline double mserFromWeightedSuffix(double suffixSum, double suffixSumSq, double suffixWeight,
+                                     double suffixCount) {
+    double sumSquaredDeviations = suffixSumSq - suffixSum * suffixSum / suffixWeight;
+    if (sumSquaredDeviations < 0.0) {
+        sumSquaredDeviations = 0.0;  // 丸め誤差による負値を除去
+    }
+    return sumSquaredDeviations / (suffixWeight * suffixCount);
+}
+
+/**
+ * 多変量接尾統計量の1次元分の評価と除去（SIMD実装の端数処理と共通）
+ */
+inline double scanMultivariateDimension(double y, double suffixCount, double& suffixSum,
+                                        double& suffixSumSq) {
+    double g = mserFromSuffix(suffixSum, suffixSumSq, suffixCount);
+    suffixSum -= y;
+    suffixSumSq -= y * y;
+    return g;
+}
+
+/**
+ * 多変量接尾統計量の端数次元 [begin, count) の処理
+ */
+inline double scanMultivariateTail(const double* row, const double* shift, size_t begin,
+                                   size_t count, double suffixCount, bool useMax, double combined,
+                                   double* suffixSum, double* suffixSumSq, double* values) {
+    for (size_t j = begin; j < count; ++j) {
+        values[j] = scanMultivariateDimension(row[j] - shift[j], suffixCount,
+                                              suffixSum[j], suffixSumSq[j]);
+        combined = useMax ? std::max(combined, values[j]) : combined + values[j];
+    }
+    return combined;
+}
+
+/**
+ * レーンごとの最小値候補の統合（同値の場合は最小のk）
+ */
+inline void reduceLanes(const double* laneMin, const double* laneK, int lanes,
+                        double& minMSER, size_t& optimalK) {
+    for (int i = 0; i < lanes; ++i) {
+        size_t k = static_cast<size_t>(laneK[i]);
+        if (laneMin[i] < minMSER || (laneMin[i] == minMSER && k < optimalK)) {
+            minMSER = laneMin[i];
+            optimalK = k;
+        }
+    }
+}
+
+// ============================================================================
+// スカラー実装（参照実装）
+// ============================================================================
+
+double sumScalar(const double* data, size_t count) {
+    double sum = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        sum += data[i];
+    }
+    return sum;
+}
+
+double sumSquaredDeviationsScalar(const double* data, size_t count, double mean) {
+    double sumSquaredDeviations = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        double deviation = data[i] - mean;
+        sumSquaredDeviations += deviation * deviation;
+    }
+    return sumSquaredDeviations;
+}
+
+std::pair<double, double> shiftedSumsScalar(const double* data, size_t count, double shift) {
+    double sum = 0.0;
+    double sumSq = 0.0;
+    for (size_t i = count; i-- > 0; ) {
+        double y = data[i] - shift;
+        sum += y;
+        sumSq += y * y;
+    }
+    return {sum, sumSq};
+}
+
+void batchMeansScalar(const double* data, size_t batchCount, size_t batchSize, double* out) {
+    for (size_t i = 0; i < batchCount; ++i) {
+        double batchSum = 0.0;
+        const double* batch = data + i * batchSize;
+        for (size_t j = 0; j < batchSize; ++j) {
+            batchSum += batch[j];
+        }
+        out[i] = batchSum / batchSize;
+    }
+}
+
+std::pair<size_t, double> scanSuffixRangeScalar(const double* data, size_t count, size_t beginK,
+                                                size_t endK, double shift, double* suffixSum,
+                                                double* suffixSumSq) {
+    double runningSum = *suffixSum;
+    double runningSumSq = *suffixSumSq;
+    
+    double minMSER = kInfinity;
+    size_t optimalK = beginK;
+    
+    for (size_t k = endK; k-- > beginK; ) {
+        double y = data[k] - shift;
+        runningSum += y;
+        runningSumSq += y * y;
+        
+        double mser = mserFromSuffix(runningSum, runningSumSq, static_cast<double>(count - k));
+        if (mser <= minMSER) {
+            minMSER = mser;
+            optimalK = k;
+        }
+    }
+    
+    *suffixSum = runningSum;
+    *suffixSumSq = runningSumSq;
+    return {optimalK, minMSER};
+}
+
+std::pair<size_t, double> scanSuffixScalar(const double* data, size_t count,
+                                           size_t maxK, double shift) {
+    // k ≥ maxK の部分は接尾和の累積のみ
+    auto [suffixSum, suffixSumSq] = shiftedSumsScalar(data + maxK, count - maxK, shift);
+    return scanSuffixRangeScalar(data, count, 0, maxK, shift, &suffixSum, &suffixSumSq);
+}
+
+std::pair<size_t, double> scanSuffixWeightedScalar(const double* data, const double* weight,
+                                                   size_t count, size_t maxK, double shift) {
+    double suffixWeight = 0.0;
+    double suffixSum = 0.0;
+    double suffixSumSq = 0.0;
+    
+    for (size_t j = count; j-- > maxK; ) {
+        double y = data[j] - shift;
+        double wy = weight[j] * y;
+        suffixWeight += weight[j];
+        suffixSum += wy;
+        suffixSumSq += wy * y;
+    }
+    
+    double minMSER = kInfinity;
+    size_t optimalK = 0;
+    
+    for (size_t k = maxK; k-- > 0; ) {
+        double y = data[k] - shift;
+        double wy = weight[k] * y;
+        suffixWeight += weight[k];
+        suffixSum += wy;
+        suffixSumSq += wy * y;
+        
+        double mser = mserFromWeightedSuffix(suffixSum, suffixSumSq, suffixWeight,
+                                             static_cast<double>(count - k));
+        if (mser <= minMSER) {  // 重み0の接尾（NaN）は選ばれない
+            minMSER = mser;
+            optimalK = k;
+        }
+    }
+    
+    return {optimalK, minMSER};
+}
+
+double scanMultivariateRowScalar(const double* row, const double* shift, size_t dimensionCount,
+                                 double suffixCount, bool useMax, double* suffixSum,
+                                 double* suffixSumSq, double* values) {
+    return scanMultivariateTail(row, shift, 0, dimensionCount, suffixCount, useMax, 0.0,
+                                suffixSum, suffixSumSq, values);
+}
+
+const KernelTable kScalarKernels = {
+    InstructionSet::SCALAR,
+    sumScalar,
+    sumSquaredDeviationsScalar,
+    shiftedSumsScalar,
+    batchMeansScalar,
+    scanSuffixScalar,
+    scanSuffixRangeScalar,
+    scanSuffixWeightedScalar,
+    scanMultivariateRowScalar
+};
+
+#ifdef MSER_SIMD_X86
+
+// ============================================================================
+// SSE2実装
+// ============================================================================
+
+__attribute__((target("sse2")))
+inline double horizontalSum(__m128d v) {
+    return _mm_cvtsd_f64(_mm_add_sd(v, _mm_unpackhi_pd(v, v)));
+}
+
+__attribute__((target("sse2")))
+inline double horizontalMax(__m128d v) {
+    return _mm_cvtsd_f64(_mm_max_sd(v, _mm_unpackhi_pd(v, v)));
+}
+
+__attribute__((target("sse2")))
+inline __m128d select(__m128d mask, __m128d whenTrue, __m128d whenFalse) {
+    return _mm_or_pd(_mm_and_pd(mask, whenTrue), _mm_andnot_pd(mask, whenFalse));
+}
+
+/**
+ * レーン内接尾和 [a0,a1] → [a0+a1, a1]
+ */
+__attribute__((target("sse2")))
+inline __m128d suffixScan(__m128d x) {
+    return _mm_add_pd(x, _mm_unpackhi_pd(x, _mm_setzero_pd()));
+}
+
+__attribute__((target("sse2")))
+double sumSSE2(const double* data, size_t count) {
+    __m128d acc0 = _mm_setzero_pd();
+    __m128d acc1 = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        acc0 = _mm_add_pd(acc0, _mm_loadu_pd(data + i));
+        acc1 = _mm_add_pd(acc1, _mm_loadu_pd(data + i + 2));
+    }
+    double sum = horizontalSum(_mm_add_pd(acc0, acc1));
+    for (; i < count; ++i) {
+        sum += data[i];
+    }
+    return sum;
+}
+
+__attribute__((target("sse2")))
+double sumSquaredDeviationsSSE2(const double* data, size_t count, double mean) {
+    const __m128d m = _mm_set1_pd(mean);
+    __m128d acc0 = _mm_setzero_pd();
+    __m128d acc1 = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128d d0 = _mm_sub_pd(_mm_loadu_pd(data + i), m);
+        __m128d d1 = _mm_sub_pd(_mm_loadu_pd(data + i + 2), m);
+        acc0 = _mm_add_pd(acc0, _mm_mul_pd(d0, d0));
+        acc1 = _mm_add_pd(acc1, _mm_mul_pd(d1, d1));
+    }
+    double sumSquaredDeviations = horizontalSum(_mm_add_pd(acc0, acc1));
+    for (; i < count; ++i) {
+        double deviation = data[i] - mean;
+        sumSquaredDeviations += deviation * deviation;
+    }
+    return sumSquaredDeviations;
+}
+
+__attribute__((target("sse2")))
+void batchMeansSSE2(const double* data, size_t batchCount, size_t batchSize, double* out) {
+    if (batchSize >= 16) {
+        for (size_t i = 0; i < batchCount; ++i) {
+            out[i] = sumSSE2(data + i * batchSize, batchSize) / batchSize;
+        }
+        return;
+    }
+    
+    // 2バッチを2レーンに転置して同時に集約（加算順序はスカラーと同一）
+    const __m128d divisor = _mm_set1_pd(static_cast<double>(batchSize));
+    size_t i = 0;
+    for (; i + 2 <= batchCount; i += 2) {
+        const double* batch0 = data + i * batchSize;
+        const double* batch1 = batch0 + batchSize;
+        __m128d acc = _mm_setzero_pd();
+        for (size_t j = 0; j < batchSize; ++j) {
+            acc = _mm_add_pd(acc, _mm_set_pd(batch1[j], batch0[j]));
+        }
+        _mm_storeu_pd(out + i, _mm_div_pd(acc, divisor));
+    }
+    batchMeansScalar(data + i * batchSize, batchCount - i, batchSize, out + i);
+}
+
+__attribute__((target("sse2")))
+std::pair<size_t, double> scanSuffixRangeSSE2(const double* data, size_t count, size_t beginK,
+                                              size_t endK, double shift, double* suffixSum,
+                                              double* suffixSumSq) {
+    const __m128d c = _mm_set1_pd(shift);
+    const __m128d zero = _mm_setzero_pd();
+    const __m128d laneOffset = _mm_set_pd(1.0, 0.0);
+    const __m128d total = _mm_set1_pd(static_cast<double>(count));
+    __m128d minG = _mm_set1_pd(kInfinity);
+    __m128d minK = _mm_set1_pd(static_cast<double>(beginK));
+    double runningSum = *suffixSum;
+    double runningSumSq = *suffixSumSq;
+    
+    size_t k = endK;
+    while (k >= beginK + 2) {
+        k -= 2;
+        __m128d y = _mm_sub_pd(_mm_loadu_pd(data + k), c);
+        __m128d s = _mm_add_pd(suffixScan(y), _mm_set1_pd(runningSum));
+        __m128d q = _mm_add_pd(suffixScan(_mm_mul_pd(y, y)), _mm_set1_pd(runningSumSq));
+        runningSum = _mm_cvtsd_f64(s);
+        runningSumSq = _mm_cvtsd_f64(q);
+        
+        __m128d kv = _mm_add_pd(_mm_set1_pd(static_cast<double>(k)), laneOffset);
+        __m128d m = _mm_sub_pd(total, kv);
+        __m128d ssd = _mm_max_pd(zero, _mm_sub_pd(q, _mm_div_pd(_mm_mul_pd(s, s), m)));
+        __m128d g = _mm_div_pd(ssd, _mm_mul_pd(m, m));
+        
+        __m128d le = _mm_cmple_pd(g, minG);
+        minG = select(le, g, minG);
+        minK = select(le, kv, minK);
+    }
+    
+    alignas(16) double laneMin[2];
+    alignas(16) double laneK[2];
+    _mm_store_pd(laneMin, minG);
+    _mm_store_pd(laneK, minK);
+    
+    double minMSER = kInfinity;
+    size_t optimalK = beginK;
+    reduceLanes(laneMin, laneK, 2, minMSER, optimalK);
+    
+    for (; k-- > beginK; ) {
+        double y = data[k] - shift;
+        runningSum += y;
+        runningSumSq += y * y;
+        
+        double mser = mserFromSuffix(runningSum, runningSumSq, static_cast<double>(count - k));
+        if (mser <= minMSER) {
+            minMSER = mser;
+            optimalK = k;
+        }
+    }
+    
+    *suffixSum = runningSum;
+    *suffixSumSq = runningSumSq;
+    return {optimalK, minMSER};
+}
+
+__attribute__((target("sse2")))
+std::pair<double, double> shiftedSumsSSE2(const double* data, size_t count, double shift) {
+    const __m128d c = _mm_set1_pd(shift);
+    const __m128d zero = _mm_setzero_pd();
+    
+    __m128d accSum = zero;
+    __m128d accSumSq = zero;
+    size_t j = 0;
+    for (; j + 2 <= count; j += 2) {
+        __m128d y = _mm_sub_pd(_mm_loadu_pd(data + j), c);
+        accSum = _mm_add_pd(accSum, y);
+        accSumSq = _mm_add_pd(accSumSq, _mm_mul_pd(y, y));
+    }
+    double sum = horizontalSum(accSum);
+    double sumSq = horizontalSum(accSumSq);
+    for (; j < count; ++j) {
+        double y = data[j] - shift;
+        sum += y;
+        sumSq += y * y;
+    }
+    return {sum, sumSq};
+}
+
+__attribute__((target("sse2")))
+std::pair<size_t, double> scanSuffixSSE2(const double* data, size_t count,
+                                         size_t maxK, double shift) {
+    // k ≥ maxK の部分は接尾和の累積のみ
+    auto [suffixSum, suffixSumSq] = shiftedSumsSSE2(data + maxK, count - maxK, shift);
+    return scanSuffixRangeSSE2(data, count, 0, maxK, shift, &suffixSum, &suffixSumSq);
+}
+
+__attribute__((target("sse2")))
+std::pair<size_t, double> scanSuffixWeightedSSE2(const double* data, const double* weight,
+                                                 size_t count, size_t maxK, double shift) {
+    const __m128d c = _mm_set1_pd(shift);
+    const __m128d zero = _mm_setzero_pd();
+    
+    // k ≥ maxK の部分は接尾和の累積のみ
+    __m128d tailWeight = zero;
+    __m128d tailSum = zero;
+    __m128d tailSumSq = zero;
+    size_t j = maxK;
+    for (; j + 2 <= count; j += 2) {
+        __m128d w = _mm_loadu_pd(weight + j);
+        __m128d y = _mm_sub_pd(_mm_loadu_pd(data + j), c);
+        __m128d wy = _mm_mul_pd(w, y);
+        tailWeight = _mm_add_pd(tailWeight, w);
+        tailSum = _mm_add_pd(tailSum, wy);
+        tailSumSq = _mm_add_pd(tailSumSq, _mm_mul_pd(wy, y));
+    }
+    double suffixWeight = horizontalSum(tailWeight);
+    double suffixSum = horizontalSum(tailSum);
+    double suffixSumSq = horizontalSum(tailSumSq);
+    for (; j < count; ++j) {
+        double y = data[j] - shift;
+        double wy = weight[j] * y;
+        suffixWeight += weight[j];
+        suffixSum += wy;
+        suffixSumSq += wy * y;
+    }
+    
+    const __m128d laneOffset = _mm_set_pd(1.0, 0.0);
+    const __m128d total = _mm_set1_pd(static_cast<double>(count));
+    __m128d minG = _mm_set1_pd(kInfinity);
+    __m128d minK = zero;
+    
+    size_t k = maxK;
+    while (k >= 2) {
+        k -= 2;
+        __m128d w = _mm_loadu_pd(weight + k);
+        __m128d y = _mm_sub_pd(_mm_loadu_pd(data + k), c);
+        __m128d wy = _mm_mul_pd(w, y);
+        __m128d sw = _mm_add_pd(suffixScan(w), _mm_set1_pd(suffixWeight));
+        __m128d s = _mm_add_pd(suffixScan(wy), _mm_set1_pd(suffixSum));
+        __m128d q = _mm_add_pd(suffixScan(_mm_mul_pd(wy, y)), _mm_set1_pd(suffixSumSq));
+        suffixWeight = _mm_cvtsd_f64(sw);
+        suffixSum = _mm_cvtsd_f64(s);
+        suffixSumSq = _mm_cvtsd_f64(q);
+        
+        // 重み0の接尾は 0/0 = NaN となり比較で選ばれない
+        __m128d kv = _mm_add_pd(_mm_set1_pd(static_cast<double>(k)), laneOffset);
+        __m128d ssd = _mm_max_pd(zero, _mm_sub_pd(q, _mm_div_pd(_mm_mul_pd(s, s), sw)));
+        __m128d g = _mm_div_pd(ssd, _mm_mul_pd(sw, _mm_sub_pd(total, kv)));
+        
+        __m128d le = _mm_cmple_pd(g, minG);
+        minG = select(le, g, minG);
+        minK = select(le, kv, minK);
+    }
+    
+    alignas(16) double laneMin[2];
+    alignas(16) double laneK[2];
+    _mm_store_pd(laneMin, minG);
+    _mm_store_pd(laneK, minK);
+    
+    double minMSER = kInfinity;
+    size_t optimalK = 0;
+    reduceLanes(laneMin, laneK, 2, minMSER, optimalK);
+    
+    for (; k-- > 0; ) {
+        double y = data[k] - shift;
+        double wy = weight[k] * y;
+        suffixWeight += weight[k];
+        suffixSum += wy;
+        suffixSumSq += wy * y;
+        
+        double mser = mserFromWeightedSuffix(suffixSum, suffixSumSq, suffixWeight,
+                                             static_cast<double>(count - k));
+        if (mser <= minMSER) {
+            minMSER = mser;
+            optimalK = k;
+        }
+    }
+    
+    return {optimalK, minMSER};
+}
+
+__attribute__((target("sse2")))
+double scanMultivariateRowSSE2(const double* row, const double* shift, size_t dimensionCount,
+                               double suffixCount, bool useMax, double* suffixSum,
+                               double* suffixSumSq, double* values) {
+    const __m128d zero = _mm_setzero_pd();
+    const __m128d m = _mm_set1_pd(suffixCount);
+    const __m128d mSquared = _mm_set1_pd(suffixCount * suffixCount);
+    __m128d acc = zero;
+    
+    size_t j = 0;
+    for (; j + 2 <= dimensionCount; j += 2) {
+        __m128d s = _mm_loadu_pd(suffixSum + j);
+        __m128d q = _mm_loadu_pd(suffixSumSq + j);
+        __m128d ssd = _mm_max_pd(zero, _mm_sub_pd(q, _mm_div_pd(_mm_mul_pd(s, s), m)));
+        __m128d g = _mm_div_pd(ssd, mSquared);
+        _mm_storeu_pd(values + j, g);
+        acc = useMax ? _mm_max_pd(acc, g) : _mm_add_pd(acc, g);
+        
+        __m128d y = _mm_sub_pd(_mm_loadu_pd(row + j), _mm_loadu_pd(shift + j));
+        _mm_storeu_pd(suffixSum + j, _mm_sub_pd(s, y));
+        _mm_storeu_pd(suffixSumSq + j, _mm_sub_pd(q, _mm_mul_pd(y, y)));
+    }
+    
+    double combined = useMax ? horizontalMax(acc) : horizontalSum(acc);
+    return scanMultivariateTail(row, shift, j, dimensionCount, suffixCount, useMax, combined,
+                                suffixSum, suffixSumSq, values);
+}
+
+const KernelTable kSSE2Kernels = {
+    InstructionSet::SSE2,
+    sumSSE2,
+    sumSquaredDeviationsSSE2,
+    shiftedSumsSSE2,
+    batchMeansSSE2,
+    scanSuffixSSE2,
+    scanSuffixRangeSSE2,
+    scanSuffixWeightedSSE2,
+    scanMultivariateRowSSE2
+};
+
+// ============================================================================
+// AVX2実装
+// ============================================================================
+
+__attribute__((target("avx2,fma")))
+inline double horizontalSum(__m256d v) {
+    __m128d lo = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(lo, _mm_unpackhi_pd(lo, lo)));
+}
+
+__attribute__((target("avx2,fma")))
+inline double horizontalMax(__m256d v) {
+    __m128d lo = _mm_max_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+    return _mm_cvtsd_f64(_mm_max_sd(lo, _mm_unpackhi_pd(lo, lo)));
+}
+
+/**
+ * レーン内接尾和 [a0,a1,a2,a3] → [a0+a1+a2+a3, a1+a2+a3, a2+a3, a3]
+ */
+__attribute__((target("avx2,fma")))
+inline __m256d suffixScan(__m256d x) {
+    __m256d t = _mm256_permute4x64_pd(x, _MM_SHUFFLE(3, 3, 2, 1));
+    x = _mm256_add_pd(x, _mm256_blend_pd(t, _mm256_setzero_pd(), 0x8));
+    return _mm256_add_pd(x, _mm256_permute2f128_pd(x, x, 0x81));
+}
+
+__attribute__((target("avx2,fma")))
+double sumAVX2(const double* data, size_t count) {
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    __m256d acc2 = _mm256_setzero_pd();
+    __m256d acc3 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        acc0 = _mm256_add_pd(acc0, _mm256_loadu_pd(data + i));
+        acc1 = _mm256_add_pd(acc1, _mm256_loadu_pd(data + i + 4));
+        acc2 = _mm256_add_pd(acc2, _mm256_loadu_pd(data + i + 8));
+        acc3 = _mm256_add_pd(acc3, _mm256_loadu_pd(data + i + 12));
+    }
+    for (; i + 4 <= count; i += 4) {
+        acc0 = _mm256_add_pd(acc0, _mm256_loadu_pd(data + i));
+    }
+    double sum = horizontalSum(_mm256_add_pd(_mm256_add_pd(acc0, acc1),
+                                             _mm256_add_pd(acc2, acc3)));
+    for (; i < count; ++i) {
+        sum += data[i];
+    }
+    return sum;
+}
+
+__attribute__((target("avx2,fma")))
+double sumSquaredDeviationsAVX2(const double* data, size_t count, double mean) {
+    const __m256d m = _mm256_set1_pd(mean);
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    __m256d acc2 = _mm256_setzero_pd();
+    __m256d acc3 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256d d0 = _mm256_sub_pd(_mm256_loadu_pd(data + i), m);
+        __m256d d1 = _mm256_sub_pd(_mm256_loadu_pd(data + i + 4), m);
+        __m256d d2 = _mm256_sub_pd(_mm256_loadu_pd(data + i + 8), m);
+        __m256d d3 = _mm256_sub_pd(_mm256_loadu_pd(data + i + 12), m);
+        acc0 = _mm256_fmadd_pd(d0, d0, acc0);
+        acc1 = _mm256_fmadd_pd(d1, d1, acc1);
+        acc2 = _mm256_fmadd_pd(d2, d2, acc2);
+        acc3 = _mm256_fmadd_pd(d3, d3, acc3);
+    }
+    for (; i + 4 <= count; i += 4) {
+        __m256d d0 = _mm256_sub_pd(_mm256_loadu_pd(data + i), m);
+        acc0 = _mm256_fmadd_pd(d0, d0, acc0);
+    }
+    double sumSquaredDeviations = horizontalSum(_mm256_add_pd(_mm256_add_pd(acc0, acc1),
+                                                              _mm256_add_pd(acc2, acc3)));
+    for (; i < count; ++i) {
+        double deviation = data[i] - mean;
+        sumSquaredDeviations += deviation * deviation;
+    }
+    return sumSquaredDeviations;
+}
+
+/**
+ * バッチサイズ5専用: 4バッチ（20要素）を5回のgatherで集約
+ */
+__attribute__((target("avx2,fma")))
+void batchMeans5AVX2(const double* data, size_t batchCount, double* out) {
+    const __m256i index = _mm256_set_epi64x(15, 10, 5, 0);
+    const __m256d divisor = _mm256_set1_pd(5.0);
+    size_t i = 0;
+    for (; i + 4 <= batchCount; i += 4) {
+        const double* base = data + i * 5;
+        __m256d acc = _mm256_i64gather_pd(base, index, 8);
+        acc = _mm256_add_pd(acc, _mm256_i64gather_pd(base + 1, index, 8));
+        acc = _mm256_add_pd(acc, _mm256_i64gather_pd(base + 2, index, 8));
+        acc = _mm256_add_pd(acc, _mm256_i64gather_pd(base + 3, index, 8));
+        acc = _mm256_add_pd(acc, _mm256_i64gather_pd(base + 4, index, 8));
+        _mm256_storeu_pd(out + i, _mm256_div_pd(acc, divisor));
+    }
+    batchMeansScalar(data + i * 5, batchCount - i, 5, out + i);
+}
+
+__attribute__((target("avx2,fma")))
+void batchMeansAVX2(const double* data, size_t batchCount, size_t batchSize, double* out) {
+    if (batchSize == 5) {
+        batchMeans5AVX2(data, batchCount, out);
+        return;
+    }
+    
+    if (batchSize >= 16) {
+        for (size_t i = 0; i < batchCount; ++i) {
+            out[i] = sumAVX2(data + i * batchSize, batchSize) / batchSize;
+        }
+        return;
+    }
+    
+    // 4バッチを4レーンにgatherして同時に集約（加算順序はスカラーと同一）
+    const long long stride = static_cast<long long>(batchSize);
+    const __m256i index = _mm256_set_epi64x(3 * stride, 2 * stride, stride, 0);
+    const __m256d divisor = _mm256_set1_pd(static_cast<double>(batchSize));
+    size_t i = 0;
+    for (; i + 4 <= batchCount; i += 4) {
+        const double* base = data + i * batchSize;
+        __m256d acc = _mm256_setzero_pd();
+        for (size_t j = 0; j < batchSize; ++j) {
+            acc = _mm256_add_pd(acc, _mm256_i64gather_pd(base + j, index, 8));
+        }
+        _mm256_storeu_pd(out + i, _mm256_div_pd(acc, divisor));
+    }
+    batchMeansScalar(data + i * batchSize, batchCount - i, batchSize, out + i);
+}
+
+__attribute__((target("avx2,fma")))
+std::pair<size_t, double> scanSuffixRangeAVX2(const double* data, size_t count, size_t beginK,
+                                              size_t endK, double shift, double* suffixSum,
+                                              double* suffixSumSq) {
+    const __m256d c = _mm256_set1_pd(shift);
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d laneOffset = _mm256_set_pd(3.0, 2.0, 1.0, 0.0);
+    const __m256d total = _mm256_set1_pd(static_cast<double>(count));
+    __m256d minG = _mm256_set1_pd(kInfinity);
+    __m256d minK = _mm256_set1_pd(static_cast<double>(beginK));
+    double runningSum = *suffixSum;
+    double runningSumSq = *suffixSumSq;
+    
+    size_t k = endK;
+    while (k >= beginK + 4) {
+        k -= 4;
+        __m256d y = _mm256_sub_pd(_mm256_loadu_pd(data + k), c);
+        __m256d s = _mm256_add_pd(suffixScan(y), _mm256_set1_pd(runningSum));
+        __m256d q = _mm256_add_pd(suffixScan(_mm256_mul_pd(y, y)), _mm256_set1_pd(runningSumSq));
+        runningSum = _mm256_cvtsd_f64(s);
+        runningSumSq = _mm256_cvtsd_f64(q);
+        
+        __m256d kv = _mm256_add_pd(_mm256_set1_pd(static_cast<double>(k)), laneOffset);
+        __m256d m = _mm256_sub_pd(total, kv);
+        __m256d ssd = _mm256_max_pd(zero, _mm256_sub_pd(q, _mm256_div_pd(_mm256_mul_pd(s, s), m)));
+        __m256d g = _mm256_div_pd(ssd, _mm256_mul_pd(m, m));
+        
+        __m256d le = _mm256_cmp_pd(g, minG, _CMP_LE_OQ);
+        minG = _mm256_blendv_pd(minG, g, le);
+        minK = _mm256_blendv_pd(minK, kv, le);
+    }
+    
+    alignas(32) double laneMin[4];
+    alignas(32) double laneK[4];
+    _mm256_store_pd(laneMin, minG);
+    _mm256_store_pd(laneK, minK);
+    
+    double minMSER = kInfinity;
+    size_t optimalK = beginK;
+    reduceLanes(laneMin, laneK, 4, minMSER, optimalK);
+    
+    for (; k-- > beginK; ) {
+        double y = data[k] - shift;
+        runningSum += y;
+        runningSumSq += y * y;
+        
+        double mser = mserFromSuffix(runningSum, runningSumSq, static_cast<double>(count - k));
+        if (mser <= minMSER) {
+            minMSER = mser;
+            optimalK = k;
+        }
+    }
+    
+    *suffixSum = runningSum;
+    *suffixSumSq = runningSumSq;
+    return {optimalK, minMSER};
+}
+
+__attribute__((target("avx2,fma")))
+std::pair<double, double> shiftedSumsAVX2(const double* data, size_t count, double shift) {
+    const __m256d c = _mm256_set1_pd(shift);
+    const __m256d zero = _mm256_setzero_pd();
+    
+    __m256d accSum = zero;
+    __m256d accSumSq = zero;
+    size_t j = 0;
+    for (; j + 4 <= count; j += 4) {
+        __m256d y = _mm256_sub_pd(_mm256_loadu_pd(data + j), c);
+        accSum = _mm256_add_pd(accSum, y);
+        accSumSq = _mm256_fmadd_pd(y, y, accSumSq);
+    }
+    double sum = horizontalSum(accSum);
+    double sumSq = horizontalSum(accSumSq);
+    for (; j < count; ++j) {
+        double y = data[j] - shift;
+        sum += y;
+        sumSq += y * y;
+    }
+    return {sum, sumSq};
+}
+
+__attribute__((target("avx2,fma")))
+std::pair<size_t, double> scanSuffixAVX2(const double* data, size_t count,
+                                         size_t maxK, double shift) {
+    // k ≥ maxK の部分は接尾和の累積のみ
+    auto [suffixSum, suffixSumSq] = shiftedSumsAVX2(data + maxK, count - maxK, shift);
+    return scanSuffixRangeAVX2(data, count, 0, maxK, shift, &suffixSum, &suffixSumSq);
+}
+
+__attribute__((target("avx2,fma")))
+std::pair<size_t, double> scanSuffixWeightedAVX2(const double* data, const double* weight,
+                                                 size_t count, size_t maxK, double shift) {
+    const __m256d c = _mm256_set1_pd(shift);
+    const __m256d zero = _mm256_setzero_pd();
+    
+    // k ≥ maxK の部分は接尾和の累積のみ
+    __m256d tailWeight = zero;
+    __m256d tailSum = zero;
+    __m256d tailSumSq = zero;
+    size_t j = maxK;
+    for (; j + 4 <= count; j += 4) {
+        __m256d w = _mm256_loadu_pd(weight + j);
+        __m256d y = _mm256_sub_pd(_mm256_loadu_pd(data + j), c);
+        __m256d wy = _mm256_mul_pd(w, y);
+        tailWeight = _mm256_add_pd(tailWeight, w);
+        tailSum = _mm256_add_pd(tailSum, wy);
+        tailSumSq = _mm256_fmadd_pd(wy, y, tailSumSq);
+    }
+    double suffixWeight = horizontalSum(tailWeight);
+    double suffixSum = horizontalSum(tailSum);
+    double suffixSumSq = horizontalSum(tailSumSq);
+    for (; j < count; ++j) {
+        double y = data[j] - shift;
+        double wy = weight[j] * y;
+        suffixWeight += weight[j];
+        suffixSum += wy;
+        suffixSumSq += wy * y;
+    }
+    
+    const __m256d laneOffset = _mm256_set_pd(3.0, 2.0, 1.0, 0.0);
+    const __m256d total = _mm256_set1_pd(static_cast<double>(count));
+    __m256d minG = _mm256_set1_pd(kInfinity);
+    __m256d minK = zero;
+    
+    size_t k = maxK;
+    while (k >= 4) {
+        k -= 4;
+        __m256d w = _mm256_loadu_pd(weight + k);
+        __m256d y = _mm256_sub_pd(_mm256_loadu_pd(data + k), c);
+        __m256d wy = _mm256_mul_pd(w, y);
+        __m256d sw = _mm256_add_pd(suffixScan(w), _mm256_set1_pd(suffixWeight));
+        __m256d s = _mm256_add_pd(suffixScan(wy), _mm256_set1_pd(suffixSum));
+        __m256d q = _mm256_add_pd(suffixScan(_mm256_mul_pd(wy, y)), _mm256_set1_pd(suffixSumSq));
+        suffixWeight = _mm256_cvtsd_f64(sw);
+        suffixSum = _mm256_cvtsd_f64(s);
+        suffixSumSq = _mm256_cvtsd_f64(q);
+        
+        // 重み0の接尾は 0/0 = NaN となり比較で選ばれない
+        __m256d kv = _mm256_add_pd(_mm256_set1_pd(static_cast<double>(k)), laneOffset);
+        __m256d ssd = _mm256_max_pd(zero, _mm256_sub_pd(q, _mm256_div_pd(_mm256_mul_pd(s, s), sw)));
+        __m256d g = _mm256_div_pd(ssd, _mm256_mul_pd(sw, _mm256_sub_pd(total, kv)));
+        
+        __m256d le = _mm256_cmp_pd(g, minG, _CMP_LE_OQ);
+        minG = _mm256_blendv_pd(minG, g, le);
+        minK = _mm256_blendv_pd(minK, kv, le);
+    }
+    
+    alignas(32) double laneMin[4];
+    alignas(32) double laneK[4];
+    _mm256_store_pd(laneMin, minG);
+    _mm256_store_pd(laneK, minK);
+    
+    double minMSER = kInfinity;
+    size_t optimalK = 0;
+    reduceLanes(laneMin, laneK, 4, minMSER, optimalK);
+    
+    for (; k-- > 0; ) {
+        double y = data[k] - shift;
+        double wy = weight[k] * y;
+        suffixWeight += weight[k];
+        suffixSum += wy;
+        suffixSumSq += wy * y;
+        
+        double mser = mserFromWeightedSuffix(suffixSum, suffixSumSq, suffixWeight,
+                                             static_cast<double>(count - k));
+        if (mser <= minMSER) {
+            minMSER = mser;
+            optimalK = k;
+        }
+    }
+    
+    return {optimalK, minMSER};
+}
+
+__attribute__((target("avx2,fma")))
+double scanMultivariateRowAVX2(const double* row, const double* shift, size_t dimensionCount,
+                               double suffixCount, bool useMax, double* suffixSum,
+                               double* suffixSumSq, double* values) {
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d m = _mm256_set1_pd(suffixCount);
+    const __m256d mSquared = _mm256_set1_pd(suffixCount * suffixCount);
+    __m256d acc = zero;
+    
+    size_t j = 0;
+    for (; j + 4 <= dimensionCount; j += 4) {
+        __m256d s = _mm256_loadu_pd(suffixSum + j);
+        __m256d q = _mm256_loadu_pd(suffixSumSq + j);
+        __m256d ssd = _mm256_max_pd(zero, _mm256_sub_pd(q, _mm256_div_pd(_mm256_mul_pd(s, s), m)));
+        __m256d g = _mm256_div_pd(ssd, mSquared);
+        _mm256_storeu_pd(values + j, g);
+        acc = useMax ? _mm256_max_pd(acc, g) : _mm256_add_pd(acc, g);
+        
+        // 次元ごとの値がスカラー実装と一致するよう FMA は使わない
+        __m256d y = _mm256_sub_pd(_mm256_loadu_pd(row + j), _mm256_loadu_pd(shift + j));
+        _mm256_storeu_pd(suffixSum + j, _mm256_sub_pd(s, y));
+        _mm256_storeu_pd(suffixSumSq + j, _mm256_sub_pd(q, _mm256_mul_pd(y, y)));
+    }
+    
+    double combined = useMax ? horizontalMax(acc) : horizontalSum(acc);
+    return scanMultivariateTail(row, shift, j, dimensionCount, suffixCount, useMax, combined,
+                                suffixSum, suffixSumSq, values);
+}
+
+const KernelTable kAVX2Kernels = {
+    InstructionSet::AVX2,
+    sumAVX2,
+    sumSquaredDeviationsAVX2,
+    shiftedSumsAVX2,
+    batchMeansAVX2,
+    scanSuffixAVX2,
+    scanSuffixRangeAVX2,
+    scanSuffixWeightedAVX2,
+    scanMultivariateRowAVX2
+};
+
+// ============================================================================
+// AVX-512実装
+// ============================================================================
+
+// GCC 12 の avx512fintrin.h 内部（_mm512_undefined_pd）に対する誤検知を抑制
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+/**
+ * レーン内接尾和（8レーン、log₂8=3段のシフト加算）
+ */
+__attribute__((target("avx512f")))
+inline __m512d suffixScan(__m512d x) {
+    const __m512i shift1 = _mm512_set_epi64(7, 7, 6, 5, 4, 3, 2, 1);
+    const __m512i shift2 = _mm512_set_epi64(7, 7, 7, 6, 5, 4, 3, 2);
+    const __m512i shift4 = _mm512_set_epi64(7, 7, 7, 7, 7, 6, 5, 4);
+    x = _mm512_add_pd(x, _mm512_maskz_permutexvar_pd(0x7F, shift1, x));
+    x = _mm512_add_pd(x, _mm512_maskz_permutexvar_pd(0x3F, shift2, x));
+    return _mm512_add_pd(x, _mm512_maskz_permutexvar_pd(0x0F, shift4, x));
+}
+
+__attribute__((target("avx512f")))
+double sumAVX512(const double* data, size_t count) {
+    __m512d acc0 = _mm512_setzero_pd();
+    __m512d acc1 = _mm512_setzero_pd();
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        acc0 = _mm512_add_pd(acc0, _mm512_loadu_pd(data + i));
+        acc1 = _mm512_add_pd(acc1, _mm512_loadu_pd(data + i + 8));
+    }
+    for (; i + 8 <= count; i += 8) {
+        acc0 = _mm512_add_pd(acc0, _mm512_loadu_pd(data + i));
+    }
+    double sum = _mm512_reduce_add_pd(_mm512_add_pd(acc0, acc1));
+    for (; i < count; ++i) {
+        sum += data[i];
+    }
+    return sum;
+}
+
+__attribute__((target("avx512f")))
+double sumSquaredDeviationsAVX512(const double* data, size_t count, double mean) {
+    const __m512d m = _mm512_set1_pd(mean);
+    __m512d acc0 = _mm512_setzero_pd();
+    __m512d acc1 = _mm512_setzero_pd();
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m512d d0 = _mm512_sub_pd(_mm512_loadu_pd(data + i), m);
+        __m512d d1 = _mm512_sub_pd(_mm512_loadu_pd(data + i + 8), m);
+        acc0 = _mm512_fmadd_pd(d0, d0, acc0);
+        acc1 = _mm512_fmadd_pd(d1, d1, acc1);
+    }
+    for (; i + 8 <= count; i += 8) {
+        __m512d d0 = _mm512_sub_pd(_mm512_loadu_pd(data + i), m);
+        acc0 = _mm512_fmadd_pd(d0, d0, acc0);
+    }
+    double sumSquaredDeviations = _mm512_reduce_add_pd(_mm512_add_pd(acc0, acc1));
+    for (; i < count; ++i) {
+        double deviation = data[i] - mean;
+        sumSquaredDeviations += deviation * deviation;
+    }
+    return sumSquaredDeviations;
+}
+
+__attribute__((target("avx512f")))
+void batchMeansAVX512(const double* data, size_t batchCount, size_t batchSize, double* out) {
+    if (batchSize >= 16) {
+        for (size_t i = 0; i < batchCount; ++i) {
+            out[i] = sumAVX512(data + i * batchSize, batchSize) / batchSize;
+        }
+        return;
+    }
+    
+    // 8バッチを8レーンにgatherして同時に集約（加算順序はスカラーと同一）
+    const long long stride = static_cast<long long>(batchSize);
+    const __m512i index = _mm512_set_epi64(7 * stride, 6 * stride, 5 * stride, 4 * stride,
+                                           3 * stride, 2 * stride, stride, 0);
+    const __m512d divisor = _mm512_set1_pd(static_cast<double>(batchSize));
+    size_t i = 0;
+    for (; i + 8 <= batchCount; i += 8) {
+        const double* base = data + i * batchSize;
+        __m512d acc = _mm512_setzero_pd();
+        for (size_t j = 0; j < batchSize; ++j) {
+            acc = _mm512_add_pd(acc, _mm512_i64gather_pd(index, base + j, 8));
+        }
+        _mm512_storeu_pd(out + i, _mm512_div_pd(acc, divisor));
+    }
+    batchMeansScalar(data + i * batchSize, batchCount - i, batchSize, out + i);
+}
+
+__attribute__((target("avx512f")))
+std::pair<size_t, double> scanSuffixRangeAVX512(const double* data, size_t count, size_t beginK,
+                                                size_t endK, double shift, double* suffixSum,
+                                                double* suffixSumSq) {
+    const __m512d c = _mm512_set1_pd(shift);
+    const __m512d zero = _mm512_setzero_pd();
+    const __m512d laneOffset = _mm512_set_pd(7.0, 6.0, 5.0, 4.0, 3.0, 2.0, 1.0, 0.0);
+    const __m512d total = _mm512_set1_pd(static_cast<double>(count));
+    __m512d minG = _mm512_set1_pd(kInfinity);
+    __m512d minK = _mm512_set1_pd(static_cast<double>(beginK));
+    double runningSum = *suffixSum;
+    double runningSumSq = *suffixSumSq;
+    
+    size_t k = endK;
+    while (k >= beginK + 8) {
+        k -= 8;
+        __m512d y = _mm512_sub_pd(_mm512_loadu_pd(data + k), c);
+        __m512d s = _mm512_add_pd(suffixScan(y), _mm512_set1_pd(runningSum));
+        __m512d q = _mm512_add_pd(suffixScan(_mm512_mul_pd(y, y)), _mm512_set1_pd(runningSumSq));
+        runningSum = _mm512_cvtsd_f64(s);
+        runningSumSq = _mm512_cvtsd_f64(q);
+        
+        __m512d kv = _mm512_add_pd(_mm512_set1_pd(static_cast<double>(k)), laneOffset);
+        __m512d m = _mm512_sub_pd(total, kv);
+        __m512d ssd = _mm512_max_pd(zero, _mm512_sub_pd(q, _mm512_div_pd(_mm512_mul_pd(s, s), m)));
+        __m512d g = _mm512_div_pd(ssd, _mm512_mul_pd(m, m));
+        
+        __mmask8 le = _mm512_cmp_pd_mask(g, minG, _CMP_LE_OQ);
+        minG = _mm512_mask_blend_pd(le, minG, g);
+        minK = _mm512_mask_blend_pd(le, minK, kv);
+    }
+    
+    alignas(64) double laneMin[8];
+    alignas(64) double laneK[8];
+    _mm512_store_pd(laneMin, minG);
+    _mm512_store_pd(laneK, minK);
+    
+    double minMSER = kInfinity;
+    size_t optimalK = beginK;
+    reduceLanes(laneMin, laneK, 8, minMSER, optimalK);
+    
+    for (; k-- > beginK; ) {
+        double y = data[k] - shift;
+        runningSum += y;
+        runningSumSq += y * y;
+        
+        double mser = mserFromSuffix(runningSum, runningSumSq, static_cast<double>(count - k));
+        if (mser <= minMSER) {
+            minMSER = mser;
+            optimalK = k;
+        }
+    }
+    
+    *suffixSum = runningSum;
+    *suffixSumSq = runningSumSq;
+    return {optimalK, minMSER};
+}
+
+__attribute__((target("avx512f")))
+std::pair<double, double> shiftedSumsAVX512(const double* data, size_t count, double shift) {
+    const __m512d c = _mm512_set1_pd(shift);
+    const __m512d zero = _mm512_setzero_pd();
+    
+    __m512d accSum = zero;
+    __m512d accSumSq = zero;
+    size_t j = 0;
+    for (; j + 8 <= count; j += 8) {
+        __m512d y = _mm512_sub_pd(_mm512_loadu_pd(data + j), c);
+        accSum = _mm512_add_pd(accSum, y);
+        accSumSq = _mm512_fmadd_pd(y, y, accSumSq);
+    }
+    double sum = _mm512_reduce_add_pd(accSum);
+    double sumSq = _mm512_reduce_add_pd(accSumSq);
+    for (; j < count; ++j) {
+        double y = data[j] - shift;
+        sum += y;
+        sumSq += y * y;
+    }
+    return {sum, sumSq};
+}
+
+__attribute__((target("avx512f")))
+std::pair<size_t, double> scanSuffixAVX512(const double* data, size_t count,
+                                           size_t maxK, double shift) {
+    // k ≥ maxK の部分は接尾和の累積のみ
+    auto [suffixSum, suffixSumSq] = shiftedSumsAVX512(data + maxK, count - maxK, shift);
+    return scanSuffixRangeAVX512(data, count, 0, maxK, shift, &suffixSum, &suffixSumSq);
+}
+
+__attribute__((target("avx512f")))
+std::pair<size_t, double> scanSuffixWeightedAVX512(const double* data, const double* weight,
+                                                   size_t count, size_t maxK, double shift) {
+    const __m512d c = _mm512_set1_pd(shift);
+    const __m512d zero = _mm512_setzero_pd();
+    
+    // k ≥ maxK の部分は接尾和の累積のみ
+    __m512d tailWeight = zero;
+    __m512d tailSum = zero;
+    __m512d tailSumSq = zero;
+    size_t j = maxK;
+    for (; j + 8 <= count; j += 8) {
+        __m512d w = _mm512_loadu_pd(weight + j);
+        __m512d y = _mm512_sub_pd(_mm512_loadu_pd(data + j), c);
+        __m512d wy = _mm512_mul_pd(w, y);
+        tailWeight = _mm512_add_pd(tailWeight, w);
+        tailSum = _mm512_add_pd(tailSum, wy);
+        tailSumSq = _mm512_fmadd_pd(wy, y, tailSumSq);
+    }
+    double suffixWeight = _mm512_reduce_add_pd(tailWeight);
+    double suffixSum = _mm512_reduce_add_pd(tailSum);
+    double suffixSumSq = _mm512_reduce_add_pd(tailSumSq);
+    for (; j < count; ++j) {
+        double y = data[j] - shift;
+        double wy = weight[j] * y;
+        suffixWeight += weight[j];
+        suffixSum += wy;
+        suffixSumSq += wy * y;
+    }
+    
+    const __m512d laneOffset = _mm512_set_pd(7.0, 6.0, 5.0, 4.0, 3.0, 2.0, 1.0, 0.0);
+    const __m512d total = _mm512_set1_pd(static_cast<double>(count));
+    __m512d minG = _mm512_set1_pd(kInfinity);
+    __m512d minK = zero;
+    
+    size_t k = maxK;
+    while (k >= 8) {
+        k -= 8;
+        __m512d w = _mm512_loadu_pd(weight + k);
+        __m512d y = _mm512_sub_pd(_mm512_loadu_pd(data + k), c);
+        __m512d wy = _mm512_mul_pd(w, y);
+        __m512d sw = _mm512_add_pd(suffixScan(w), _mm512_set1_pd(suffixWeight));
+        __m512d s = _mm512_add_pd(suffixScan(wy), _mm512_set1_pd(suffixSum));
+        __m512d q = _mm512_add_pd(suffixScan(_mm512_mul_pd(wy, y)), _mm512_set1_pd(suffixSumSq));
+        suffixWeight = _mm512_cvtsd_f64(sw);
+        suffixSum = _mm512_cvtsd_f64(s);
+        suffixSumSq = _mm512_cvtsd_f64(q);
+        
+        // 重み0の接尾は 0/0 = NaN となり比較で選ばれない
+        __m512d kv = _mm512_add_pd(_mm512_set1_pd(static_cast<double>(k)), laneOffset);
+        __m512d ssd = _mm512_max_pd(zero, _mm512_sub_pd(q, _mm512_div_pd(_mm512_mul_pd(s, s), sw)));
+        __m512d g = _mm512_div_pd(ssd, _mm512_mul_pd(sw, _mm512_sub_pd(total, kv)));
+        
+        __mmask8 le = _mm512_cmp_pd_mask(g, minG, _CMP_LE_OQ);
+        minG = _mm512_mask_blend_pd(le, minG, g);
+        minK = _mm512_mask_blend_pd(le, minK, kv);
+    }
+    
+    alignas(64) double laneMin[8];
+    alignas(64) double laneK[8];
+    _mm512_store_pd(laneMin, minG);
+    _mm512_store_pd(laneK, minK);
+    
+    double minMSER = kInfinity;
+    size_t optimalK = 0;
+    reduceLanes(laneMin, laneK, 8, minMSER, optimalK);
+    
+    for (; k-- > 0; ) {
+        double y = data[k] - shift;
+        double wy = weight[k] * y;
+        suffixWeight += weight[k];
+        suffixSum += wy;
+        suffixSumSq += wy * y;
+        
+        double mser = mserFromWeightedSuffix(suffixSum, suffixSumSq, suffixWeight,
+                                             static_cast<double>(count - k));
+        if (mser <= minMSER) {
+            minMSER = mser;
+            optimalK = k;
+        }
+    }
+    
+    return {optimalK, minMSER};
+}
+
+__attribute__((target("avx512f")))
+double scanMultivariateRowAVX512(const double* row, const double* shift, size_t dimensionCount,
+                                 double suffixCount, bool useMax, double* suffixSum,
+                                 double* suffixSumSq, double* values) {
+    const __m512d zero = _mm512_setzero_pd();
+    const __m512d m = _mm512_set1_pd(suffixCount);
+    const __m512d mSquared = _mm512_set1_pd(suffixCount * suffixCount);
+    __m512d acc = zero;
+    
+    size_t j = 0;
+    for (; j + 8 <= dimensionCount; j += 8) {
+        __m512d s = _mm512_loadu_pd(suffixSum + j);
+        __m512d q = _mm512_loadu_pd(suffixSumSq + j);
+        __m512d ssd = _mm512_max_pd(zero, _mm512_sub_pd(q, _mm512_div_pd(_mm512_mul_pd(s, s), m)));
+        __m512d g = _mm512_div_pd(ssd, mSquared);
+        _mm512_storeu_pd(values + j, g);
+        acc = useMax ? _mm512_max_pd(acc, g) : _mm512_add_pd(acc, g);
+        
+        __m512d y = _mm512_sub_pd(_mm512_loadu_pd(row + j), _mm512_loadu_pd(shift + j));
+        _mm512_storeu_pd(suffixSum + j, _mm512_sub_pd(s, y));
+        _mm512_storeu_pd(suffixSumSq + j, _mm512_sub_pd(q, _mm512_mul_pd(y, y)));
+    }
+    
+    double combined = useMax ? _mm512_reduce_max_pd(acc) : _mm512_reduce_add_pd(acc);
+    return scanMultivariateTail(row, shift, j, dimensionCount, suffixCount, useMax, combined,
+                                suffixSum, suffixSumSq, values);
+}
+
+const KernelTable kAVX512Kernels = {
+    InstructionSet::AVX512,
+    sumAVX512,
+    sumSquaredDeviationsAVX512,
+    shiftedSumsAVX512,
+    batchMeansAVX512,
+    scanSuffixAVX512,
+    scanSuffixRangeAVX512,
+    scanSuffixWeightedAVX512,
+    scanMultivariateRowAVX512
+};
+
+#pragma GCC diagnostic pop
+
+#endif // MSER_SIMD_X86
+
+// ============================================================================
+// 実行時選択
+// ============================================================================
+
+std::atomic<const KernelTable*> activeKernels{nullptr};
+
+const KernelTable* kernelsFor(InstructionSet isa) {
+    switch (isa) {
+#ifdef MSER_SIMD_X86
+        case InstructionSet::AVX512:
+            return &kAVX512Kernels;
+        case InstructionSet::AVX2:
+            return &kAVX2Kernels;
+        case InstructionSet::SSE2:
+            return &kSSE2Kernels;
+#endif
+        case InstructionSet::SCALAR:
+        default:
+            return &kScalarKernels;
+    }
+}
+
+const KernelTable* kernels() {
+    const KernelTable* table = activeKernels.load(std::memory_order_acquire);
+    if (!table) {
+        table = kernelsFor(detectInstructionSet());
+        activeKernels.store(table, std::memory_order_release);
+    }
+    return table;
+}
+
+/**
+ * 検証用の決定的な擬似乱数列（指数的過渡 + オフセット + ノイズ）
+ */
+std::vector<double> makeValidationData(size_t count) {
+    std::vector<double> data(count);
+    unsigned long long state = 0x9E3779B97F4A7C15ULL;
+    for (size_t i = 0; i < count; ++i) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        double noise = static_cast<double>(state >> 11) / 9007199254740992.0 - 0.5;
+        data[i] = 1000.0 + 25.0 * std::exp(-static_cast<double>(i) / (count / 8.0 + 1.0)) + noise;
+    }
+    return data;
+}
+
+bool withinTolerance(double actual, double expected, double scale, double tolerance) {
+    return std::fabs(actual - expected) <= tolerance * std::max(scale, std::fabs(expected));
+}
+
+} // namespace
+
+// ============================================================================
+// 命令セット選択機能の実装
+// ============================================================================
+
+InstructionSet detectInstructionSet() {
+#ifdef MSER_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return InstructionSet::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return InstructionSet::AVX2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return InstructionSet::SSE2;
+    }
+#endif
+    return InstructionSet::SCALAR;
+}
+
+InstructionSet getInstructionSet() {
+    return kernels()->isa;
+}
+
+InstructionSet setInstructionSet(InstructionSet isa) {
+    InstructionSet supported = detectInstructionSet();
+    if (static_cast<int>(isa) > static_cast<int>(supported)) {
+        isa = supported;
+    }
+    
+    const KernelTable* table = kernelsFor(isa);
+    activeKernels.store(table, std::memory_order_release);
+    return table->isa;
+}
+
+const char* toString(InstructionSet isa) {
+    switch (isa) {
+        case InstructionSet::SSE2: return "SSE2";
+        case InstructionSet::AVX2: return "AVX2";
+        case InstructionSet::AVX512: return "AVX-512";
+        case InstructionSet::SCALAR:
+        default: return "scalar";
+    }
+}
+
+bool validateAgainstScalar(size_t sampleCount, double tolerance) {
+    const KernelTable& reference = kScalarKernels;
+    const KernelTable& active = *kernels();
+    
+    std::vector<double> data = makeValidationData(std::max<size_t>(sampleCount, 64));
+    const double* x = data.data();
+    size_t n = data.size();
+    
+    double absSum = 0.0;
+    for (double value : data) {
+        absSum += std::fabs(value);
+    }
+    
+    // 総和・平方偏差和
+    double expectedSum = reference.sum(x, n);
+    if (!withinTolerance(active.sum(x, n), expectedSum, absSum, tolerance)) {
+        return false;
+    }
+    
+    double mean = expectedSum / n;
+    if (!withinTolerance(active.sumSquaredDeviations(x, n, mean),
+                         reference.sumSquaredDeviations(x, n, mean), 0.0, tolerance)) {
+        return false;
+    }
+    
+    // シフト済み和・二乗和（端数レーンを含む長さ）
+    for (size_t length : {n, n - 3}) {
+        auto expectedShifted = reference.shiftedSums(x, length, mean);
+        auto actualShifted = active.shiftedSums(x, length, mean);
+        if (!withinTolerance(actualShifted.first, expectedShifted.first, absSum, tolerance) ||
+            !withinTolerance(actualShifted.second, expectedShifted.second, 0.0, tolerance)) {
+            return false;
+        }
+    }
+    
+    // バッチ平均（gather経路と連続加算経路の両方）
+    for (size_t batchSize : {2, 3, 5, 7, 10, 16, 32}) {
+        size_t batchCount = n / batchSize;
+        std::vector<double> expected(batchCount);
+        std::vector<double> actual(batchCount);
+        reference.batchMeans(x, batchCount, batchSize, expected.data());
+        active.batchMeans(x, batchCount, batchSize, actual.data());
+        for (size_t i = 0; i < batchCount; ++i) {
+            if (!withinTolerance(actual[i], expected[i], 0.0, tolerance)) {
+                return false;
+            }
+        }
+    }
+    
+    // 接尾和走査（切り捨て点は一致し、MSER値は許容誤差内であること）
+    auto expectedSuffix = reference.scanSuffix(x, n, n / 2, mean);
+    auto actualSuffix = active.scanSuffix(x, n, n / 2, mean);
+    if (actualSuffix.first != expectedSuffix.first ||
+        !withinTolerance(actualSuffix.second, expectedSuffix.second, 0.0, tolerance)) {
+        return false;
+    }
+    
+    // 接尾和の区間走査（端数レーンを含む区間を後方から順に、累積状態を引き継ぐ）
+    double expectedRangeSum = 0.0;
+    double expectedRangeSumSq = 0.0;
+    double actualRangeSum = 0.0;
+    double actualRangeSumSq = 0.0;
+    for (size_t endK = n; endK > 0; ) {
+        size_t beginK = endK > 13 ? endK - 13 : 0;
+        auto expectedRange = reference.scanSuffixRange(x, n, beginK, endK, mean,
+                                                       &expectedRangeSum, &expectedRangeSumSq);
+        auto actualRange = active.scanSuffixRange(x, n, beginK, endK, mean,
+                                                  &actualRangeSum, &actualRangeSumSq);
+        if (actualRange.first != expectedRange.first ||
+            !withinTolerance(actualRange.second, expectedRange.second, 0.0, tolerance) ||
+            !withinTolerance(actualRangeSumSq, expectedRangeSumSq, 0.0, tolerance)) {
+            return false;
+        }
+        endK = beginK;
+    }
+    
+    // 重み付き接尾和走査（重みは 0.5〜1.5 の決定的な系列）
+    std::vector<double> weight(n);
+    for (size_t i = 0; i < n; ++i) {
+        weight[i] = 1.0 + 0.5 * std::sin(static_cast<double>(i));
+    }
+    auto expectedWeighted = reference.scanSuffixWeighted(x, weight.data(), n, n / 2, mean);
+    auto actualWeighted = active.scanSuffixWeighted(x, weight.data(), n, n / 2, mean);
+    if (actualWeighted.first != expectedWeighted.first ||
+        !withinTolerance(actualWeighted.second, expectedWeighted.second, 0.0, tolerance)) {
+        return false;
+    }
+    
+    // 多変量接尾走査（端数次元を含む次元数、系列を次元ごとにずらした行）
+    const size_t dimensionCount = 11;
+    size_t rowCount = n / dimensionCount;
+    std::vector<double> shift(x, x + dimensionCount);
+    std::vector<double> expectedRowSum(dimensionCount, 0.0);
+    std::vector<double> expectedRowSumSq(dimensionCount, 0.0);
+    for (size_t i = 0; i < rowCount; ++i) {
+        for (size_t j = 0; j < dimensionCount; ++j) {
+            double y = x[i * dimensionCount + j] - shift[j];
+            expectedRowSum[j] += y;
+            expectedRowSumSq[j] += y * y;
+        }
+    }
+    std::vector<double> actualRowSum = expectedRowSum;
+    std::vector<double> actualRowSumSq = expectedRowSumSq;
+    std::vector<double> expectedValues(dimensionCount);
+    std::vector<double> actualValues(dimensionCount);
+    std::pair<size_t, double> expectedBest(0, kInfinity);
+    std::pair<size_t, double> actualBest(0, kInfinity);
+    for (size_t i = 0; i < rowCount / 2; ++i) {
+        const double* row = x + i * dimensionCount;
+        auto suffixCount = static_cast<double>(rowCount - i);
+        bool useMax = (i % 2 != 0);
+        double expected = reference.scanMultivariateRow(row, shift.data(), dimensionCount,
+                                                        suffixCount, useMax, expectedRowSum.data(),
+                                                        expectedRowSumSq.data(), expectedValues.data());
+        double actual = active.scanMultivariateRow(row, shift.data(), dimensionCount,
+                                                   suffixCount, useMax, actualRowSum.data(),
+                                                   actualRowSumSq.data(), actualValues.data());
+        if (!withinTolerance(actual, expected, 0.0, tolerance)) {
+            return false;
+        }
+        for (size_t j = 0; j < dimensionCount; ++j) {
+            if (!withinTolerance(actualValues[j], expectedValues[j], 0.0, tolerance)) {
+                return false;
+            }
+        }
+        if (expected < expectedBest.second) {
+            expectedBest = {i, expected};
+        }
+        if (actual < actualBest.second) {
+            actualBest = {i, actual};
+        }
+    }
+    if (actualBest.first != expectedBest.first) {
+        return false;
+    }
+    
+    return true;
+}
+
+// ============================================================================
+// 計算カーネルの実装
+// ============================================================================
+
+double sum(const double* data, size_t count) {
+    return kernels()->sum(data, count);
+}
+
+double sumSquaredDeviations(const double* data, size_t count, double mean) {
+    return kernels()->sumSquaredDeviations(data, count, mean);
+}
+
+std::pair<double, double> shiftedSums(const double* data, size_t count, double shift) {
+    return kernels()->shiftedSums(data, count, shift);
+}
+
+void batchMeans(const double* data, size_t batchCount, size_t batchSize, double* out) {
+    if (batchSize == 0) {
+        return;
+    }
+    kernels()->batchMeans(data, batchCount, batchSize, out);
+}
+
+std::pair<size_t, double> scanSuffix(const double* data, size_t count,
+                                     size_t maxK, double shift) {
+    if (maxK == 0 || maxK > count) {
+        return {0, kInfinity};
+    }
+    return kernels()->scanSuffix(data, count, maxK, shift);
+}
+
+std::pair<size_t, double> scanSuffixRange(const double* data, size_t count, size_t beginK,
+                                          size_t endK, double shift, double* suffixSum,
+                                          double* suffixSumSq) {
+    if (beginK >= endK || endK > count) {
+        return {beginK, kInfinity};
+    }
+    return kernels()->scanSuffixRange(data, count, beginK, endK, shift, suffixSum, suffixSumSq);
+}
+
+std::pair<size_t, double> scanSuffixWeighted(const double* data, const double* weight,
+                                             size_t count, size_t maxK, double shift) {
+    if (maxK == 0 || maxK > count) {
+        return {0, kInfinity};
+    }
+    return kernels()->scanSuffixWeighted(data, weight, count, maxK, shift);
+}
+
+double scanMultivariateRow(const double* row, const double* shift, size_t dimensionCount,
+                           double suffixCount, bool useMax, double* suffixSum,
+                           double* suffixSumSq, double* values) {
+    return kernels()->scanMultivariateRow(row, shift, dimensionCount, suffixCount, useMax,
+                                          suffixSum, suffixSumSq, values);
+}
+
+} // namespace simd
+} // namespace mser
@@ -1,13 +1,49 @@
 #include "mser/steady_state_detector.h"
-#include <iostream>
 #include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <utility>
 
 namespace mser {
 
+namespace {
+
+constexpr size_t kSliceTimeCheckPositions = 256;   // NANOSECONDS 予算時に時刻を確認する走査位置数の間隔
+
+} // namespace
+
 SteadyStateDetector::SteadyStateDetector(const SteadyStateConfig& config)
-    : config_(config), converged_(false), lastCheckIndex_(0) {
+    : config_(config), converged_(false), lastCheckIndex_(0), nonFiniteCount_(0),
+      rejectedCount_(0), lastFiniteValue_(0.0), hasFiniteValue_(false),
+      incremental_(IncrementalMSER::batchSizeFor(config)),
+      timeWeighted_(IncrementalMSER::batchSizeFor(config)),
+      eventDispatcher_(nullptr), eventSource_(nullptr) {
     mserCalculator_ = std::make_unique<MSER>();
-    data_.reserve(config_.maxSamples);
+    mserCalculator_->sequential_ = true;  // 収束チェックは作業領域内の逐次計算（スレッド・チャンク分割なし）
+    
+    if (config_.enableStreaming) {
+        // 生データは保持しない
+        if (usesTimeWeighting()) {
+            timeWeighted_.setBatchLimit(config_.streamingBudget);
+        } else {
+            incremental_.setBatchLimit(config_.streamingBudget);
+        }
+    } else {
+        if (usesFloatStorage()) {
+            dataF32_.reserve(config_.maxSamples);
+        } else {
+            data_.reserve(config_.maxSamples);
+        }
+        
+        if (usesTimeWeighting()) {
+            timestamps_.reserve(config_.maxSamples);
+            timeWeighted_.reserve(config_.maxSamples / timeWeighted_.getBatchSize());
+        } else if (usesIncrementalState()) {
+            incremental_.reserve(config_.maxSamples / incremental_.getBatchSize());
+        }
+    }
+    
+    reserveWorkspace();
 }
 
 SteadyStateDetector::~SteadyStateDetector() {
@@ -18,22 +54,83 @@ SteadyStateDetector::~SteadyStateDetector() {
 // ============================================================================
 
 bool SteadyStateDetector::addDataPoint(TimeSeriesValue value) {
+    // 時間重み付き時は直前の観測から単位時間後の観測とみなす
+    double timestamp = 0.0;
+    if (usesTimeWeighting() && getCurrentSampleCount() > 0) {
+        timestamp = timeWeighted_.getLastTimestamp() + 1.0;
+    }
+    return addSample(value, timestamp);
+}
+
+bool SteadyStateDetector::addDataPoint(TimeSeriesValue value, double timestamp) {
+    return addSample(value, timestamp);
+}
+
+bool SteadyStateDetector::addSample(TimeSeriesValue value, double timestamp) {
     if (converged_) {
         return true;  // 既に収束済み
     }
     
-    data_.push_back(value);
+    // 時刻が非有限・逆行する観測は保持時間を定義できないため破棄
+    if (usesTimeWeighting() &&
+        (!std::isfinite(timestamp) ||
+         (getCurrentSampleCount() > 0 && timestamp < timeWeighted_.getLastTimestamp()))) {
+        ++nonFiniteCount_;
+        return false;
+    }
+    
+    // 取り込み時の検証（チェックごとの全走査は行わない）
+    if (!admitValue(value)) {
+        return false;
+    }
+    
+    if (getCurrentSampleCount() == 0) {
+        startTime_ = std::chrono::steady_clock::now();
+    }
     
+    // ストリーミングモードは固定メモリで無期限に継続
+    if (config_.enableStreaming) {
+        statistics_.add(value);
+        if (usesTimeWeighting()) {
+            timeWeighted_.addValue(value, timestamp);
+        } else {
+            incremental_.addValue(value);
+        }
+#ifdef MSER_ENABLE_METRICS
+        recordSample();
+#endif
+        return (scan_.isPending() || shouldPerformCheck()) ? checkConvergence() : false;
+    }
+    
+    if (usesFloatStorage()) {
+        dataF32_.push_back(static_cast<float>(value));
+        value = dataF32_.back();  // 全再計算経路と同じ丸め済みの値を使用
+    } else {
+        data_.push_back(value);
+    }
+    statistics_.add(value);
+    
+    if (usesTimeWeighting()) {
+        timestamps_.push_back(timestamp);
+        timeWeighted_.addValue(value, timestamp);
+    } else if (usesIncrementalState()) {
+        incremental_.addValue(value);
+    }
+
+#ifdef MSER_ENABLE_METRICS
+    recordSample();
+#endif
+
     // 最大サンプル数制限
-    if (data_.size() > config_.maxSamples) {
+    if (getCurrentSampleCount() > config_.maxSamples) {
         converged_ = true;
         lastResult_.converged = false;
-        triggerCallback(lastResult_);
+        triggerCallback(lastResult_, DetectorEventType::MAX_SAMPLES_REACHED);
         return false;
     }
     
-    // 検査タイミングかどうかチェック
-    if (shouldPerformCheck()) {
+    // 分割実行中のチェックの継続、または検査タイミングかどうかチェック
+    if (scan_.isPending() || shouldPerformCheck()) {
         return checkConvergence();
     }
     
@@ -54,36 +151,74 @@ bool SteadyStateDetector::checkConvergence() {
         return true;
     }
     
+    // 分割実行中のチェックは次のスライスを実行
+    if (scan_.isPending()) {
+        return continueSlicedCheck();
+    }
+    
     // ウォーミングアップ期間のチェック
     if (isInWarmingPeriod()) {
+#ifdef MSER_ENABLE_METRICS
+        ++metrics_.checksSkippedWarming;
+#endif
         return false;
     }
     
     // 最小サンプル数のチェック
-    if (data_.size() < config_.minSamples) {
+    if (getCurrentSampleCount() < config_.minSamples) {
+#ifdef MSER_ENABLE_METRICS
+        ++metrics_.checksSkippedMinSamples;
+#endif
         return false;
     }
     
-    // MSER計算実行
-    lastResult_ = mserCalculator_->calculate(data_, config_);
-    lastCheckIndex_ = data_.size();
+    // 走査を開始し、最初のスライスを実行（完了時点でチェック1回として記録）
+    if (rejectedCount_ == 0 && usesSlicedCheck()) {
+        scan_.begin(incremental_, config_.variant);
+        return continueSlicedCheck();
+    }
     
-    // 収束判定
-    bool newlyConverged = evaluateConvergence(lastResult_);
+    auto start = std::chrono::steady_clock::now();
     
-    if (newlyConverged && !converged_) {
-        converged_ = true;
-        triggerCallback(lastResult_);
+    // 蓄積データは取り込み時に検証済みのため、計算時のNaN/Inf走査は省略する
+    SteadyStateConfig checkConfig = config_;
+    checkConfig.preValidated = true;
+    
+    // MSER計算実行（インクリメンタル時は新規バッチ分のみ更新済みで走査のみ）
+    if (rejectedCount_ > 0) {
+        lastResult_ = MSERResult();  // 非有限値を含む（REJECT）ため計算せず未収束
+        lastResult_.variant = config_.variant;
+        lastResult_.totalSamples = getCurrentSampleCount();
+    } else if (usesTimeWeighting()) {
+        lastResult_ = timeWeighted_.evaluate(config_.variant);
+    } else if (usesIncrementalState()) {
+        lastResult_ = incremental_.evaluate(config_.variant);
+    } else if (usesFloatStorage()) {
+        lastResult_ = mserCalculator_->calculate(dataF32_, checkConfig, workspace_);
+    } else {
+        lastResult_ = mserCalculator_->calculate(data_, checkConfig, workspace_);
     }
     
-    return converged_;
+    recordCheckElapsed(start);
+    return completeCheck(getCurrentSampleCount());
 }
 
 void SteadyStateDetector::reset() {
     data_.clear();
+    dataF32_.clear();
+    incremental_.reset();
+    timeWeighted_.reset();
+    timestamps_.clear();
+    statistics_.reset();
+    scan_.cancel();
     converged_ = false;
     lastCheckIndex_ = 0;
     lastResult_ = MSERResult();
+    schedule_ = ScheduleStatistics();
+    nonFiniteCount_ = 0;
+    rejectedCount_ = 0;
+    lastFiniteValue_ = 0.0;
+    hasFiniteValue_ = false;
 }
 
 // ============================================================================
@@ -91,9 +226,23 @@ void SteadyStateDetector::reset() {
 // ============================================================================
 
 size_t SteadyStateDetector::getCurrentSampleCount() const {
+    if (config_.enableStreaming) {
+        return usesTimeWeighting() ? timeWeighted_.getSampleCount() : incremental_.getSampleCount();
+    }
+    if (usesFloatStorage()) {
+        return dataF32_.size();
+    }
     return data_.size();
 }
 
+size_t SteadyStateDetector::getNonFiniteCount() const {
+    return nonFiniteCount_;
+}
+
+size_t SteadyStateDetector::getRejectedCount() const {
+    return rejectedCount_;
+}
+
 const MSERResult& SteadyStateDetector::getLastResult() const {
     return lastResult_;
 }
@@ -102,12 +251,19 @@ bool SteadyStateDetector::hasConverged() const {
     return converged_;
 }
 
-Statistics SteadyStateDetector::getCurrentStatistics() const {
-    if (data_.empty()) {
-        return Statistics();
+bool SteadyStateDetector::isCheckPending() const {
+    return scan_.isPending();
+}
+
+double SteadyStateDetector::getTruncationTime() const {
+    if (!usesTimeWeighting()) {
+        return 0.0;
     }
-    
-    return mserCalculator_->calculateStatistics(data_, 0, data_.size());
+    return timeWeighted_.getTruncationTime(lastResult_.truncationPoint);
+}
+
+Statistics SteadyStateDetector::getCurrentStatistics() const {
+    return Statistics(statistics_);
 }
 
 // ============================================================================
@@ -115,39 +271,339 @@ Statistics SteadyStateDetector::getCurrentStatistics() const {
 // ============================================================================
 
 void SteadyStateDetector::updateConfig(const SteadyStateConfig& config) {
+    // 生データを保持していない（ストリーミング中）場合は再構築できない
+    bool wasIncremental = usesIncrementalState();
+    bool wasStreaming = config_.enableStreaming;
+    bool wasFloat = usesFloatStorage();
+    bool wasTimeWeighted = usesTimeWeighting();
+    
     config_ = config;
     
-    // データ容量の調整
-    if (data_.capacity() < config_.maxSamples) {
-        data_.reserve(config_.maxSamples);
+    // 実行中の走査は変更前の設定に対するもののため破棄
+    scan_.cancel();
+    
+    // ストリーミングの圧縮済み状態からは蓄積データを復元できないため取り込み状態を破棄
+    bool leavesStreaming = wasStreaming && !config_.enableStreaming;
+    if (leavesStreaming) {
+        reset();
+    }
+    
+    if (!config_.enableStreaming) {
+        convertStorage();
+        
+        // 単精度への変換で値が丸められるため統計量を取り直す
+        if (wasFloat != usesFloatStorage()) {
+            rebuildStatistics();
+        }
+    }
+    
+    // バッチ構成または格納精度が変わった場合のみ蓄積データから再構築
+    bool rebuild = usesIncrementalState() && (leavesStreaming || (!wasStreaming &&
+        (!wasIncremental || wasFloat != usesFloatStorage() ||
+         IncrementalMSER::batchSizeFor(config_) != incremental_.getBatchSize())));
+    if (rebuild) {
+        rebuildIncrementalState();
+    }
+    
+    bool rebuildTimeWeighted = usesTimeWeighting() && (leavesStreaming || (!wasStreaming &&
+        (!wasTimeWeighted || wasFloat != usesFloatStorage() ||
+         IncrementalMSER::batchSizeFor(config_) != timeWeighted_.getBatchSize())));
+    if (rebuildTimeWeighted) {
+        rebuildTimeWeightedState();
     }
+    
+    // ストリーミング中は生データがなく、重み付けの切り替え後の状態を再構築できない
+    if (wasStreaming && config_.enableStreaming && wasTimeWeighted != usesTimeWeighting()) {
+        reset();
+    }
+    
+    if (!usesTimeWeighting() || config_.enableStreaming) {
+        timestamps_.clear();
+        timestamps_.shrink_to_fit();
+    }
+    
+    if (config_.enableStreaming) {
+        incremental_.setBatchLimit(config_.streamingBudget);
+        timeWeighted_.setBatchLimit(config_.streamingBudget);
+        data_.clear();
+        data_.shrink_to_fit();
+        dataF32_.clear();
+        dataF32_.shrink_to_fit();
+        return;
+    }
+    
+    incremental_.setBatchLimit(0);
+    timeWeighted_.setBatchLimit(0);
+    reserveWorkspace();
 }
 
 void SteadyStateDetector::setConvergenceCallback(std::function<void(const MSERResult&)> callback) {
     convergenceCallback_ = callback;
 }
 
+void SteadyStateDetector::setEventDispatcher(EventDispatcher* dispatcher, const std::string& sourceName) {
+    eventDispatcher_ = dispatcher;
+    eventSource_ = dispatcher ? dispatcher->registerSource(sourceName) : nullptr;
+}
+
+// ============================================================================
+// メトリクス機能の実装
+// ============================================================================
+
+size_t SteadyStateDetector::getBytesHeld() const {
+    return data_.capacity() * sizeof(TimeSeriesValue) + dataF32_.capacity() * sizeof(float) +
+           incremental_.getBytesHeld() + timestamps_.capacity() * sizeof(double) +
+           timeWeighted_.getBytesHeld() + workspace_.getBytesHeld();
+}
+
+#ifdef MSER_ENABLE_METRICS
+DetectorMetrics SteadyStateDetector::getMetrics() const {
+    DetectorMetrics snapshot = metrics_;
+    snapshot.bytesHeld = getBytesHeld();
+    return snapshot;
+}
+
+void SteadyStateDetector::resetMetrics() {
+    metrics_ = DetectorMetrics();
+}
+#endif
+
+ScheduleStatistics SteadyStateDetector::getScheduleStatistics() const {
+    ScheduleStatistics snapshot = schedule_;
+    if (getCurrentSampleCount() > 0) {
+        snapshot.elapsedTimeNs = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - startTime_).count());
+    }
+    return snapshot;
+}
+
+// ============================================================================
+// チェックポイント機能の実装
+// ============================================================================
+
+std::vector<std::uint8_t> SteadyStateDetector::serialize() const {
+    std::vector<std::uint8_t> buffer;
+    buffer.reserve(256 + data_.size() * sizeof(TimeSeriesValue) + dataF32_.size() * sizeof(float) +
+                   incremental_.getBytesHeld() + timestamps_.size() * sizeof(double) +
+                   timeWeighted_.getBytesHeld());
+    
+    CheckpointWriter writer(buffer);
+    writer.writeHeader();
+    writeConfig(writer, config_);
+    writer.writeBool(converged_);
+    writer.writeSize(lastCheckIndex_);
+    writer.writeSize(nonFiniteCount_);
+    writer.writeSize(rejectedCount_);
+    writer.write(lastFiniteValue_);
+    writer.writeBool(hasFiniteValue_);
+    writeResult(writer, lastResult_);
+    
+    ScheduleStatistics schedule = getScheduleStatistics();
+    writer.writeSize(schedule.checksPerformed);
+    writer.write(schedule.checkTimeNs);
+    writer.write(schedule.elapsedTimeNs);
+    writer.writeSize(schedule.detectionSample);
+    writer.writeSize(schedule.detectionLatency);
+    
+    writer.writeArray(data_);
+    writer.writeArray(dataF32_);
+    incremental_.serialize(writer);
+    writer.writeArray(timestamps_);
+    timeWeighted_.serialize(writer);
+    statistics_.serialize(writer);
+    
+    return buffer;
+}
+
+bool SteadyStateDetector::deserialize(const std::uint8_t* data, size_t size) {
+    CheckpointReader reader(data, size);
+    
+    SteadyStateConfig config;
+    bool converged = false;
+    size_t lastCheckIndex = 0;
+    size_t nonFiniteCount = 0;
+    size_t rejectedCount = 0;
+    TimeSeriesValue lastFiniteValue = 0.0;
+    bool hasFiniteValue = false;
+    MSERResult lastResult;
+    ScheduleStatistics schedule;
+    if (!reader.readHeader() || !readConfig(reader, config) ||
+        !reader.readBool(converged) || !reader.readSize(lastCheckIndex) ||
+        !reader.readSize(nonFiniteCount) || !reader.readSize(rejectedCount) ||
+        !reader.read(lastFiniteValue) || !reader.readBool(hasFiniteValue) ||
+        !readResult(reader, lastResult) ||
+        !reader.readSize(schedule.checksPerformed) || !reader.read(schedule.checkTimeNs) ||
+        !reader.read(schedule.elapsedTimeNs) || !reader.readSize(schedule.detectionSample) ||
+        !reader.readSize(schedule.detectionLatency)) {
+        return false;
+    }
+    
+    // 容量の予約は検証後に行う（破損した maxSamples で巨大な確保を試みない）
+    TimeSeriesData samples;
+    TimeSeriesDataF32 samplesF32;
+    TimeSeriesData timestamps;
+    bool floatStorage = config.storage == SampleStorage::FLOAT32 && !config.enableStreaming;
+    bool keepsTimestamps = config.timeWeighted && !config.enableStreaming;
+    
+    IncrementalMSER incremental(IncrementalMSER::batchSizeFor(config));
+    TimeWeightedMSER timeWeighted(IncrementalMSER::batchSizeFor(config));
+    RunningStatistics statistics;
+    if (!reader.readArray(samples) || !reader.readArray(samplesF32) ||
+        !incremental.deserialize(reader) || !reader.readArray(timestamps) ||
+        !timeWeighted.deserialize(reader) || !statistics.deserialize(reader) ||
+        !reader.atEnd()) {
+        return false;
+    }
+    
+    // 格納方式と蓄積データ・インクリメンタル状態の整合性検証
+    bool usesIncremental = (config.enableIncremental || config.enableStreaming ||
+                            (config.checkSliceBudget > 0 &&
+                             config.algorithm == MSERAlgorithm::SUFFIX_SUM)) &&
+                           !config.timeWeighted;
+    size_t sampleCount = config.enableStreaming
+        ? (config.timeWeighted ? timeWeighted.getSampleCount() : incremental.getSampleCount())
+        : floatStorage ? samplesF32.size() : samples.size();
+    bool valid = (floatStorage ? samples.empty() : samplesF32.empty()) &&
+                 (!config.enableStreaming || samplesF32.empty()) &&
+                 (!usesIncremental || incremental.getSampleCount() == sampleCount) &&
+                 (!config.timeWeighted || timeWeighted.getSampleCount() == sampleCount) &&
+                 (keepsTimestamps ? timestamps.size() == sampleCount : timestamps.empty()) &&
+                 statistics.getCount() == sampleCount &&
+                 lastCheckIndex <= sampleCount && rejectedCount <= sampleCount &&
+                 rejectedCount <= nonFiniteCount;
+    
+    // 非ストリーミング時は上限超過の1サンプルまでしか蓄積せず、maxSamples 分を予約できること
+    if (!config.enableStreaming) {
+        valid = valid && sampleCount <= config.maxSamples + 1 &&
+                config.maxSamples < (floatStorage ? samplesF32.max_size() : samples.max_size()) &&
+                (!keepsTimestamps || config.maxSamples < timestamps.max_size());
+    }
+    if (!valid) {
+        return false;
+    }
+    
+    config_ = config;
+    scan_.cancel();  // 分割実行中の走査は保存しない（次の取り込みで改めて開始する）
+    converged_ = converged;
+    lastCheckIndex_ = lastCheckIndex;
+    nonFiniteCount_ = nonFiniteCount;
+    rejectedCount_ = rejectedCount;
+    lastFiniteValue_ = lastFiniteValue;
+    hasFiniteValue_ = hasFiniteValue;
+    lastResult_ = lastResult;
+    schedule_ = schedule;
+    schedule_.elapsedTimeNs = 0;
+    data_ = std::move(samples);
+    dataF32_ = std::move(samplesF32);
+    incremental_ = std::move(incremental);
+    timestamps_ = std::move(timestamps);
+    timeWeighted_ = std::move(timeWeighted);
+    statistics_ = statistics;  // ストリーミング時は生データがなく再計算できないため保存値を使用
+    
+    // 以後の追加で再確保しないよう、復元したデータの容量を予約する
+    if (!config_.enableStreaming) {
+        if (usesFloatStorage()) {
+            dataF32_.reserve(config_.maxSamples);
+        } else {
+            data_.reserve(config_.maxSamples);
+        }
+        if (usesTimeWeighting()) {
+            timestamps_.reserve(config_.maxSamples);
+            timeWeighted_.reserve(config_.maxSamples / timeWeighted_.getBatchSize());
+        } else if (usesIncrementalState()) {
+            incremental_.reserve(config_.maxSamples / incremental_.getBatchSize());
+        }
+    }
+    reserveWorkspace();
+    
+    // 経過時間を引き継ぎ、TIME_BUDGET の予算計算を継続させる
+    startTime_ = std::chrono::steady_clock::now() -
+                 std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                     std::chrono::nanoseconds(schedule.elapsedTimeNs));
+    
+    return true;
+}
+
+bool SteadyStateDetector::deserialize(const std::vector<std::uint8_t>& buffer) {
+    return deserialize(buffer.data(), buffer.size());
+}
+
+bool SteadyStateDetector::saveCheckpoint(const std::string& path) const {
+    return writeCheckpointFile(path, serialize());
+}
+
+bool SteadyStateDetector::loadCheckpoint(const std::string& path) {
+    std::vector<std::uint8_t> buffer;
+    return readCheckpointFile(path, buffer) && deserialize(buffer);
+}
+
 // ============================================================================
 // データアクセス機能の実装
 // ============================================================================
 
 TimeSeriesData SteadyStateDetector::getAccumulatedData() const {
+    if (config_.enableStreaming) {
+        return streamingBatchMeans();  // コピーを返す
+    }
+    if (usesFloatStorage()) {
+        return TimeSeriesData(dataF32_.begin(), dataF32_.end());
+    }
     return data_;  // コピーを返す
 }
 
-double SteadyStateDetector::getCurrentMean() const {
-    if (data_.empty()) {
-        return 0.0;
+void SteadyStateDetector::getAccumulatedData(TimeSeriesData& out) const {
+    if (config_.enableStreaming) {
+        const TimeSeriesData& batchMeans = streamingBatchMeans();
+        out.assign(batchMeans.begin(), batchMeans.end());
+    } else if (usesFloatStorage()) {
+        out.assign(dataF32_.begin(), dataF32_.end());
+    } else {
+        out.assign(data_.begin(), data_.end());
     }
-    
-    Statistics stats = getCurrentStatistics();
-    return stats.mean;
+}
+
+double SteadyStateDetector::getCurrentMean() const {
+    return statistics_.getMean();
 }
 
 // ============================================================================
 // 内部機能の実装
 // ============================================================================
 
+bool SteadyStateDetector::admitValue(TimeSeriesValue& value) {
+    // 単精度格納では変換後に範囲外（Inf）となる値も非有限として扱う
+    bool finite = std::isfinite(value) &&
+                  (!usesFloatStorage() || std::isfinite(static_cast<float>(value)));
+    if (finite) {
+        lastFiniteValue_ = value;
+        hasFiniteValue_ = true;
+        return true;
+    }
+    
+    ++nonFiniteCount_;
+    switch (config_.nonFinitePolicy) {
+        case NonFinitePolicy::SKIP:
+            return false;
+        case NonFinitePolicy::CLAMP:
+            if (!hasFiniteValue_) {
+                return false;
+            }
+            value = lastFiniteValue_;
+            return true;
+        case NonFinitePolicy::RESET: {
+            size_t nonFiniteCount = nonFiniteCount_;
+            reset();
+            nonFiniteCount_ = nonFiniteCount;
+            return false;
+        }
+        case NonFinitePolicy::REJECT:
+        default:
+            ++rejectedCount_;
+            return true;
+    }
+}
+
 bool SteadyStateDetector::shouldPerformCheck() const {
     // ウォーミングアップ期間中はチェックしない
     if (isInWarmingPeriod()) {
@@ -155,13 +611,40 @@ bool SteadyStateDetector::shouldPerformCheck() const {
     }
     
     // 最小サンプル数未満はチェックしない
-    if (data_.size() < config_.minSamples) {
+    if (getCurrentSampleCount() < config_.minSamples) {
         return false;
     }
     
-    // チェック間隔に基づく判定
-    size_t samplesSinceLastCheck = data_.size() - lastCheckIndex_;
-    return samplesSinceLastCheck >= config_.checkInterval;
+    // スケジュールに基づく判定
+    size_t samplesSinceLastCheck = getCurrentSampleCount() - lastCheckIndex_;
+    if (samplesSinceLastCheck < scheduledInterval()) {
+        return false;
+    }
+    
+    // 時間予算はチェック間隔の区切りでのみ確認（時刻取得をサンプルごとに行わない）
+    if (config_.checkSchedule == CheckSchedule::TIME_BUDGET) {
+        size_t interval = std::max<size_t>(config_.checkInterval, 1);
+        return samplesSinceLastCheck % interval == 0 && withinTimeBudget();
+    }
+    
+    return true;
+}
+
+size_t SteadyStateDetector::scheduledInterval() const {
+    if (config_.checkSchedule == CheckSchedule::GEOMETRIC) {
+        // 前回チェック時のサンプル数 n に対し n·(1+ε)（checkInterval を下限とする）
+        auto growth = static_cast<size_t>(
+            std::ceil(static_cast<double>(lastCheckIndex_) * config_.geometricGrowth));
+        return std::max(config_.checkInterval, growth);
+    }
+    return config_.checkInterval;
+}
+
+bool SteadyStateDetector::withinTimeBudget() const {
+    auto elapsedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - startTime_).count();
+    return static_cast<double>(schedule_.checkTimeNs) <=
+           config_.checkTimeBudget * static_cast<double>(elapsedNs);
 }
 
 bool SteadyStateDetector::isInWarmingPeriod() const {
@@ -169,7 +652,7 @@ bool SteadyStateDetector::isInWarmingPeriod() const {
         return false;
     }
     
-    return data_.size() < config_.warmingSteps;
+    return getCurrentSampleCount() < config_.warmingSteps;
 }
 
 bool SteadyStateDetector::evaluateConvergence(const MSERResult& result) {
@@ -181,10 +664,218 @@ bool SteadyStateDetector::evaluateConvergence(const MSERResult& result) {
     return result.mserValue <= config_.convergenceThreshold;
 }
 
-void SteadyStateDetector::triggerCallback(const MSERResult& result) {
+bool SteadyStateDetector::continueSlicedCheck() {
+    auto start = std::chrono::steady_clock::now();
+    
+    bool completed = false;
+    if (config_.checkSliceUnit == CheckSliceUnit::NANOSECONDS) {
+        // 時刻の確認は一定数の走査位置ごと（最低1区間は進める）
+        auto budget = std::chrono::nanoseconds(config_.checkSliceBudget);
+        do {
+            completed = scan_.advance(incremental_, kSliceTimeCheckPositions);
+        } while (!completed && std::chrono::steady_clock::now() - start < budget);
+    } else {
+        completed = scan_.advance(incremental_, config_.checkSliceBudget);
+    }
+    
+    recordCheckElapsed(start);
+    if (!completed) {
+        return false;
+    }
+    
+    // 結果は走査開始時点のサンプル数に対するもの
+    lastResult_ = scan_.getResult();
+    return completeCheck(lastResult_.totalSamples);
+}
+
+void SteadyStateDetector::recordCheckElapsed(std::chrono::steady_clock::time_point start) {
+    auto elapsedNs = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count());
+    schedule_.checkTimeNs += elapsedNs;
+#ifdef MSER_ENABLE_METRICS
+    recordCheckTime(elapsedNs);
+#endif
+}
+
+bool SteadyStateDetector::completeCheck(size_t checkIndex) {
+    ++schedule_.checksPerformed;
+    
+    size_t previousCheckIndex = lastCheckIndex_;
+    lastCheckIndex_ = checkIndex;
+    
+    // 収束判定
+    bool newlyConverged = evaluateConvergence(lastResult_);
+    
+    if (newlyConverged && !converged_) {
+        converged_ = true;
+        schedule_.detectionSample = lastCheckIndex_;
+        schedule_.detectionLatency = lastCheckIndex_ - previousCheckIndex;
+        triggerCallback(lastResult_, DetectorEventType::CONVERGED);
+    }
+    
+    return converged_;
+}
+
+void SteadyStateDetector::triggerCallback(const MSERResult& result, DetectorEventType type) {
     if (convergenceCallback_) {
         convergenceCallback_(result);
     }
+    
+    if (eventDispatcher_) {
+        eventDispatcher_->publish(type, eventSource_, result);
+    }
+}
+
+void SteadyStateDetector::rebuildIncrementalState() {
+    incremental_.setBatchSize(IncrementalMSER::batchSizeFor(config_));
+    
+    if (config_.enableStreaming) {
+        incremental_.setBatchLimit(config_.streamingBudget);
+    } else {
+        incremental_.reserve(config_.maxSamples / incremental_.getBatchSize());
+    }
+    
+    if (usesFloatStorage()) {
+        for (float value : dataF32_) {
+            incremental_.addValue(value);
+        }
+        return;
+    }
+    
+    for (const auto& value : data_) {
+        incremental_.addValue(value);
+    }
+}
+
+void SteadyStateDetector::rebuildTimeWeightedState() {
+    timeWeighted_.setBatchSize(IncrementalMSER::batchSizeFor(config_));
+    
+    if (config_.enableStreaming) {
+        timeWeighted_.setBatchLimit(config_.streamingBudget);
+    } else {
+        timeWeighted_.reserve(config_.maxSamples / timeWeighted_.getBatchSize());
+    }
+    
+    // 生データは格納精度の変換前後いずれかの配列にある
+    size_t sampleCount = std::max(data_.size(), dataF32_.size());
+    if (timestamps_.size() != sampleCount) {
+        timestamps_.resize(sampleCount);
+        for (size_t i = 0; i < sampleCount; ++i) {
+            timestamps_[i] = static_cast<double>(i);
+        }
+    }
+    if (!config_.enableStreaming && timestamps_.capacity() < config_.maxSamples) {
+        timestamps_.reserve(config_.maxSamples);
+    }
+    
+    for (size_t i = 0; i < sampleCount; ++i) {
+        TimeSeriesValue value = dataF32_.empty() ? data_[i] : dataF32_[i];
+        timeWeighted_.addValue(value, timestamps_[i]);
+    }
+}
+
+void SteadyStateDetector::rebuildStatistics() {
+    statistics_.reset();
+    if (usesFloatStorage()) {
+        statistics_.add(dataF32_.data(), dataF32_.size());
+    } else {
+        statistics_.add(data_.data(), data_.size());
+    }
+}
+
+bool SteadyStateDetector::usesFloatStorage() const {
+    return config_.storage == SampleStorage::FLOAT32 && !config_.enableStreaming;
+}
+
+void SteadyStateDetector::convertStorage() {
+    if (usesFloatStorage()) {
+        if (!data_.empty()) {
+            dataF32_.reserve(std::max(config_.maxSamples, data_.size()));
+            for (TimeSeriesValue value : data_) {
+                dataF32_.push_back(static_cast<float>(value));
+            }
+        }
+        data_.clear();
+        data_.shrink_to_fit();
+        
+        if (dataF32_.capacity() < config_.maxSamples) {
+            dataF32_.reserve(config_.maxSamples);
+        }
+        return;
+    }
+    
+    if (!dataF32_.empty()) {
+        data_.reserve(std::max(config_.maxSamples, dataF32_.size()));
+        data_.insert(data_.end(), dataF32_.begin(), dataF32_.end());
+    }
+    dataF32_.clear();
+    dataF32_.shrink_to_fit();
+    
+    // データ容量の調整
+    if (data_.capacity() < config_.maxSamples) {
+        data_.reserve(config_.maxSamples);
+    }
+}
+
+#ifdef MSER_ENABLE_METRICS
+void SteadyStateDetector::recordSample() {
+    ++metrics_.samplesIngested;
+    
+    // チェック間隔の区切りに達したが、ウォーミングアップ・最小サンプル数で見送る場合を集計
+    size_t samplesSinceLastCheck = getCurrentSampleCount() - lastCheckIndex_;
+    if (config_.checkInterval == 0 || samplesSinceLastCheck % config_.checkInterval != 0) {
+        return;
+    }
+    
+    if (isInWarmingPeriod()) {
+        ++metrics_.checksSkippedWarming;
+    } else if (getCurrentSampleCount() < config_.minSamples) {
+        ++metrics_.checksSkippedMinSamples;
+    }
+}
+
+void SteadyStateDetector::recordCheckTime(std::uint64_t elapsedNs) {
+    ++metrics_.checksPerformed;
+    metrics_.totalCheckTimeNs += elapsedNs;
+    metrics_.maxCheckTimeNs = std::max(metrics_.maxCheckTimeNs, elapsedNs);
+    
+    // ビン i は [2^i, 2^(i+1)) ナノ秒、範囲外は最終ビン
+    size_t bin = 0;
+    while (elapsedNs > 1 && bin + 1 < kLatencyHistogramBins) {
+        elapsedNs >>= 1;
+        ++bin;
+    }
+    ++metrics_.checkLatencyHistogram[bin];
+}
+#endif
+
+void SteadyStateDetector::reserveWorkspace() {
+    // MSER-1 は生データを直接走査するためバッチ平均系列は不要
+    size_t batchSize = IncrementalMSER::batchSizeFor(config_);
+    if (usesIncrementalState() || usesTimeWeighting() || batchSize <= 1) {
+        return;
+    }
+    workspace_.reserve(config_.maxSamples / batchSize);
+}
+
+bool SteadyStateDetector::usesIncrementalState() const {
+    return (config_.enableIncremental || config_.enableStreaming || usesSlicedCheck()) &&
+           !usesTimeWeighting();
+}
+
+bool SteadyStateDetector::usesSlicedCheck() const {
+    // 分割実行できるのは接尾和の後方走査のみ（DIRECT は一括の全再計算で行う）
+    return config_.checkSliceBudget > 0 && config_.algorithm == MSERAlgorithm::SUFFIX_SUM &&
+           !usesTimeWeighting();
+}
+
+bool SteadyStateDetector::usesTimeWeighting() const {
+    return config_.timeWeighted;
+}
+
+const TimeSeriesData& SteadyStateDetector::streamingBatchMeans() const {
+    return usesTimeWeighting() ? timeWeighted_.getBatchMeans() : incremental_.getBatchMeans();
 }
 
 // ============================================================================
@@ -194,7 +885,8 @@ void SteadyStateDetector::triggerCallback(const MSERResult& result) {
 namespace integration {
 
 std::unique_ptr<SteadyStateDetector> createForPhysXSimulation(
-    const SteadyStateConfig& config) {
+    const SteadyStateConfig& config,
+    EventDispatcher* dispatcher) {
     SteadyStateConfig physxConfig = config;
     
     // PhysXシミュレーション向けのデフォルト調整
@@ -208,43 +900,20 @@ std::unique_ptr<SteadyStateDetector> createForPhysXSimulation(
     
     auto detector = std::make_unique<SteadyStateDetector>(physxConfig);
     
-    // PhysX 用のコールバック設定（ログ出力）
-    detector->setConvergenceCallback([](const MSERResult& result) {
-        std::cout << "[定常状態検出] シミュレーション収束を検出" << std::endl;
-        std::cout << "  切り捨て点: " << result.truncationPoint << std::endl;
-        std::cout << "  MSER値: " << result.mserValue << std::endl;
-        std::cout << "  総サンプル数: " << result.totalSamples << std::endl;
-        std::cout << "  収束状態: " << (result.converged ? "成功" : "失敗") << std::endl;
-    });
+    // ログ出力はディスパッチスレッドで行う（ステップスレッドはキューへの発行のみ）
+    detector->setEventDispatcher(dispatcher ? dispatcher : &defaultEventDispatcher(), "PhysXシミュレーション");
     
     return detector;
 }
 
 std::unique_ptr<SteadyStateDetector> createForGenericSimulation(
     const std::string& metricName,
-    const SteadyStateConfig& config) {
+    const SteadyStateConfig& config,
+    EventDispatcher* dispatcher) {
     auto detector = std::make_unique<SteadyStateDetector>(config);
     
-    // 汎用シミュレーション用のコールバック設定
-    detector->setConvergenceCallback([metricName](const MSERResult& result) {
-        std::cout << "[定常状態検出] " << metricName << " が収束しました" << std::endl;
-        std::cout << "  MSER変種: ";
-        switch (result.variant) {
-            case MSERVariant::MSER_1: std::cout << "MSER-1"; break;
-            case MSERVariant::MSER_5: std::cout << "MSER-5"; break;
-            case MSERVariant::MSER_M: std::cout << "MSER-m"; break;
-        }
-        std::cout << std::endl;
-        std::cout << "  切り捨て点: " << result.truncationPoint << std::endl;
-        std::cout << "  MSER値: " << result.mserValue << std::endl;
-        std::cout << "  総サンプル数: " << result.totalSamples << std::endl;
-        
-        if (result.variant != MSERVariant::MSER_1) {
-            std::cout << "  バッチ数: " << result.batchCount << std::endl;
-        }
-        
-        std::cout << "  収束状態: " << (result.converged ? "成功" : "失敗") << std::endl;
-    });
+    // ログ出力はディスパッチスレッドで行う（ステップスレッドはキューへの発行のみ）
+    detector->setEventDispatcher(dispatcher ? dispatcher : &defaultEventDispatcher(), metricName);
     
     return detector;
 }
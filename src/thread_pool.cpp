@@ -0,0 +1,167 @@
+#include "mser/thread_pool.h"
+#include <algorithm>
+
+namespace mser {
+
+namespace {
+
+thread_local const ThreadPool* currentPool = nullptr;  // 実行中のプール（入れ子呼び出し検出用）
+
+} // namespace
+
+ThreadPool::ThreadPool(size_t threadCount)
+    : threadCount_(threadCount != 0 ? threadCount
+                                    : std::max<size_t>(std::thread::hardware_concurrency(), 1)),
+      task_(nullptr), generation_(0), activeWorkers_(0), stopping_(false), pendingTasks_(0) {
+    ranges_.reserve(threadCount_);
+    for (size_t i = 0; i < threadCount_; ++i) {
+        ranges_.push_back(std::make_unique<WorkRange>());
+    }
+    
+    threads_.reserve(threadCount_ - 1);
+    for (size_t worker = 1; worker < threadCount_; ++worker) {
+        threads_.emplace_back(&ThreadPool::workerLoop, this, worker);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        stopping_ = true;
+    }
+    jobReady_.notify_all();
+    
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+// ============================================================================
+// 並列実行機能の実装
+// ============================================================================
+
+void ThreadPool::parallelFor(size_t taskCount, const std::function<void(size_t)>& task) {
+    if (taskCount == 0) {
+        return;
+    }
+    
+    // 単一ワーカー・入れ子呼び出しは呼び出しスレッドで逐次実行
+    if (threadCount_ == 1 || taskCount == 1 || currentPool == this) {
+        for (size_t i = 0; i < taskCount; ++i) {
+            task(i);
+        }
+        return;
+    }
+    
+    std::lock_guard<std::mutex> jobLock(jobMutex_);
+    
+    // タスク範囲をワーカー数で均等に分割
+    for (size_t worker = 0; worker < threadCount_; ++worker) {
+        std::lock_guard<std::mutex> lock(ranges_[worker]->mutex);
+        ranges_[worker]->begin = taskCount * worker / threadCount_;
+        ranges_[worker]->end = taskCount * (worker + 1) / threadCount_;
+    }
+    pendingTasks_.store(taskCount, std::memory_order_relaxed);
+    
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        task_ = &task;
+        ++generation_;
+        activeWorkers_ = threadCount_ - 1;
+    }
+    jobReady_.notify_all();
+    
+    const ThreadPool* previousPool = currentPool;
+    currentPool = this;
+    runTasks(0, task);
+    currentPool = previousPool;
+    
+    // 全タスク完了かつ全ワーカーがジョブを離脱するまで待機
+    std::unique_lock<std::mutex> lock(stateMutex_);
+    jobDone_.wait(lock, [this]() {
+        return activeWorkers_ == 0 && pendingTasks_.load(std::memory_order_acquire) == 0;
+    });
+    task_ = nullptr;
+}
+
+size_t ThreadPool::getThreadCount() const {
+    return threadCount_;
+}
+
+// ============================================================================
+// 内部機能の実装
+// ============================================================================
+
+void ThreadPool::workerLoop(size_t worker) {
+    size_t seenGeneration = 0;
+    currentPool = this;
+    
+    while (true) {
+        const std::function<void(size_t)>* task = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(stateMutex_);
+            jobReady_.wait(lock, [&]() { return stopping_ || generation_ != seenGeneration; });
+            if (stopping_) {
+                return;
+            }
+            seenGeneration = generation_;
+            task = task_;
+        }
+        
+        runTasks(worker, *task);
+        
+        {
+            std::lock_guard<std::mutex> lock(stateMutex_);
+            --activeWorkers_;
+        }
+        jobDone_.notify_all();
+    }
+}
+
+void ThreadPool::runTasks(size_t worker, const std::function<void(size_t)>& task) {
+    size_t index = 0;
+    while (popLocal(worker, index) || (steal(worker) && popLocal(worker, index))) {
+        task(index);
+        pendingTasks_.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+bool ThreadPool::popLocal(size_t worker, size_t& index) {
+    WorkRange& range = *ranges_[worker];
+    std::lock_guard<std::mutex> lock(range.mutex);
+    if (range.begin >= range.end) {
+        return false;
+    }
+    index = range.begin++;
+    return true;
+}
+
+bool ThreadPool::steal(size_t worker) {
+    for (size_t offset = 1; offset < threadCount_; ++offset) {
+        WorkRange& victim = *ranges_[(worker + offset) % threadCount_];
+        size_t begin = 0;
+        size_t end = 0;
+        {
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            size_t remaining = victim.end - std::min(victim.begin, victim.end);
+            if (remaining == 0) {
+                continue;
+            }
+            
+            // 残り範囲の後半（奇数の場合は多い方）を奪う
+            end = victim.end;
+            begin = victim.end - (remaining + 1) / 2;
+            victim.end = begin;
+        }
+        
+        WorkRange& own = *ranges_[worker];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        own.begin = begin;
+        own.end = end;
+        return true;
+    }
+    
+    return false;
+}
+
+} // namespace mser
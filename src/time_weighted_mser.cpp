@@ -0,0 +1,312 @@
+#include "mser/time_weighted_mser.h"
+#include "mser/simd.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace mser {
+
+TimeWeightedMSER::TimeWeightedMSER(size_t batchSize)
+    : baseBatchSize_(std::max<size_t>(batchSize, 1)), batchSize_(baseBatchSize_),
+      batchLimit_(0), sampleCount_(0), batchFill_(0), nonFiniteCount_(0),
+      batchWeightedSum_(0.0), batchWeight_(0.0), pendingValue_(0.0),
+      lastTimestamp_(0.0), firstTimestamp_(0.0) {
+}
+
+TimeWeightedMSER::~TimeWeightedMSER() {
+}
+
+// ============================================================================
+// データ更新機能の実装
+// ============================================================================
+
+bool TimeWeightedMSER::addValue(TimeSeriesValue value, double timestamp) {
+    if (!std::isfinite(timestamp) || (sampleCount_ > 0 && timestamp < lastTimestamp_)) {
+        return false;
+    }
+    
+    // 直前の観測の保持時間が確定
+    if (sampleCount_ > 0) {
+        addWeighted(pendingValue_, timestamp - lastTimestamp_);
+    } else {
+        firstTimestamp_ = timestamp;
+    }
+    
+    ++sampleCount_;
+    if (!std::isfinite(value)) {
+        ++nonFiniteCount_;
+    }
+    pendingValue_ = value;
+    lastTimestamp_ = timestamp;
+    return true;
+}
+
+void TimeWeightedMSER::reset() {
+    batchSize_ = baseBatchSize_;
+    sampleCount_ = 0;
+    batchFill_ = 0;
+    nonFiniteCount_ = 0;
+    batchWeightedSum_ = 0.0;
+    batchWeight_ = 0.0;
+    pendingValue_ = 0.0;
+    lastTimestamp_ = 0.0;
+    firstTimestamp_ = 0.0;
+    batchMeans_.clear();
+    batchWeights_.clear();
+}
+
+void TimeWeightedMSER::setBatchSize(size_t batchSize) {
+    baseBatchSize_ = std::max<size_t>(batchSize, 1);
+    reset();
+}
+
+void TimeWeightedMSER::reserve(size_t batchCount) {
+    batchMeans_.reserve(batchCount);
+    batchWeights_.reserve(batchCount);
+}
+
+void TimeWeightedMSER::setBatchLimit(size_t maxBatches) {
+    if (maxBatches == 0) {
+        batchLimit_ = 0;
+        return;
+    }
+    
+    // 統合後も最低限のバッチ数（10）を確保できるよう偶数かつ20以上
+    batchLimit_ = std::max<size_t>(maxBatches + (maxBatches & 1), 20);
+    reserve(batchLimit_);
+    
+    while (batchMeans_.size() >= batchLimit_) {
+        compact();
+    }
+}
+
+// ============================================================================
+// MSER計算機能の実装
+// ============================================================================
+
+std::pair<size_t, double> TimeWeightedMSER::findOptimalTruncationPoint() const {
+    size_t n = batchMeans_.size();
+    size_t maxK = n / 2;  // White (1997): k ≤ ⌊n/2⌋-1
+    
+    if (maxK < 2) {
+        return {0, std::numeric_limits<double>::infinity()};
+    }
+    
+    // 現在の時間重み付き平均でシフトした後方累積
+    // 接頭和の差による接尾和は大きな初期過渡で桁落ちするため用いない
+    double totalWeight = 0.0;
+    double weightedSum = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        totalWeight += batchWeights_[i];
+        weightedSum += batchWeights_[i] * batchMeans_[i];
+    }
+    double shift = (totalWeight > 0.0) ? weightedSum / totalWeight : 0.0;
+    
+    return simd::scanSuffixWeighted(batchMeans_.data(), batchWeights_.data(), n, maxK, shift);
+}
+
+MSERResult TimeWeightedMSER::evaluate(MSERVariant variant) const {
+    MSERResult result;
+    result.variant = variant;
+    result.effectiveBatchSize = batchSize_;
+    
+    // MSER::calculate と同じ検証条件（サンプル数は保持時間の確定した観測数）
+    size_t observationCount = (sampleCount_ > 0) ? sampleCount_ - 1 : 0;
+    result.totalSamples = observationCount;
+    bool batched = (variant != MSERVariant::MSER_1 || batchSize_ > 1);
+    size_t minRequiredSize = batched ? batchSize_ * 2 : 10;
+    if (observationCount < minRequiredSize || nonFiniteCount_ > 0) {
+        result.converged = false;
+        return result;
+    }
+    
+    if (batched) {
+        result.batchCount = batchMeans_.size();
+        
+        if (batchMeans_.size() < 10) {  // 最低限のバッチ数
+            result.converged = false;
+            return result;
+        }
+    }
+    
+    auto [truncPoint, mserVal] = findOptimalTruncationPoint();
+    
+    result.truncationPoint = truncPoint;
+    result.mserValue = mserVal;
+    result.converged = (mserVal < std::numeric_limits<double>::infinity());
+    
+    return result;
+}
+
+// ============================================================================
+// 状態取得機能の実装
+// ============================================================================
+
+size_t TimeWeightedMSER::getBatchSize() const {
+    return batchSize_;
+}
+
+size_t TimeWeightedMSER::getBatchLimit() const {
+    return batchLimit_;
+}
+
+size_t TimeWeightedMSER::getSampleCount() const {
+    return sampleCount_;
+}
+
+size_t TimeWeightedMSER::getBatchCount() const {
+    return batchMeans_.size();
+}
+
+const TimeSeriesData& TimeWeightedMSER::getBatchMeans() const {
+    return batchMeans_;
+}
+
+const TimeSeriesData& TimeWeightedMSER::getBatchWeights() const {
+    return batchWeights_;
+}
+
+double TimeWeightedMSER::getTruncationTime(size_t batchIndex) const {
+    return firstTimestamp_ + simd::sum(batchWeights_.data(), std::min(batchIndex, batchWeights_.size()));
+}
+
+double TimeWeightedMSER::getLastTimestamp() const {
+    return lastTimestamp_;
+}
+
+size_t TimeWeightedMSER::getBytesHeld() const {
+    size_t capacity = batchMeans_.capacity() + batchWeights_.capacity();
+    return capacity * sizeof(TimeSeriesValue);
+}
+
+// ============================================================================
+// チェックポイント機能の実装
+// ============================================================================
+
+void TimeWeightedMSER::serialize(CheckpointWriter& writer) const {
+    writer.writeSize(baseBatchSize_);
+    writer.writeSize(batchSize_);
+    writer.writeSize(batchLimit_);
+    writer.writeSize(sampleCount_);
+    writer.writeSize(batchFill_);
+    writer.writeSize(nonFiniteCount_);
+    writer.write(batchWeightedSum_);
+    writer.write(batchWeight_);
+    writer.write(pendingValue_);
+    writer.write(lastTimestamp_);
+    writer.write(firstTimestamp_);
+    writer.writeArray(batchMeans_);
+    writer.writeArray(batchWeights_);
+}
+
+bool TimeWeightedMSER::deserialize(CheckpointReader& reader) {
+    size_t baseBatchSize = 0;
+    size_t batchSize = 0;
+    size_t batchLimit = 0;
+    size_t sampleCount = 0;
+    size_t batchFill = 0;
+    size_t nonFiniteCount = 0;
+    double batchWeightedSum = 0.0;
+    double batchWeight = 0.0;
+    double pendingValue = 0.0;
+    double lastTimestamp = 0.0;
+    double firstTimestamp = 0.0;
+    TimeSeriesData batchMeans;
+    TimeSeriesData batchWeights;
+    
+    bool valid = reader.readSize(baseBatchSize) && reader.readSize(batchSize) &&
+                 reader.readSize(batchLimit) && reader.readSize(sampleCount) &&
+                 reader.readSize(batchFill) && reader.readSize(nonFiniteCount) &&
+                 reader.read(batchWeightedSum) && reader.read(batchWeight) &&
+                 reader.read(pendingValue) &&
+                 reader.read(lastTimestamp) && reader.read(firstTimestamp) &&
+                 reader.readArray(batchMeans) && reader.readArray(batchWeights);
+    
+    // 内部不変条件の検証
+    valid = valid && baseBatchSize >= 1 && batchSize >= baseBatchSize &&
+            batchFill < batchSize && nonFiniteCount <= sampleCount &&
+            batchWeights.size() == batchMeans.size() &&
+            std::isfinite(lastTimestamp) && std::isfinite(firstTimestamp) &&
+            firstTimestamp <= lastTimestamp &&
+            (batchLimit == 0 || batchMeans.size() < batchLimit);
+    if (!valid) {
+        return false;
+    }
+    
+    baseBatchSize_ = baseBatchSize;
+    batchSize_ = batchSize;
+    batchLimit_ = batchLimit;
+    sampleCount_ = sampleCount;
+    batchFill_ = batchFill;
+    nonFiniteCount_ = nonFiniteCount;
+    batchWeightedSum_ = batchWeightedSum;
+    batchWeight_ = batchWeight;
+    pendingValue_ = pendingValue;
+    lastTimestamp_ = lastTimestamp;
+    firstTimestamp_ = firstTimestamp;
+    batchMeans_ = std::move(batchMeans);
+    batchWeights_ = std::move(batchWeights);
+    
+    if (batchLimit_ > 0) {
+        reserve(batchLimit_);
+    }
+    
+    return true;
+}
+
+// ============================================================================
+// 内部機能の実装
+// ============================================================================
+
+void TimeWeightedMSER::addWeighted(double value, double weight) {
+    batchWeightedSum_ += weight * value;
+    batchWeight_ += weight;
+    if (++batchFill_ < batchSize_) {
+        return;
+    }
+    
+    // 保持時間0のバッチは平均を0とする（接尾和への寄与はない）
+    double batchMean = (batchWeight_ > 0.0) ? batchWeightedSum_ / batchWeight_ : 0.0;
+    appendBatch(batchMean, batchWeight_);
+    batchWeightedSum_ = 0.0;
+    batchWeight_ = 0.0;
+    batchFill_ = 0;
+}
+
+void TimeWeightedMSER::appendBatch(double batchMean, double batchWeight) {
+    batchMeans_.push_back(batchMean);
+    batchWeights_.push_back(batchWeight);
+    
+    if (batchLimit_ > 0 && batchMeans_.size() >= batchLimit_) {
+        compact();
+    }
+}
+
+void TimeWeightedMSER::compact() {
+    size_t merged = batchMeans_.size() / 2;
+    
+    // 奇数個の場合、末尾のバッチは新しいバッチサイズの部分バッチに戻す
+    if (batchMeans_.size() % 2 != 0) {
+        batchWeightedSum_ += batchMeans_.back() * batchWeights_.back();
+        batchWeight_ += batchWeights_.back();
+        batchFill_ += batchSize_;
+    }
+    
+    // 隣接する2バッチの保持時間で重み付けした平均 = 倍サイズのバッチ平均
+    for (size_t i = 0; i < merged; ++i) {
+        double w0 = batchWeights_[2 * i];
+        double w1 = batchWeights_[2 * i + 1];
+        double weight = w0 + w1;
+        batchMeans_[i] = (weight > 0.0)
+            ? (w0 * batchMeans_[2 * i] + w1 * batchMeans_[2 * i + 1]) / weight : 0.0;
+        batchWeights_[i] = weight;
+    }
+    batchMeans_.resize(merged);
+    batchWeights_.resize(merged);
+    
+    // 部分バッチは新しいバッチサイズに向けてそのまま累積を継続する
+    batchSize_ *= 2;
+}
+
+} // namespace mser
@@ -0,0 +1,91 @@
+#include "mser/async_steady_state_detector.h"
+#include "test_support.h"
+#include <atomic>
+#include <cstdio>
+#include <random>
+#include <thread>
+
+using namespace mser;
+
+namespace {
+
+SteadyStateConfig makeConfig() {
+    SteadyStateConfig config;
+    config.variant = MSERVariant::MSER_5;
+    config.minSamples = 200;
+    config.maxSamples = 100000;
+    config.checkInterval = 50;
+    config.convergenceThreshold = 1e-3;
+    return config;
+}
+
+/**
+ * 解析スレッドの稼働中に設定したコールバックが収束時に1回だけ呼び出されること
+ */
+void testCallbackSetWhileRunning() {
+    AsyncSteadyStateDetector detector(makeConfig(), 1 << 16);
+    std::atomic<int> calls(0);
+    
+    // 解析スレッドが起動済みの状態で、別スレッドから設定を入れ替える
+    std::thread setter([&] {
+        for (int i = 0; i < 100; ++i) {
+            detector.setConvergenceCallback([](const MSERResult&) {});
+        }
+        detector.setConvergenceCallback([&calls](const MSERResult&) {
+            calls.fetch_add(1);
+        });
+    });
+    setter.join();
+    
+    std::mt19937_64 rng(3);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    for (size_t i = 0; i < 20000 && !detector.hasConverged(); ++i) {
+        detector.addDataPoint(10.0 + normal(rng));
+        if (i % 1000 == 999) {
+            detector.flush();
+        }
+    }
+    detector.flush();
+    detector.stop();
+    
+    MSER_CHECK(detector.hasConverged());
+    MSER_CHECK(calls.load() == 1);
+}
+
+/**
+ * flush から戻った時点で追加済みの全データが解析済みであること
+ */
+void testFlushWaitsForProcessing() {
+    SteadyStateConfig config = makeConfig();
+    config.convergenceThreshold = 0.0;  // 収束させない
+    AsyncSteadyStateDetector detector(config, 1 << 12);
+    
+    size_t pushed = 0;
+    for (int round = 0; round < 50; ++round) {
+        for (int i = 0; i < 1000; ++i) {
+            detector.addDataPoint(static_cast<double>(i % 7));
+        }
+        pushed += 1000;
+        detector.flush();
+        MSER_CHECK(detector.getProcessedCount() + detector.getDroppedCount() >= pushed);
+    }
+    
+    // 停止後の flush は待機せずに戻る
+    detector.stop();
+    detector.addDataPoint(1.0);
+    detector.flush();
+}
+
+} // namespace
+
+int main() {
+    testCallbackSetWhileRunning();
+    testFlushWaitsForProcessing();
+    
+    if (test::failureCount() > 0) {
+        std::fprintf(stderr, "%d 件のチェックが失敗しました\n", test::failureCount());
+        return 1;
+    }
+    std::printf("async_steady_state_detector_test: 成功\n");
+    return 0;
+}
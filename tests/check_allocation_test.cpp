@@ -0,0 +1,189 @@
+#include "mser/steady_state_detector.h"
+#include "test_support.h"
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <new>
+
+// ============================================================================
+// 割り当て回数の計測（グローバル operator new の置き換え）
+// ============================================================================
+
+namespace {
+
+std::atomic<size_t> gAllocationCount(0);
+
+void* countedAllocate(size_t size) {
+    gAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    void* pointer = std::malloc(size != 0 ? size : 1);
+    if (pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+} // namespace
+
+void* operator new(size_t size) {
+    return countedAllocate(size);
+}
+
+void* operator new[](size_t size) {
+    return countedAllocate(size);
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept {
+    std::free(pointer);
+}
+
+using namespace mser;
+
+namespace {
+
+const size_t kSampleCount = 4000;
+
+/**
+ * 区間内の割り当て回数
+ */
+struct AllocationScope {
+    size_t startCount = gAllocationCount.load(std::memory_order_relaxed);
+    
+    size_t count() const { return gAllocationCount.load(std::memory_order_relaxed) - startCount; }
+};
+
+/**
+ * 収束させずに取り込む設定（自動チェックは行わず、非有限値の置換分を含めて maxSamples に達しない）
+ */
+SteadyStateConfig baseConfig(MSERVariant variant, size_t batchSize) {
+    SteadyStateConfig config;
+    config.variant = variant;
+    config.batchSize = batchSize;
+    config.maxSamples = 2 * kSampleCount;
+    config.checkInterval = kSampleCount + 1;
+    config.convergenceThreshold = -1.0;
+    return config;
+}
+
+/**
+ * 取り込みと checkConvergence の割り当て回数
+ * 97 サンプルごとに checkConvergence を直接呼び出し、初回チェック以降の取り込みも含めて数える。
+ * injectNonFinite の場合は 101 サンプルごとに NaN を挟む
+ */
+size_t countAllocations(const SteadyStateConfig& config, const TimeSeriesData& data,
+                        bool injectNonFinite = false) {
+    SteadyStateDetector detector(config);
+    size_t allocations = 0;
+    size_t checks = 0;
+    double timestamp = 0.0;
+    for (size_t i = 0; i < data.size(); ++i) {
+        AllocationScope scope;
+        if (injectNonFinite && i % 101 == 100) {
+            detector.addDataPoint(std::numeric_limits<double>::quiet_NaN(), timestamp);
+        }
+        // 時刻は不等間隔（timeWeighted=false の場合は無視される）
+        timestamp += 1.0 + 0.5 * static_cast<double>(i % 3);
+        detector.addDataPoint(data[i], timestamp);
+        if ((i + 1) % 97 == 0) {
+            detector.checkConvergence();
+            ++checks;
+        }
+        if (checks > 1) {
+            allocations += scope.count();
+        }
+    }
+    MSER_CHECK(checks > 1);
+    MSER_CHECK(!detector.hasConverged());
+    return allocations;
+}
+
+/**
+ * 定常状態の取り込み・checkConvergence がヒープ確保を行わないこと
+ * 検出モード × MSER変種 × 格納精度の組み合わせ
+ */
+void testChecksDoNotAllocate(const TimeSeriesData& data) {
+    struct VariantCase {
+        MSERVariant variant;
+        size_t batchSize;
+    };
+    const VariantCase variants[] = {
+        {MSERVariant::MSER_1, 1},
+        {MSERVariant::MSER_5, 5},
+        {MSERVariant::MSER_M, 10},
+        {MSERVariant::MSER_M, 7},
+    };
+    
+    for (int mode = 0; mode < 3; ++mode) {
+        for (const VariantCase& variantCase : variants) {
+            for (SampleStorage storage : {SampleStorage::FLOAT64, SampleStorage::FLOAT32}) {
+                SteadyStateConfig config = baseConfig(variantCase.variant, variantCase.batchSize);
+                config.enableIncremental = (mode == 1);
+                config.enableStreaming = (mode == 2);
+                config.storage = storage;
+                MSER_CHECK(countAllocations(config, data) == 0);
+            }
+        }
+    }
+}
+
+/**
+ * 時間重み付き・分割実行・GEOMETRIC・非既定の NonFinitePolicy でも割り当てを行わないこと
+ */
+void testScheduleAndPolicyModesDoNotAllocate(const TimeSeriesData& data) {
+    for (MSERVariant variant : {MSERVariant::MSER_1, MSERVariant::MSER_5}) {
+        size_t batchSize = (variant == MSERVariant::MSER_1) ? 1 : 5;
+        
+        SteadyStateConfig timeWeighted = baseConfig(variant, batchSize);
+        timeWeighted.timeWeighted = true;
+        MSER_CHECK(countAllocations(timeWeighted, data) == 0);
+        
+        // 分割実行は取り込みごとに走査が進むため、自動チェックを有効にする
+        for (CheckSliceUnit unit : {CheckSliceUnit::OPERATIONS, CheckSliceUnit::NANOSECONDS}) {
+            SteadyStateConfig sliced = baseConfig(variant, batchSize);
+            sliced.checkSliceBudget = (unit == CheckSliceUnit::OPERATIONS) ? 16 : 2000;
+            sliced.checkSliceUnit = unit;
+            sliced.checkInterval = 97;
+            MSER_CHECK(countAllocations(sliced, data) == 0);
+        }
+        
+        SteadyStateConfig geometric = baseConfig(variant, batchSize);
+        geometric.checkSchedule = CheckSchedule::GEOMETRIC;
+        geometric.geometricGrowth = 0.05;
+        geometric.minSamples = 100;
+        MSER_CHECK(countAllocations(geometric, data) == 0);
+        
+        for (NonFinitePolicy policy : {NonFinitePolicy::SKIP, NonFinitePolicy::CLAMP}) {
+            SteadyStateConfig config = baseConfig(variant, batchSize);
+            config.nonFinitePolicy = policy;
+            MSER_CHECK(countAllocations(config, data, true) == 0);
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    TimeSeriesData data = test::generateLargeTransient(kSampleCount, 1e3);
+    testChecksDoNotAllocate(data);
+    testScheduleAndPolicyModesDoNotAllocate(data);
+    
+    if (test::failureCount() > 0) {
+        std::fprintf(stderr, "%d 件のチェックが失敗しました\n", test::failureCount());
+        return 1;
+    }
+    std::printf("check_allocation_test: 成功\n");
+    return 0;
+}
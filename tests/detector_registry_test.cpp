@@ -0,0 +1,240 @@
+#include "mser/detector_registry.h"
+#include "mser/steady_state_detector.h"
+#include "test_support.h"
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace mser;
+
+namespace {
+
+const size_t kDetectorCount = 300;
+const size_t kSampleCount = 3000;
+
+/**
+ * 検出設定（maxSamples は系列長と同じで、最後のサンプルまで取り込む）
+ */
+SteadyStateConfig registryConfig() {
+    SteadyStateConfig config;
+    config.maxSamples = kSampleCount;
+    config.checkInterval = 50;
+    config.enableIncremental = true;
+    return config;
+}
+
+/**
+ * 検出器ごとの系列（ノイズの大きさを変え、収束する検出器としない検出器を混在させる）
+ */
+std::vector<TimeSeriesData> generateSeries() {
+    std::vector<TimeSeriesData> series;
+    for (size_t id = 0; id < kDetectorCount; ++id) {
+        TimeSeriesData data = test::generateLargeTransient(kSampleCount, 10.0, id + 1);
+        double scale = 1.0 + static_cast<double>(id % 7) * 2.0;
+        for (double& value : data) {
+            value *= scale;
+        }
+        series.push_back(data);
+    }
+    return series;
+}
+
+/**
+ * 各呼び出しに全検出器のサンプルを1つずつ（呼び出しごとに順序を入れ替えて）渡した結果
+ */
+struct RegistryRun {
+    std::vector<std::vector<DetectorId>> convergedIds;  // 呼び出しごとの新たな収束ID（昇順）
+    std::vector<MSERResult> lastResults;                // 検出器ごとの最新結果
+};
+
+RegistryRun runRegistry(const std::vector<TimeSeriesData>& series, size_t shardCount,
+                        size_t threadCount, CheckSchedule schedule = CheckSchedule::FIXED) {
+    SteadyStateConfig config = registryConfig();
+    config.checkSchedule = schedule;
+    DetectorRegistry registry(config, shardCount, threadCount);
+    MSER_CHECK(registry.getThreadCount() == threadCount);
+    
+    std::mt19937_64 rng(17);
+    std::vector<DetectorSample> step(kDetectorCount);
+    RegistryRun run;
+    for (size_t i = 0; i < kSampleCount; ++i) {
+        for (size_t id = 0; id < kDetectorCount; ++id) {
+            step[id] = {id, series[id][i]};
+        }
+        std::shuffle(step.begin(), step.end(), rng);
+        
+        std::vector<DetectorId> converged = registry.ingest(step);
+        std::sort(converged.begin(), converged.end());
+        run.convergedIds.push_back(converged);
+    }
+    
+    MSER_CHECK(registry.size() == kDetectorCount);
+    size_t convergedCount = 0;
+    for (size_t id = 0; id < kDetectorCount; ++id) {
+        MSER_CHECK(registry.getLastResult(id) != nullptr);
+        run.lastResults.push_back(*registry.getLastResult(id));
+        convergedCount += registry.hasConverged(id) ? 1 : 0;
+    }
+    MSER_CHECK(registry.getConvergedCount() == convergedCount);
+    return run;
+}
+
+/**
+ * 結果がビット単位で一致すること
+ */
+bool sameResult(const MSERResult& actual, const MSERResult& expected) {
+    return actual.truncationPoint == expected.truncationPoint &&
+           actual.mserValue == expected.mserValue &&
+           actual.converged == expected.converged &&
+           actual.totalSamples == expected.totalSamples;
+}
+
+/**
+ * 検出器ごとの結果・収束IDが、独立した SteadyStateDetector（インクリメンタル）と
+ * スレッド数・シャード数によらず一致すること
+ */
+void testMatchesStandaloneDetectors() {
+    std::vector<TimeSeriesData> series = generateSeries();
+    
+    // 独立した検出器による期待値
+    std::vector<std::unique_ptr<SteadyStateDetector>> detectors;
+    for (size_t id = 0; id < kDetectorCount; ++id) {
+        detectors.push_back(std::make_unique<SteadyStateDetector>(registryConfig()));
+    }
+    std::vector<std::vector<DetectorId>> expectedIds;
+    for (size_t i = 0; i < kSampleCount; ++i) {
+        std::vector<DetectorId> converged;
+        for (size_t id = 0; id < kDetectorCount; ++id) {
+            if (!detectors[id]->hasConverged() && detectors[id]->addDataPoint(series[id][i])) {
+                converged.push_back(id);
+            }
+        }
+        expectedIds.push_back(converged);
+    }
+    
+    size_t convergedCount = 0;
+    for (const auto& detector : detectors) {
+        convergedCount += detector->hasConverged() ? 1 : 0;
+    }
+    MSER_CHECK(convergedCount > 0 && convergedCount < kDetectorCount);
+    
+    const size_t configurations[][2] = {{1, 1}, {8, 1}, {0, 4}, {8, 4}};
+    for (const auto& configuration : configurations) {
+        RegistryRun run = runRegistry(series, configuration[0], configuration[1]);
+        MSER_CHECK(run.convergedIds == expectedIds);
+        for (size_t id = 0; id < kDetectorCount; ++id) {
+            MSER_CHECK(sameResult(run.lastResults[id], detectors[id]->getLastResult()));
+        }
+    }
+    
+    // TIME_BUDGET は FIXED として扱う
+    RegistryRun timeBudget = runRegistry(series, 0, 4, CheckSchedule::TIME_BUDGET);
+    MSER_CHECK(timeBudget.convergedIds == expectedIds);
+}
+
+/**
+ * 1回の呼び出しに同一IDのサンプルが複数ある場合も、スレッド数によらず同じ結果になること
+ */
+void testBatchedIngestIndependentOfThreadCount() {
+    std::vector<TimeSeriesData> series = generateSeries();
+    const size_t samplesPerCall = 37;
+    
+    std::vector<std::vector<DetectorId>> expectedIds;
+    std::vector<MSERResult> expectedResults;
+    for (size_t threadCount : {1, 4}) {
+        DetectorRegistry registry(registryConfig(), 16, threadCount);
+        std::vector<std::vector<DetectorId>> convergedIds;
+        std::vector<DetectorSample> samples;
+        for (size_t begin = 0; begin < kSampleCount; begin += samplesPerCall) {
+            samples.clear();
+            size_t end = std::min(begin + samplesPerCall, kSampleCount);
+            for (size_t i = begin; i < end; ++i) {
+                for (size_t id = 0; id < kDetectorCount; ++id) {
+                    samples.push_back({id, series[id][i]});
+                }
+            }
+            std::vector<DetectorId> converged = registry.ingest(samples);
+            std::sort(converged.begin(), converged.end());
+            convergedIds.push_back(converged);
+        }
+        
+        std::vector<MSERResult> results;
+        for (size_t id = 0; id < kDetectorCount; ++id) {
+            results.push_back(*registry.getLastResult(id));
+        }
+        if (threadCount == 1) {
+            expectedIds = convergedIds;
+            expectedResults = results;
+            continue;
+        }
+        MSER_CHECK(convergedIds == expectedIds);
+        for (size_t id = 0; id < kDetectorCount; ++id) {
+            MSER_CHECK(sameResult(results[id], expectedResults[id]));
+        }
+    }
+}
+
+/**
+ * 削除（末尾との入れ替え）後も残りの検出器を正しく検索できること
+ */
+void testRemoveKeepsLookupConsistent() {
+    const size_t detectorCount = 2000;
+    DetectorRegistry registry(registryConfig(), 4, 2);
+    
+    // ID ごとにサンプル数を変えて、入れ替えられた検出器を区別できるようにする
+    std::vector<DetectorSample> samples;
+    for (size_t id = 0; id < detectorCount; ++id) {
+        for (size_t i = 0; i < id % 5 + 1; ++i) {
+            samples.push_back({id, static_cast<double>(i)});
+        }
+    }
+    registry.ingest(samples);
+    MSER_CHECK(registry.size() == detectorCount);
+    
+    for (size_t id = 0; id < detectorCount; id += 3) {
+        MSER_CHECK(registry.remove(id));
+        MSER_CHECK(!registry.remove(id));
+    }
+    MSER_CHECK(!registry.remove(detectorCount));
+    
+    size_t removedCount = (detectorCount + 2) / 3;
+    MSER_CHECK(registry.size() == detectorCount - removedCount);
+    for (size_t id = 0; id < detectorCount; ++id) {
+        bool removed = (id % 3 == 0);
+        MSER_CHECK(registry.contains(id) == !removed);
+        MSER_CHECK(registry.getSampleCount(id) == (removed ? 0 : id % 5 + 1));
+        MSER_CHECK((registry.getLastResult(id) == nullptr) == removed);
+    }
+    
+    // 削除したIDは新しい検出器として再登録され、残りの検出器は取り込みを継続する
+    samples.clear();
+    for (size_t id = 0; id < detectorCount; ++id) {
+        samples.push_back({id, 1.0});
+    }
+    registry.ingest(samples);
+    MSER_CHECK(registry.size() == detectorCount);
+    for (size_t id = 0; id < detectorCount; ++id) {
+        MSER_CHECK(registry.getSampleCount(id) == (id % 3 == 0 ? 1 : id % 5 + 2));
+    }
+    
+    registry.clear();
+    MSER_CHECK(registry.size() == 0);
+    MSER_CHECK(!registry.contains(1));
+}
+
+} // namespace
+
+int main() {
+    testMatchesStandaloneDetectors();
+    testBatchedIngestIndependentOfThreadCount();
+    testRemoveKeepsLookupConsistent();
+    
+    if (test::failureCount() > 0) {
+        std::fprintf(stderr, "%d 件のチェックが失敗しました\n", test::failureCount());
+        return 1;
+    }
+    std::printf("detector_registry_test: 成功\n");
+    return 0;
+}
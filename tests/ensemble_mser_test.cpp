@@ -0,0 +1,164 @@
+#include "mser/ensemble_mser.h"
+#include "mser/mser.h"
+#include "test_support.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+using namespace mser;
+
+namespace {
+
+/**
+ * 長さの不揃いなレプリケーション（平均系列は複数チャンクにまたがる長さ）
+ */
+std::vector<TimeSeriesData> generateReplications() {
+    std::vector<TimeSeriesData> replications;
+    for (size_t r = 0; r < 12; ++r) {
+        size_t length = 40000 + 1237 * r;
+        double magnitude = 5.0 + static_cast<double>(r);
+        replications.push_back(test::generateLargeTransient(length, magnitude, 100 + r));
+    }
+    return replications;
+}
+
+/**
+ * 結果がビット単位で一致すること
+ */
+bool sameResult(const MSERResult& actual, const MSERResult& expected) {
+    return actual.truncationPoint == expected.truncationPoint &&
+           actual.mserValue == expected.mserValue &&
+           actual.converged == expected.converged &&
+           actual.totalSamples == expected.totalSamples &&
+           actual.batchCount == expected.batchCount &&
+           actual.effectiveBatchSize == expected.effectiveBatchSize;
+}
+
+bool sameEnsemble(const EnsembleResult& actual, const EnsembleResult& expected) {
+    if (actual.replications.size() != expected.replications.size()) {
+        return false;
+    }
+    for (size_t r = 0; r < actual.replications.size(); ++r) {
+        if (!sameResult(actual.replications[r], expected.replications[r])) {
+            return false;
+        }
+    }
+    return sameResult(actual.averageResult, expected.averageResult) &&
+           actual.averageLength == expected.averageLength &&
+           actual.truncationSample == expected.truncationSample &&
+           actual.convergedCount == expected.convergedCount &&
+           actual.truncationMin == expected.truncationMin &&
+           actual.truncationMedian == expected.truncationMedian &&
+           actual.truncationMax == expected.truncationMax &&
+           actual.truncationMean == expected.truncationMean &&
+           actual.truncationStdDev == expected.truncationStdDev &&
+           actual.pooledMean == expected.pooledMean &&
+           actual.standardError == expected.standardError;
+}
+
+/**
+ * レプリケーションごとの結果が MSER::calculate と、平均系列の結果が手計算の平均系列の
+ * MSER と一致し、スレッド数によらず同一であること
+ */
+void testMatchesSerialCalculation() {
+    std::vector<TimeSeriesData> replications = generateReplications();
+    size_t replicationCount = replications.size();
+    
+    // レプリケーション順に加算した平均系列（最短長）
+    size_t averageLength = replications.front().size();
+    for (const auto& replication : replications) {
+        averageLength = std::min(averageLength, replication.size());
+    }
+    TimeSeriesData averageSeries(averageLength, 0.0);
+    for (const auto& replication : replications) {
+        for (size_t i = 0; i < averageLength; ++i) {
+            averageSeries[i] += replication[i];
+        }
+    }
+    for (double& value : averageSeries) {
+        value /= static_cast<double>(replicationCount);
+    }
+    
+    for (MSERVariant variant : {MSERVariant::MSER_1, MSERVariant::MSER_5, MSERVariant::MSER_M}) {
+        SteadyStateConfig config;
+        config.variant = variant;
+        config.batchSize = 8;
+        
+        MSER mser;
+        MSERResult expectedAverage = mser.calculate(averageSeries, config);
+        MSER_CHECK(expectedAverage.converged);
+        size_t batchSize = expectedAverage.effectiveBatchSize;
+        size_t truncationSample = expectedAverage.truncationPoint * batchSize;
+        
+        // 共通切り捨て点以降のレプリケーション平均の平均
+        double meanSum = 0.0;
+        for (const auto& replication : replications) {
+            double sum = 0.0;
+            for (size_t i = truncationSample; i < replication.size(); ++i) {
+                sum += replication[i];
+            }
+            meanSum += sum / static_cast<double>(replication.size() - truncationSample);
+        }
+        double expectedPooledMean = meanSum / static_cast<double>(replicationCount);
+        
+        EnsembleResult serial;
+        for (size_t threadCount : {1, 4}) {
+            EnsembleMSER ensemble(threadCount);
+            MSER_CHECK(ensemble.getThreadCount() == threadCount);
+            EnsembleResult result = ensemble.analyze(replications, config);
+            
+            MSER_CHECK(result.replications.size() == replicationCount);
+            size_t truncationMin = SIZE_MAX;
+            size_t truncationMax = 0;
+            for (size_t r = 0; r < replicationCount; ++r) {
+                MSERResult expected = mser.calculate(replications[r], config);
+                MSER_CHECK(sameResult(result.replications[r], expected));
+                MSER_CHECK(expected.converged);
+                truncationMin = std::min(truncationMin, expected.truncationPoint * batchSize);
+                truncationMax = std::max(truncationMax, expected.truncationPoint * batchSize);
+            }
+            MSER_CHECK(result.convergedCount == replicationCount);
+            MSER_CHECK(result.truncationMin == truncationMin);
+            MSER_CHECK(result.truncationMax == truncationMax);
+            
+            MSER_CHECK(result.averageLength == averageLength);
+            MSER_CHECK(sameResult(result.averageResult, expectedAverage));
+            MSER_CHECK(result.truncationSample == truncationSample);
+            MSER_CHECK(test::nearlyEqual(result.pooledMean, expectedPooledMean, 1e-12));
+            MSER_CHECK(result.standardError > 0.0);
+            
+            if (threadCount == 1) {
+                serial = result;
+            } else {
+                MSER_CHECK(sameEnsemble(result, serial));
+            }
+        }
+    }
+}
+
+/**
+ * 空の入力では既定値の結果を返すこと
+ */
+void testEmptyInput() {
+    EnsembleMSER ensemble(2);
+    EnsembleResult result = ensemble.analyze({});
+    MSER_CHECK(result.replications.empty());
+    MSER_CHECK(!result.averageResult.converged);
+    MSER_CHECK(result.averageLength == 0);
+    MSER_CHECK(result.convergedCount == 0);
+}
+
+} // namespace
+
+int main() {
+    testMatchesSerialCalculation();
+    testEmptyInput();
+    
+    if (test::failureCount() > 0) {
+        std::fprintf(stderr, "%d 件のチェックが失敗しました\n", test::failureCount());
+        return 1;
+    }
+    std::printf("ensemble_mser_test: 成功\n");
+    return 0;
+}
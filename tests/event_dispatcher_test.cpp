@@ -0,0 +1,196 @@
+#include "mser/event_dispatcher.h"
+#include "test_support.h"
+#include <condition_variable>
+#include <cstdio>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mser;
+
+namespace {
+
+/**
+ * 受け取ったイベント数を数えるシンク
+ */
+class CountingSink : public EventSink {
+public:
+    void write(const DetectorEvent*, size_t count) override {
+        eventCount += count;
+        ++batchCount;
+    }
+    
+    size_t eventCount = 0;  // ディスパッチスレッドのみが更新
+    size_t batchCount = 0;
+};
+
+/**
+ * 複数の発行スレッドから発行したイベントが flush 後にすべて配信され、
+ * 発行元ごとに発行順で届くこと
+ */
+void testMultiProducerDelivery() {
+    const size_t producerCount = 4;
+    const size_t eventsPerProducer = 5000;
+    
+    EventDispatcher dispatcher(1 << 15);  // 破棄が起きない容量
+    auto sink = std::make_shared<CountingSink>();
+    dispatcher.addSink(sink);
+    
+    std::vector<const char*> sources;
+    for (size_t p = 0; p < producerCount; ++p) {
+        sources.push_back(dispatcher.registerSource("producer-" + std::to_string(p)));
+    }
+    MSER_CHECK(dispatcher.registerSource("producer-0") == sources[0]);
+    
+    // コールバックはディスパッチスレッドのみから呼ばれる
+    std::vector<size_t> received(producerCount, 0);
+    std::vector<std::uint64_t> lastSequence(producerCount, 0);
+    bool ordered = true;
+    dispatcher.subscribe([&](const DetectorEvent& event) {
+        size_t p = event.result.totalSamples;
+        if (p >= producerCount || event.source != sources[p]) {
+            ordered = false;
+            return;
+        }
+        if (received[p] > 0 && event.sequence <= lastSequence[p]) {
+            ordered = false;
+        }
+        lastSequence[p] = event.sequence;
+        ++received[p];
+    });
+    
+    std::vector<std::thread> producers;
+    for (size_t p = 0; p < producerCount; ++p) {
+        producers.emplace_back([&, p] {
+            MSERResult result;
+            result.totalSamples = p;
+            for (size_t i = 0; i < eventsPerProducer; ++i) {
+                result.truncationPoint = i;
+                dispatcher.publish(DetectorEventType::CONVERGED, sources[p], result);
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    
+    dispatcher.flush();
+    size_t total = producerCount * eventsPerProducer;
+    MSER_CHECK(dispatcher.getPublishedCount() == total);
+    MSER_CHECK(dispatcher.getDroppedCount() == 0);
+    MSER_CHECK(dispatcher.getDeliveredCount() == total);
+    
+    // flush 後はディスパッチスレッドの書き込みが見える
+    MSER_CHECK(ordered);
+    for (size_t p = 0; p < producerCount; ++p) {
+        MSER_CHECK(received[p] == eventsPerProducer);
+    }
+    MSER_CHECK(sink->eventCount == total);
+    MSER_CHECK(sink->batchCount <= total);
+    
+    dispatcher.stop();
+    dispatcher.flush();  // 停止後は即座に戻る
+}
+
+/**
+ * キューが満杯の間に発行したイベントは破棄数に計上され、残りは配信されること
+ */
+void testFullQueueDropsEvents() {
+    const size_t capacity = 16;
+    EventDispatcher dispatcher(capacity);
+    
+    // 最初のイベントの配信中にディスパッチスレッドを止めておく
+    std::mutex mutex;
+    std::condition_variable changed;
+    bool entered = false;
+    bool released = false;
+    dispatcher.subscribe([&](const DetectorEvent&) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!entered) {
+            entered = true;
+            changed.notify_all();
+            changed.wait(lock, [&] { return released; });
+        }
+    });
+    
+    MSERResult result;
+    MSER_CHECK(dispatcher.publish(DetectorEventType::CONVERGED, "blocked", result));
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [&] { return entered; });
+    }
+    
+    const size_t extra = 10;
+    size_t accepted = 0;
+    for (size_t i = 0; i < capacity + extra; ++i) {
+        if (dispatcher.publish(DetectorEventType::MAX_SAMPLES_REACHED, "full", result)) {
+            ++accepted;
+        }
+    }
+    MSER_CHECK(accepted == capacity);
+    MSER_CHECK(dispatcher.getDroppedCount() == extra);
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        released = true;
+    }
+    changed.notify_all();
+    
+    dispatcher.flush();
+    MSER_CHECK(dispatcher.getPublishedCount() == capacity + 1);
+    MSER_CHECK(dispatcher.getDeliveredCount() == capacity + 1);
+}
+
+/**
+ * JSON 出力で発行元名が正しくエスケープされ、非有限値が null になること
+ */
+void testJsonEscaping() {
+    std::ostringstream out;
+    StreamEventSink sink(out, EventLogFormat::JSON);
+    
+    DetectorEvent event;
+    event.source = "a\"b\\c\nd\re\tf\x01g\x1fh/\xc3\xa9";
+    event.sequence = 42;
+    event.result.truncationPoint = 7;
+    event.result.mserValue = std::numeric_limits<double>::quiet_NaN();
+    event.result.converged = true;
+    sink.write(&event, 1);
+    
+    std::string line = out.str();
+    MSER_CHECK(line.find("\"source\":\"a\\\"b\\\\c\\nd\\re\\tf\\u0001g\\u001fh/\xc3\xa9\"") !=
+               std::string::npos);
+    MSER_CHECK(line.find("\"event\":\"converged\"") != std::string::npos);
+    MSER_CHECK(line.find("\"sequence\":42") != std::string::npos);
+    MSER_CHECK(line.find("\"truncationPoint\":7") != std::string::npos);
+    MSER_CHECK(line.find("\"mserValue\":null") != std::string::npos);
+    MSER_CHECK(line.find("\"converged\":true}") != std::string::npos);
+    
+    // 1イベント1行（エスケープされた改行を含まない）
+    MSER_CHECK(line.back() == '\n');
+    MSER_CHECK(line.find('\n') == line.size() - 1);
+    
+    // 有限値は往復可能な精度で出力
+    out.str(std::string());
+    event.source = "plain";
+    event.result.mserValue = 0.1;
+    sink.write(&event, 1);
+    MSER_CHECK(out.str().find("\"mserValue\":0.10000000000000001") != std::string::npos);
+}
+
+} // namespace
+
+int main() {
+    testMultiProducerDelivery();
+    testFullQueueDropsEvents();
+    testJsonEscaping();
+    
+    if (test::failureCount() > 0) {
+        std::fprintf(stderr, "%d 件のチェックが失敗しました\n", test::failureCount());
+        return 1;
+    }
+    std::printf("event_dispatcher_test: 成功\n");
+    return 0;
+}
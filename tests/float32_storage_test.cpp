@@ -0,0 +1,95 @@
+#include "mser/mser.h"
+#include "mser/steady_state_detector.h"
+#include "test_support.h"
+#include <cstdint>
+#include <cstdio>
+
+using namespace mser;
+
+namespace {
+
+const double kMagnitudes[] = {10.0, 1e3, 1e6};
+const std::uint64_t kSeeds[] = {7, 11, 23};
+
+/**
+ * 単精度への変換
+ */
+TimeSeriesDataF32 toFloat(const TimeSeriesData& data) {
+    return TimeSeriesDataF32(data.begin(), data.end());
+}
+
+/**
+ * 単精度格納のオフライン計算が倍精度と同じ切り捨て点を返すこと
+ * MSERの値は入力の単精度への丸めと、全体平均でのシフトに残る桁落ち（過渡 1e6 で相対 1e-6 程度）の分だけ異なりうる
+ */
+void testOfflineMatchesDouble() {
+    MSER mser;
+    for (double magnitude : kMagnitudes) {
+        for (std::uint64_t seed : kSeeds) {
+            TimeSeriesData data = test::generateLargeTransient(20000, magnitude, seed);
+            TimeSeriesDataF32 dataF32 = toFloat(data);
+            
+            for (MSERVariant variant : {MSERVariant::MSER_1, MSERVariant::MSER_5, MSERVariant::MSER_M}) {
+                SteadyStateConfig config;
+                config.variant = variant;
+                config.batchSize = 10;
+                
+                MSERResult expected = mser.calculate(data, config);
+                MSERResult actual = mser.calculate(dataF32, config);
+                MSER_CHECK(expected.converged && actual.converged);
+                MSER_CHECK(expected.truncationPoint > 0);
+                MSER_CHECK(actual.truncationPoint == expected.truncationPoint);
+                MSER_CHECK(actual.batchCount == expected.batchCount);
+                MSER_CHECK(test::nearlyEqual(actual.mserValue, expected.mserValue, 1e-5));
+            }
+        }
+    }
+}
+
+/**
+ * 単精度格納の検出器が倍精度の検出器と同じ時点で収束し、同じ切り捨て点を返すこと
+ */
+void testDetectorMatchesDouble() {
+    for (double magnitude : kMagnitudes) {
+        for (std::uint64_t seed : kSeeds) {
+            TimeSeriesData data = test::generateLargeTransient(20000, magnitude, seed);
+            
+            SteadyStateConfig config;
+            config.maxSamples = data.size();
+            config.checkInterval = 100;
+            SteadyStateDetector reference(config);
+            config.storage = SampleStorage::FLOAT32;
+            SteadyStateDetector detector(config);
+            
+            for (double value : data) {
+                bool expected = reference.addDataPoint(value);
+                bool actual = detector.addDataPoint(value);
+                MSER_CHECK(actual == expected);
+                if (expected) {
+                    break;
+                }
+            }
+            
+            MSER_CHECK(reference.hasConverged());
+            MSER_CHECK(detector.hasConverged());
+            MSER_CHECK(detector.getCurrentSampleCount() == reference.getCurrentSampleCount());
+            MSER_CHECK(detector.getLastResult().truncationPoint ==
+                       reference.getLastResult().truncationPoint);
+            MSER_CHECK(detector.getBytesHeld() < reference.getBytesHeld());
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    testOfflineMatchesDouble();
+    testDetectorMatchesDouble();
+    
+    if (test::failureCount() > 0) {
+        std::fprintf(stderr, "%d 件のチェックが失敗しました\n", test::failureCount());
+        return 1;
+    }
+    std::printf("float32_storage_test: 成功\n");
+    return 0;
+}
@@ -0,0 +1,166 @@
+#include "mser/incremental_mser.h"
+#include "mser/mser.h"
+#include "mser/steady_state_detector.h"
+#include "test_support.h"
+#include <cstdio>
+
+using namespace mser;
+
+namespace {
+
+/**
+ * 大きな初期過渡でのインクリメンタル状態と DIRECT の一致
+ * 接頭和の差で接尾和を求めると、過渡の大きさに応じて切り捨て点がずれる。
+ * MSER値は平均シフトの丸め分だけ DIRECT と異なるため、SUFFIX_SUM とは厳密に比較する
+ */
+void testLargeTransientMatchesDirect() {
+    const size_t n = 5000;
+    MSER mser;
+    
+    for (double magnitude : {1e3, 1e6, 1e7, 1e8}) {
+        TimeSeriesData data = test::generateLargeTransient(n, magnitude);
+        
+        struct Case {
+            MSERVariant variant;
+            size_t batchSize;
+            MSERResult reference;
+            MSERResult suffixSum;
+        };
+        const Case cases[] = {
+            {MSERVariant::MSER_1, 1, mser.calculateMSER1(data, MSERAlgorithm::DIRECT),
+             mser.calculateMSER1(data)},
+            {MSERVariant::MSER_5, 5, mser.calculateMSER5(data, MSERAlgorithm::DIRECT),
+             mser.calculateMSER5(data)},
+            {MSERVariant::MSER_M, 7, mser.calculateMSERm(data, 7, MSERAlgorithm::DIRECT),
+             mser.calculateMSERm(data, 7)},
+        };
+        
+        for (const Case& c : cases) {
+            IncrementalMSER incremental(c.batchSize);
+            for (double value : data) {
+                incremental.addValue(value);
+            }
+            MSERResult result = incremental.evaluate(c.variant);
+            
+            MSER_CHECK(result.converged && c.reference.converged);
+            MSER_CHECK(result.truncationPoint == c.reference.truncationPoint);
+            MSER_CHECK(test::nearlyEqual(result.mserValue, c.reference.mserValue, 1e-2));
+            MSER_CHECK(test::nearlyEqual(result.mserValue, c.suffixSum.mserValue, 1e-12));
+        }
+    }
+}
+
+/**
+ * 検出器のインクリメンタル経路でも同じ切り捨て点になること
+ */
+void testDetectorIncrementalMatchesDirect() {
+    const size_t n = 5000;
+    TimeSeriesData data = test::generateLargeTransient(n, 1e7);
+    
+    MSER mser;
+    MSERResult reference = mser.calculateMSER5(data, MSERAlgorithm::DIRECT);
+    
+    SteadyStateConfig config;
+    config.variant = MSERVariant::MSER_5;
+    config.enableIncremental = true;
+    config.maxSamples = 2 * n;
+    config.minSamples = n;
+    config.checkInterval = n;
+    
+    SteadyStateDetector detector(config);
+    for (double value : data) {
+        detector.addDataPoint(value);
+    }
+    detector.checkConvergence();
+    const MSERResult& result = detector.getLastResult();
+    
+    MSER_CHECK(result.truncationPoint == reference.truncationPoint);
+    MSER_CHECK(test::nearlyEqual(result.mserValue, reference.mserValue, 1e-2));
+}
+
+/**
+ * 分割実行の走査が一括の evaluate と同じ切り捨て点になること
+ * 予算ごとに区間を分けても、走査中にバッチが追加されても開始時点の結果が得られる。
+ * 末尾のバッチ平均でシフトするため、MSER値は DIRECT と丸め誤差の範囲で一致する
+ */
+void testTruncationScanMatchesEvaluate() {
+    const size_t n = 5000;
+    MSER mser;
+    
+    for (double magnitude : {1e3, 1e6, 1e7, 1e8}) {
+        TimeSeriesData data = test::generateLargeTransient(2 * n, magnitude);
+        TimeSeriesData head(data.begin(), data.begin() + n);
+        MSERResult reference = mser.calculateMSER5(head, MSERAlgorithm::DIRECT);
+        
+        for (size_t budget : {1, 7, 64, 4096}) {
+            IncrementalMSER state(5);
+            for (size_t i = 0; i < n; ++i) {
+                state.addValue(data[i]);
+            }
+            MSERResult unsliced = state.evaluate(MSERVariant::MSER_5);
+            
+            TruncationScan scan;
+            scan.begin(state, MSERVariant::MSER_5);
+            size_t next = n;
+            while (!scan.advance(state, budget)) {
+                state.addValue(data[next++]);  // 走査中の追加は結果に影響しない
+            }
+            const MSERResult& sliced = scan.getResult();
+            
+            MSER_CHECK(sliced.converged && unsliced.converged);
+            MSER_CHECK(sliced.totalSamples == n);
+            MSER_CHECK(sliced.truncationPoint == unsliced.truncationPoint);
+            MSER_CHECK(sliced.truncationPoint == reference.truncationPoint);
+            MSER_CHECK(test::nearlyEqual(sliced.mserValue, reference.mserValue, 1e-12));
+        }
+    }
+}
+
+/**
+ * 検出器の分割実行チェックと一括チェックの一致
+ */
+void testDetectorSlicedCheckMatchesUnsliced() {
+    const size_t n = 5000;
+    TimeSeriesData data = test::generateLargeTransient(2 * n, 1e7);
+    
+    SteadyStateConfig config;
+    config.variant = MSERVariant::MSER_5;
+    config.enableIncremental = true;
+    config.maxSamples = 2 * n;
+    config.minSamples = n;
+    config.checkInterval = n;
+    SteadyStateDetector unsliced(config);
+    
+    config.checkSliceBudget = 16;
+    SteadyStateDetector sliced(config);
+    
+    for (size_t i = 0; i < n; ++i) {
+        unsliced.addDataPoint(data[i]);
+        sliced.addDataPoint(data[i]);
+    }
+    for (size_t i = n; i < data.size() && sliced.isCheckPending(); ++i) {
+        sliced.addDataPoint(data[i]);
+    }
+    
+    MSER_CHECK(!sliced.isCheckPending());
+    MSER_CHECK(sliced.getLastResult().totalSamples == n);
+    MSER_CHECK(sliced.getLastResult().truncationPoint == unsliced.getLastResult().truncationPoint);
+    MSER_CHECK(test::nearlyEqual(sliced.getLastResult().mserValue,
+                                 unsliced.getLastResult().mserValue, 1e-2));
+}
+
+} // namespace
+
+int main() {
+    testLargeTransientMatchesDirect();
+    testDetectorIncrementalMatchesDirect();
+    testTruncationScanMatchesEvaluate();
+    testDetectorSlicedCheckMatchesUnsliced();
+    
+    if (test::failureCount() > 0) {
+        std::fprintf(stderr, "%d 件のチェックが失敗しました\n", test::failureCount());
+        return 1;
+    }
+    std::printf("incremental_mser_test: 成功\n");
+    return 0;
+}
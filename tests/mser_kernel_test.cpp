@@ -0,0 +1,88 @@
+#include "mser/mser.h"
+#include "mser/mser_kernel.h"
+#include "mser/simd.h"
+#include "test_support.h"
+#include <cstdio>
+#include <limits>
+
+using namespace mser;
+
+namespace {
+
+const simd::InstructionSet kInstructionSets[] = {
+    simd::InstructionSet::SCALAR, simd::InstructionSet::SSE2,
+    simd::InstructionSet::AVX2, simd::InstructionSet::AVX512};
+
+/**
+ * 切り捨て点・MSER値・バッチ数がビット単位で一致すること
+ */
+bool sameResult(const MSERResult& actual, const MSERResult& expected) {
+    return actual.truncationPoint == expected.truncationPoint &&
+           actual.mserValue == expected.mserValue &&
+           actual.converged == expected.converged &&
+           actual.batchCount == expected.batchCount &&
+           actual.variant == expected.variant;
+}
+
+/**
+ * カーネルと汎用経路（ストライド付きビュー経由の calculateMSERm）の比較
+ */
+template <size_t BatchSize>
+bool kernelMatchesGeneric(const TimeSeriesData& data) {
+    MSER mser;
+    StridedView<double> view(data);
+    MSERResult expected = (BatchSize == 1) ? mser.calculateMSER1(view)
+                                           : mser.calculateMSERm(view, BatchSize);
+    return sameResult(MSERKernel<BatchSize>::calculate(data), expected);
+}
+
+/**
+ * 各命令セットでカーネルの結果が汎用経路とビット単位で一致すること
+ * 不完全バッチの端数を含む長さ、事前インスタンス化されていないバッチサイズも対象とする
+ */
+void testKernelMatchesGeneric() {
+    for (simd::InstructionSet isa : kInstructionSets) {
+        if (simd::setInstructionSet(isa) != isa) {
+            std::printf("  %s: 非対応のため省略\n", simd::toString(isa));
+            continue;
+        }
+        for (size_t n : {1000, 4099, 20011}) {
+            for (double magnitude : {10.0, 1e6}) {
+                TimeSeriesData data = test::generateLargeTransient(n, magnitude);
+                MSER_CHECK(kernelMatchesGeneric<1>(data));
+                MSER_CHECK(kernelMatchesGeneric<5>(data));
+                MSER_CHECK(kernelMatchesGeneric<7>(data));
+                MSER_CHECK(kernelMatchesGeneric<10>(data));
+            }
+        }
+    }
+}
+
+/**
+ * 非有限値を含む系列（端数の不完全バッチを含む）をカーネルが拒否すること
+ */
+void testKernelRejectsNonFinite() {
+    TimeSeriesData data = test::generateLargeTransient(1003, 10.0);
+    for (size_t position : {size_t(0), size_t(500), data.size() - 1}) {
+        TimeSeriesData corrupted = data;
+        corrupted[position] = std::numeric_limits<double>::quiet_NaN();
+        MSER_CHECK(!MSERKernel<1>::calculate(corrupted).converged);
+        MSER_CHECK(!MSERKernel<5>::calculate(corrupted).converged);
+        MSER_CHECK(!MSERKernel<10>::calculate(corrupted).converged);
+    }
+}
+
+} // namespace
+
+int main() {
+    testKernelMatchesGeneric();
+    simd::setInstructionSet(simd::detectInstructionSet());
+    testKernelRejectsNonFinite();
+    
+    if (test::failureCount() > 0) {
+        std::fprintf(stderr, "%d 件のチェックが失敗しました\n", test::failureCount());
+        return 1;
+    }
+    std::printf("mser_kernel_test: 成功\n");
+    return 0;
+}
@@ -0,0 +1,89 @@
+#include "mser/mser.h"
+#include "mser/multi_steady_state_detector.h"
+#include "test_support.h"
+#include <cstdio>
+
+using namespace mser;
+
+namespace {
+
+/**
+ * 大きな初期過渡を持つメトリックごとの結果と単一メトリックの DIRECT の一致
+ * （最終バッチ平均でシフトするため、MSER値は過渡の大きさによらず丸め誤差の範囲で一致する）
+ */
+void testLargeTransientMatchesDirect() {
+    const size_t n = 5000;
+    const double magnitudes[] = {1e3, 1e6, 1e7, 1e8};
+    const size_t metricCount = sizeof(magnitudes) / sizeof(magnitudes[0]);
+    
+    std::vector<TimeSeriesData> columns;
+    for (size_t m = 0; m < metricCount; ++m) {
+        columns.push_back(test::generateLargeTransient(n, magnitudes[m], 11 + m));
+    }
+    
+    for (MSERVariant variant : {MSERVariant::MSER_1, MSERVariant::MSER_5}) {
+        SteadyStateConfig config;
+        config.variant = variant;
+        config.maxSamples = 2 * n;
+        config.minSamples = n;
+        config.checkInterval = n;
+        config.convergenceThreshold = 0.0;
+        
+        MultiSteadyStateDetector detector(metricCount, config);
+        std::vector<TimeSeriesValue> row(metricCount);
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t m = 0; m < metricCount; ++m) {
+                row[m] = columns[m][i];
+            }
+            detector.addRow(row);
+        }
+        detector.checkConvergence();
+        
+        MSER mser;
+        for (size_t m = 0; m < metricCount; ++m) {
+            MSERResult reference = (variant == MSERVariant::MSER_1)
+                ? mser.calculateMSER1(columns[m], MSERAlgorithm::DIRECT)
+                : mser.calculateMSER5(columns[m], MSERAlgorithm::DIRECT);
+            const MSERResult& result = detector.getLastResult(m);
+            
+            MSER_CHECK(result.converged && reference.converged);
+            MSER_CHECK(result.truncationPoint == reference.truncationPoint);
+            MSER_CHECK(test::nearlyEqual(result.mserValue, reference.mserValue, 1e-12));
+        }
+    }
+}
+
+/**
+ * バッチ平均系列の取得が取り込んだ値の平均と一致すること
+ */
+void testBatchMeans() {
+    SteadyStateConfig config;
+    config.variant = MSERVariant::MSER_5;
+    config.maxSamples = 100;
+    
+    MultiSteadyStateDetector detector(2, config);
+    for (size_t i = 0; i < 12; ++i) {
+        double value = static_cast<double>(i);
+        detector.addRow(std::vector<TimeSeriesValue>{value, 1e8 - value});
+    }
+    
+    TimeSeriesData first = detector.getBatchMeans(0);
+    TimeSeriesData second = detector.getBatchMeans(1);
+    MSER_CHECK(first.size() == 2 && second.size() == 2);
+    MSER_CHECK(first[0] == 2.0 && first[1] == 7.0);
+    MSER_CHECK(second[0] == 1e8 - 2.0 && second[1] == 1e8 - 7.0);
+}
+
+} // namespace
+
+int main() {
+    testLargeTransientMatchesDirect();
+    testBatchMeans();
+    
+    if (test::failureCount() > 0) {
+        std::fprintf(stderr, "%d 件のチェックが失敗しました\n", test::failureCount());
+        return 1;
+    }
+    std::printf("multi_steady_state_detector_test: 成功\n");
+    return 0;
+}
@@ -0,0 +1,191 @@
+#include "mser/mser.h"
+#include "test_support.h"
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace mser;
+
+namespace {
+
+const size_t kRowCount = 4000;
+
+/**
+ * 2次元の系列（行優先）
+ * 次元0は先頭50行の大きな過渡、次元1は先頭600行で線形に減衰する小さな過渡と大きなノイズを持ち、
+ * 単独では次元0が早く、次元1が遅く定常に達する
+ */
+TimeSeriesData generateTwoDimensional() {
+    TimeSeriesData fast = test::generateLargeTransient(kRowCount, 10.0, 31);
+    std::mt19937_64 rng(37);
+    std::normal_distribution<double> normal(0.0, 2.0);
+    
+    TimeSeriesData data(kRowCount * 2);
+    for (size_t i = 0; i < kRowCount; ++i) {
+        double transient = (i < 600) ? 5.0 * (1.0 - static_cast<double>(i) / 600.0) : 0.0;
+        data[i * 2] = fast[i];
+        data[i * 2 + 1] = transient + normal(rng);
+    }
+    return data;
+}
+
+/**
+ * 次元 dimension の列
+ */
+TimeSeriesData column(const TimeSeriesData& data, size_t dimensionCount, size_t dimension) {
+    TimeSeriesData values;
+    for (size_t i = dimension; i < data.size(); i += dimensionCount) {
+        values.push_back(data[i]);
+    }
+    return values;
+}
+
+/**
+ * 切り捨て点 k における gₙ(k)（2パスの直接計算）
+ */
+double directValue(const TimeSeriesData& values, size_t k) {
+    double m = static_cast<double>(values.size() - k);
+    double sum = 0.0;
+    for (size_t i = k; i < values.size(); ++i) {
+        sum += values[i];
+    }
+    double mean = sum / m;
+    double squares = 0.0;
+    for (size_t i = k; i < values.size(); ++i) {
+        squares += (values[i] - mean) * (values[i] - mean);
+    }
+    return squares / (m * m);
+}
+
+/**
+ * 結合基準の直接計算による切り捨て点（同値の場合は最小のk）
+ */
+size_t directTruncationPoint(const std::vector<TimeSeriesData>& columns,
+                             MultivariateCriterion criterion) {
+    size_t maxK = columns.front().size() / 2;
+    double minValue = std::numeric_limits<double>::infinity();
+    size_t optimalK = 0;
+    for (size_t k = 0; k < maxK; ++k) {
+        double value = 0.0;
+        for (const TimeSeriesData& values : columns) {
+            double g = directValue(values, k);
+            value = (criterion == MultivariateCriterion::MAX) ? std::max(value, g) : value + g;
+        }
+        if (value < minValue) {
+            minValue = value;
+            optimalK = k;
+        }
+    }
+    return optimalK;
+}
+
+/**
+ * d = 1 の結果が calculateMSER1（バッチ化した変種は calculate）と一致すること
+ */
+void testSingleDimensionMatchesUnivariate() {
+    MSER mser;
+    for (size_t n : {1000, 20011}) {
+        for (double magnitude : {10.0, 1e3}) {
+            TimeSeriesData data = test::generateLargeTransient(n, magnitude, n);
+            
+            SteadyStateConfig config;
+            config.variant = MSERVariant::MSER_1;
+            config.batchSize = 1;
+            MultivariateMSERResult multivariate = mser.calculateMultivariate(data, 1, config);
+            MSERResult univariate = mser.calculateMSER1(data);
+            MSER_CHECK(univariate.converged && multivariate.converged);
+            MSER_CHECK(multivariate.truncationPoint == univariate.truncationPoint);
+            MSER_CHECK(test::nearlyEqual(multivariate.mserValue, univariate.mserValue, 1e-9));
+            MSER_CHECK(multivariate.totalSamples == n);
+            MSER_CHECK(multivariate.dimensionValues.size() == 1);
+            MSER_CHECK(multivariate.dimensionValues[0] == multivariate.mserValue);
+            
+            for (MultivariateCriterion criterion :
+                 {MultivariateCriterion::TRACE, MultivariateCriterion::MAX}) {
+                config.variant = MSERVariant::MSER_M;
+                config.batchSize = 7;
+                multivariate = mser.calculateMultivariate(data, 1, config, criterion);
+                univariate = mser.calculate(data, config);
+                MSER_CHECK(multivariate.truncationPoint == univariate.truncationPoint);
+                MSER_CHECK(multivariate.batchCount == univariate.batchCount);
+                MSER_CHECK(test::nearlyEqual(multivariate.mserValue, univariate.mserValue, 1e-9));
+            }
+        }
+    }
+}
+
+/**
+ * 次元ごとに定常到達の異なる2次元系列で、TRACE・MAX の切り捨て点が結合基準の直接計算と一致し、
+ * 遅く定常に達する次元に合わせて切り捨てること
+ */
+void testCriteriaFollowSlowerDimension() {
+    TimeSeriesData data = generateTwoDimensional();
+    std::vector<TimeSeriesData> columns = {column(data, 2, 0), column(data, 2, 1)};
+    
+    MSER mser;
+    size_t fastTruncation = mser.calculateMSER1(columns[0]).truncationPoint;
+    size_t slowTruncation = mser.calculateMSER1(columns[1]).truncationPoint;
+    MSER_CHECK(fastTruncation < 100 && slowTruncation > 200);
+    
+    SteadyStateConfig config;
+    config.variant = MSERVariant::MSER_1;
+    config.batchSize = 1;
+    for (MultivariateCriterion criterion :
+         {MultivariateCriterion::TRACE, MultivariateCriterion::MAX}) {
+        MultivariateMSERResult result = mser.calculateMultivariate(data, 2, config, criterion);
+        MSER_CHECK(result.converged);
+        MSER_CHECK(result.criterion == criterion);
+        MSER_CHECK(result.dimensionCount == 2 && result.totalSamples == kRowCount);
+        
+        size_t k = result.truncationPoint;
+        MSER_CHECK(k == directTruncationPoint(columns, criterion));
+        MSER_CHECK(k > 200);
+        
+        // 次元ごとの値・平均と結合値の関係
+        MSER_CHECK(result.dimensionValues.size() == 2 && result.dimensionMeans.size() == 2);
+        for (size_t j = 0; j < 2; ++j) {
+            MSER_CHECK(test::nearlyEqual(result.dimensionValues[j], directValue(columns[j], k),
+                                         1e-9));
+            double sum = 0.0;
+            for (size_t i = k; i < kRowCount; ++i) {
+                sum += columns[j][i];
+            }
+            MSER_CHECK(test::nearlyEqual(result.dimensionMeans[j],
+                                         sum / static_cast<double>(kRowCount - k), 1e-9));
+        }
+        double combined = (criterion == MultivariateCriterion::MAX)
+                              ? std::max(result.dimensionValues[0], result.dimensionValues[1])
+                              : result.dimensionValues[0] + result.dimensionValues[1];
+        MSER_CHECK(test::nearlyEqual(result.mserValue, combined, 1e-12));
+    }
+}
+
+/**
+ * 次元数0・要素数が次元数の倍数でない・非有限値を含む入力は未収束になること
+ */
+void testInvalidInput() {
+    MSER mser;
+    TimeSeriesData data = generateTwoDimensional();
+    MSER_CHECK(!mser.calculateMultivariate(data, 0).converged);
+    MSER_CHECK(!mser.calculateMultivariate(data, 3).converged);
+    
+    data[1001] = std::numeric_limits<double>::infinity();
+    MSER_CHECK(!mser.calculateMultivariate(data, 2).converged);
+}
+
+} // namespace
+
+int main() {
+    testSingleDimensionMatchesUnivariate();
+    testCriteriaFollowSlowerDimension();
+    testInvalidInput();
+    
+    if (test::failureCount() > 0) {
+        std::fprintf(stderr, "%d 件のチェックが失敗しました\n", test::failureCount());
+        return 1;
+    }
+    std::printf("multivariate_mser_test: 成功\n");
+    return 0;
+}
@@ -0,0 +1,110 @@
+#include "mser/mser.h"
+#include "test_support.h"
+#include <cstdio>
+#include <cstring>
+#include <limits>
+
+using namespace mser;
+
+namespace {
+
+/**
+ * ビット単位の一致
+ */
+bool bitwiseEqual(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+/**
+ * 複数チャンクにまたがる系列で、並列計算の結果がスレッド数によらずビット単位で同一であること
+ */
+void testThreadCountIndependence() {
+    const size_t n = 3000000;
+    TimeSeriesData data = test::generateLargeTransient(n, 50.0);
+    MSER mser;
+    
+    for (size_t batchSize : {1, 5, 7}) {
+        MSERResult single = mser.calculateParallel(data, batchSize, 1);
+        MSERResult multi = mser.calculateParallel(data, batchSize, 4);
+        
+        MSER_CHECK(single.converged && multi.converged);
+        MSER_CHECK(single.truncationPoint == multi.truncationPoint);
+        MSER_CHECK(bitwiseEqual(single.mserValue, multi.mserValue));
+        
+        // calculate 経由（threadCount != 1）も同じ固定チャンクの縮約を通る
+        SteadyStateConfig config;
+        config.variant = (batchSize == 1) ? MSERVariant::MSER_1
+                       : (batchSize == 5) ? MSERVariant::MSER_5 : MSERVariant::MSER_M;
+        config.batchSize = batchSize;
+        for (size_t threadCount : {0, 1, 2, 4}) {
+            config.threadCount = threadCount;
+            MSERResult result = mser.calculate(data, config);
+            MSER_CHECK(result.truncationPoint == single.truncationPoint);
+            MSER_CHECK(bitwiseEqual(result.mserValue, single.mserValue));
+            
+            // 検証済み入力（NaN/Inf走査の省略）でも同じ結果
+            config.preValidated = true;
+            MSERResult preValidated = mser.calculate(data, config);
+            config.preValidated = false;
+            MSER_CHECK(preValidated.truncationPoint == single.truncationPoint);
+            MSER_CHECK(bitwiseEqual(preValidated.mserValue, single.mserValue));
+        }
+        
+        // 逐次計算（MSERKernel）とは丸め誤差の範囲で一致
+        MSERResult serial = mser.calculateMSERm(data, batchSize);
+        MSER_CHECK(serial.truncationPoint == single.truncationPoint);
+        MSER_CHECK(test::nearlyEqual(serial.mserValue, single.mserValue, 1e-9));
+    }
+}
+
+/**
+ * 平均から大きく離れた水準の系列で、チャンクのシフト済み和が桁落ちしないこと
+ * （チャンク和から 長さ×シフト を差し引くと水準×チャンク長の桁で誤差が生じる）
+ */
+void testLargeLevelMatchesSequential() {
+    const size_t n = 2000000;
+    TimeSeriesData data = test::generateLargeTransient(n, 50.0, 13);
+    for (double& value : data) {
+        value += 1e9;
+    }
+    MSER mser;
+    
+    for (size_t batchSize : {1, 5}) {
+        MSERResult chunked = mser.calculateParallel(data, batchSize, 4);
+        MSERResult serial = mser.calculateMSERm(data, batchSize);
+        MSER_CHECK(chunked.converged && serial.converged);
+        MSER_CHECK(chunked.truncationPoint == serial.truncationPoint);
+        MSER_CHECK(test::nearlyEqual(chunked.mserValue, serial.mserValue, 1e-12));
+    }
+}
+
+/**
+ * 非有限値を含む系列は、チャンクによらず未収束となること
+ */
+void testNonFiniteRejected() {
+    TimeSeriesData data = test::generateLargeTransient(200000, 50.0);
+    data[150000] = std::numeric_limits<double>::quiet_NaN();
+    MSER mser;
+    
+    SteadyStateConfig config;
+    for (size_t threadCount : {1, 4}) {
+        config.threadCount = threadCount;
+        MSER_CHECK(!mser.calculate(data, config).converged);
+    }
+    MSER_CHECK(!mser.calculateParallel(data, 1, 2).converged);
+}
+
+} // namespace
+
+int main() {
+    testThreadCountIndependence();
+    testLargeLevelMatchesSequential();
+    testNonFiniteRejected();
+    
+    if (test::failureCount() > 0) {
+        std::fprintf(stderr, "%d 件のチェックが失敗しました\n", test::failureCount());
+        return 1;
+    }
+    std::printf("parallel_mser_test: 成功\n");
+    return 0;
+}
@@ -0,0 +1,518 @@
+#include "mser/steady_state_detector.h"
+#include "test_support.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+using namespace mser;
+
+namespace {
+
+/**
+ * 収束させずに全サンプルを取り込む設定
+ */
+SteadyStateConfig accumulatingConfig(size_t n) {
+    SteadyStateConfig config;
+    config.variant = MSERVariant::MSER_5;
+    config.maxSamples = 2 * n;
+    config.minSamples = 2 * n;
+    return config;
+}
+
+/**
+ * ストリーミングモードの統計量が破棄済みの生データを含む全サンプルを対象とすること
+ * バッチ平均系列の統計量では分散・サンプル数が生データと一致しない
+ */
+void testStreamingStatisticsCoverAllSamples() {
+    const size_t n = 20000;
+    TimeSeriesData data = test::generateLargeTransient(n, 1e3);
+    
+    SteadyStateConfig config = accumulatingConfig(n);
+    SteadyStateDetector reference(config);
+    
+    config.enableStreaming = true;
+    config.streamingBudget = 64;  // 保持バッチ数を超えて圧縮させる
+    SteadyStateDetector streaming(config);
+    
+    for (double value : data) {
+        reference.addDataPoint(value);
+        streaming.addDataPoint(value);
+    }
+    
+    Statistics expected = reference.getCurrentStatistics();
+    Statistics actual = streaming.getCurrentStatistics();
+    MSER_CHECK(actual.sampleCount == n);
+    MSER_CHECK(test::nearlyEqual(actual.mean, expected.mean, 1e-12));
+    MSER_CHECK(test::nearlyEqual(actual.variance, expected.variance, 1e-12));
+    MSER_CHECK(test::nearlyEqual(actual.standardError, expected.standardError, 1e-12));
+    MSER_CHECK(streaming.getCurrentMean() == actual.mean);
+    
+    // チェックポイントからの復元後も同じ統計量を返す
+    SteadyStateDetector restored(config);
+    MSER_CHECK(restored.deserialize(streaming.serialize()));
+    Statistics restoredStatistics = restored.getCurrentStatistics();
+    MSER_CHECK(restoredStatistics.sampleCount == actual.sampleCount);
+    MSER_CHECK(restoredStatistics.mean == actual.mean);
+    MSER_CHECK(restoredStatistics.variance == actual.variance);
+}
+
+/**
+ * 非ストリーミングからストリーミングへの切り替えで統計量を引き継ぐこと
+ */
+void testStreamingSwitchKeepsStatistics() {
+    const size_t n = 10000;
+    TimeSeriesData data = test::generateLargeTransient(n, 1e3);
+    
+    SteadyStateConfig config = accumulatingConfig(n);
+    SteadyStateDetector reference(config);
+    SteadyStateDetector switched(config);
+    
+    for (size_t i = 0; i < n; ++i) {
+        if (i == n / 2) {
+            SteadyStateConfig streamingConfig = config;
+            streamingConfig.enableStreaming = true;
+            switched.updateConfig(streamingConfig);
+        }
+        reference.addDataPoint(data[i]);
+        switched.addDataPoint(data[i]);
+    }
+    
+    Statistics expected = reference.getCurrentStatistics();
+    Statistics actual = switched.getCurrentStatistics();
+    MSER_CHECK(actual.sampleCount == n);
+    MSER_CHECK(test::nearlyEqual(actual.mean, expected.mean, 1e-12));
+    MSER_CHECK(test::nearlyEqual(actual.variance, expected.variance, 1e-12));
+}
+
+/**
+ * ストリーミングから非ストリーミングへの切り替え後、新規の検出器と同じ状態から再開すること
+ * 圧縮済み（バッチサイズ拡大後）のインクリメンタル状態が空の蓄積データと併存してはならない
+ */
+void testLeavingStreamingRestartsConsistently() {
+    const size_t n = 5000;
+    TimeSeriesData warmup = test::generateLargeTransient(4 * n, 1e3, 11);
+    TimeSeriesData data = test::generateLargeTransient(n, 1e3);
+    
+    for (bool incremental : {false, true}) {
+        SteadyStateConfig config = accumulatingConfig(n);
+        config.enableIncremental = incremental;
+        config.minSamples = n;
+        config.checkInterval = n;
+        
+        SteadyStateConfig streamingConfig = accumulatingConfig(warmup.size());
+        streamingConfig.enableIncremental = incremental;
+        streamingConfig.enableStreaming = true;
+        streamingConfig.streamingBudget = 64;
+        SteadyStateDetector switched(streamingConfig);
+        for (double value : warmup) {
+            switched.addDataPoint(value);
+        }
+        
+        switched.updateConfig(config);
+        MSER_CHECK(switched.getCurrentSampleCount() == 0);
+        MSER_CHECK(switched.getCurrentStatistics().sampleCount == 0);
+        MSER_CHECK(switched.getAccumulatedData().empty());
+        
+        SteadyStateDetector fresh(config);
+        for (double value : data) {
+            switched.addDataPoint(value);
+            fresh.addDataPoint(value);
+        }
+        MSER_CHECK(switched.getCurrentSampleCount() == n);
+        MSER_CHECK(switched.getAccumulatedData() == fresh.getAccumulatedData());
+        MSER_CHECK(switched.getLastResult().truncationPoint == fresh.getLastResult().truncationPoint);
+        MSER_CHECK(switched.getLastResult().mserValue == fresh.getLastResult().mserValue);
+        MSER_CHECK(switched.getLastResult().totalSamples == n);
+    }
+}
+
+/**
+ * 復元した検出器が元の検出器と同じ状態から取り込みを継続すること
+ */
+void checkRestoredContinues(SteadyStateDetector& original, SteadyStateDetector& restored,
+                            const TimeSeriesData& remaining) {
+    MSER_CHECK(restored.getCurrentSampleCount() == original.getCurrentSampleCount());
+    MSER_CHECK(restored.getAccumulatedData() == original.getAccumulatedData());
+    for (double value : remaining) {
+        original.addDataPoint(value);
+        restored.addDataPoint(value);
+    }
+    MSER_CHECK(restored.hasConverged() == original.hasConverged());
+    MSER_CHECK(restored.getLastResult().truncationPoint == original.getLastResult().truncationPoint);
+    MSER_CHECK(restored.getLastResult().mserValue == original.getLastResult().mserValue);
+}
+
+/**
+ * バッファ・ファイル経由のチェックポイントの往復で取り込み状態が一致すること
+ */
+void testCheckpointRoundTrip() {
+    const size_t n = 4000;
+    TimeSeriesData data = test::generateLargeTransient(n, 1e3);
+    TimeSeriesData head(data.begin(), data.begin() + n / 2);
+    TimeSeriesData tail(data.begin() + n / 2, data.end());
+    
+    for (SampleStorage storage : {SampleStorage::FLOAT64, SampleStorage::FLOAT32}) {
+        SteadyStateConfig config = accumulatingConfig(n);
+        config.storage = storage;
+        config.minSamples = n / 4;
+        config.checkInterval = n / 8;
+        
+        SteadyStateDetector original(config);
+        SteadyStateDetector fileOriginal(config);
+        for (double value : head) {
+            original.addDataPoint(value);
+            fileOriginal.addDataPoint(value);
+        }
+        
+        SteadyStateDetector restored;
+        MSER_CHECK(restored.deserialize(original.serialize()));
+        checkRestoredContinues(original, restored, tail);
+        
+        const char* path = "steady_state_detector_test.ckpt";
+        SteadyStateDetector fileRestored;
+        MSER_CHECK(fileOriginal.saveCheckpoint(path));
+        MSER_CHECK(fileRestored.loadCheckpoint(path));
+        std::remove(path);
+        checkRestoredContinues(fileOriginal, fileRestored, tail);
+    }
+}
+
+/**
+ * 切り詰め・破損したチェックポイントを例外なく拒否し、検出器の状態を変更しないこと
+ */
+void testCorruptedCheckpointRejected() {
+    const size_t n = 1000;
+    const size_t marker = 0x5EED5u;  // バッファ中で maxSamples の位置を特定するための値
+    TimeSeriesData data = test::generateLargeTransient(n, 1e3);
+    
+    SteadyStateConfig config = accumulatingConfig(n);
+    config.maxSamples = marker;
+    SteadyStateDetector source(config);
+    for (double value : data) {
+        source.addDataPoint(value);
+    }
+    std::vector<std::uint8_t> buffer = source.serialize();
+    
+    SteadyStateDetector target(accumulatingConfig(n));
+    target.addDataPoint(1.0);
+    for (size_t size = 0; size < buffer.size(); ++size) {
+        MSER_CHECK(!target.deserialize(buffer.data(), size));
+    }
+    std::vector<std::uint8_t> extended = buffer;
+    extended.push_back(0);
+    MSER_CHECK(!target.deserialize(extended));
+    MSER_CHECK(target.getCurrentSampleCount() == 1);
+    
+    // maxSamples を巨大な値・蓄積データ数未満の値に書き換える
+    size_t offset = 0;
+    while (offset + sizeof(size_t) <= buffer.size() &&
+           std::memcmp(buffer.data() + offset, &marker, sizeof(size_t)) != 0) {
+        ++offset;
+    }
+    MSER_CHECK(offset + sizeof(size_t) <= buffer.size());
+    for (size_t corrupted : {size_t(1) << 62, ~size_t(0), n / 2}) {
+        std::vector<std::uint8_t> damaged = buffer;
+        std::memcpy(damaged.data() + offset, &corrupted, sizeof(size_t));
+        MSER_CHECK(!target.deserialize(damaged));
+    }
+    MSER_CHECK(target.getCurrentSampleCount() == 1);
+    MSER_CHECK(target.deserialize(buffer));
+    MSER_CHECK(target.getCurrentSampleCount() == n);
+    
+    MSER_CHECK(!target.loadCheckpoint("steady_state_detector_test.missing"));
+}
+
+/**
+ * 収束を検出するまで取り込み、残りのサンプルを取り込まずに戻る
+ */
+void feedUntilConverged(SteadyStateDetector& detector, const TimeSeriesData& data) {
+    for (double value : data) {
+        if (detector.addDataPoint(value)) {
+            return;
+        }
+    }
+}
+
+/**
+ * 収束状態・サンプル数・最新結果が一致すること
+ */
+bool sameState(const SteadyStateDetector& actual, const SteadyStateDetector& expected) {
+    return actual.hasConverged() == expected.hasConverged() &&
+           actual.getCurrentSampleCount() == expected.getCurrentSampleCount() &&
+           actual.getLastResult().truncationPoint == expected.getLastResult().truncationPoint &&
+           actual.getLastResult().mserValue == expected.getLastResult().mserValue &&
+           actual.getLastResult().converged == expected.getLastResult().converged;
+}
+
+/**
+ * 非有限値の取り込み方針を指定した設定（既定のチェック間隔で収束させる）
+ */
+SteadyStateConfig policyConfig(NonFinitePolicy policy, bool incremental) {
+    SteadyStateConfig config;
+    config.nonFinitePolicy = policy;
+    config.enableIncremental = incremental;
+    return config;
+}
+
+/**
+ * 取り込み途中の NaN/Inf に対する各方針のサンプル数・計数・収束状態
+ * SKIP・CLAMP・RESET は非有限値を除いた・置換した・以降のみの系列を取り込んだ検出器と一致する
+ */
+void testNonFinitePolicies() {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double inf = std::numeric_limits<double>::infinity();
+    TimeSeriesData data = test::generateLargeTransient(5000, 10.0);
+    
+    for (bool incremental : {false, true}) {
+        SteadyStateDetector baseline(policyConfig(NonFinitePolicy::REJECT, incremental));
+        feedUntilConverged(baseline, data);
+        MSER_CHECK(baseline.hasConverged() && baseline.getCurrentSampleCount() < data.size());
+        MSER_CHECK(baseline.getNonFiniteCount() == 0 && baseline.getRejectedCount() == 0);
+        
+        // SKIP: 破棄して有限値のみを取り込む
+        {
+            TimeSeriesData input = data;
+            input.insert(input.begin() + 60, -inf);
+            input.insert(input.begin() + 20, nan);
+            SteadyStateDetector detector(policyConfig(NonFinitePolicy::SKIP, incremental));
+            for (size_t i = 0; i < 21; ++i) {
+                detector.addDataPoint(input[i]);
+            }
+            MSER_CHECK(detector.getCurrentSampleCount() == 20);
+            MSER_CHECK(detector.getNonFiniteCount() == 1);
+            
+            feedUntilConverged(detector, TimeSeriesData(input.begin() + 21, input.end()));
+            MSER_CHECK(sameState(detector, baseline));
+            MSER_CHECK(detector.getNonFiniteCount() == 2);
+            MSER_CHECK(detector.getRejectedCount() == 0);
+        }
+        
+        // CLAMP: 直前の有限値に置換（有限値の取り込み前は破棄）
+        {
+            TimeSeriesData input = data;
+            TimeSeriesData expectedInput = data;
+            input[20] = nan;
+            expectedInput[20] = data[19];
+            input[60] = inf;
+            expectedInput[60] = data[59];
+            input.insert(input.begin(), nan);
+            
+            SteadyStateDetector detector(policyConfig(NonFinitePolicy::CLAMP, incremental));
+            detector.addDataPoint(input[0]);
+            MSER_CHECK(detector.getCurrentSampleCount() == 0);
+            
+            SteadyStateDetector expected(policyConfig(NonFinitePolicy::CLAMP, incremental));
+            feedUntilConverged(detector, TimeSeriesData(input.begin() + 1, input.end()));
+            feedUntilConverged(expected, expectedInput);
+            MSER_CHECK(detector.hasConverged());
+            MSER_CHECK(sameState(detector, expected));
+            MSER_CHECK(detector.getNonFiniteCount() == 3);
+            MSER_CHECK(detector.getRejectedCount() == 0);
+        }
+        
+        // RESET: 蓄積データを破棄し、非有限値の数を保持して検出をやり直す
+        {
+            TimeSeriesData input = data;
+            input[60] = nan;
+            SteadyStateDetector detector(policyConfig(NonFinitePolicy::RESET, incremental));
+            for (size_t i = 0; i <= 60; ++i) {
+                detector.addDataPoint(input[i]);
+            }
+            MSER_CHECK(detector.getCurrentSampleCount() == 0);
+            MSER_CHECK(detector.getNonFiniteCount() == 1);
+            MSER_CHECK(!detector.hasConverged());
+            
+            TimeSeriesData remainder(input.begin() + 61, input.end());
+            SteadyStateDetector expected(policyConfig(NonFinitePolicy::RESET, incremental));
+            feedUntilConverged(detector, remainder);
+            feedUntilConverged(expected, remainder);
+            MSER_CHECK(detector.hasConverged());
+            MSER_CHECK(sameState(detector, expected));
+            MSER_CHECK(detector.getNonFiniteCount() == 1);
+            MSER_CHECK(detector.getRejectedCount() == 0);
+        }
+        
+        // REJECT: 取り込むが、reset() まで以後のチェックは未収束
+        {
+            TimeSeriesData input = data;
+            input[60] = inf;
+            SteadyStateDetector detector(policyConfig(NonFinitePolicy::REJECT, incremental));
+            feedUntilConverged(detector, input);
+            MSER_CHECK(!detector.hasConverged());
+            MSER_CHECK(detector.getCurrentSampleCount() == input.size());
+            MSER_CHECK(detector.getNonFiniteCount() == 1);
+            MSER_CHECK(detector.getRejectedCount() == 1);
+            MSER_CHECK(detector.getScheduleStatistics().checksPerformed > 0);
+            MSER_CHECK(!detector.getLastResult().converged);
+            MSER_CHECK(detector.getLastResult().totalSamples == input.size());
+            
+            detector.reset();
+            MSER_CHECK(detector.getNonFiniteCount() == 0 && detector.getRejectedCount() == 0);
+            feedUntilConverged(detector, data);
+            MSER_CHECK(sameState(detector, baseline));
+        }
+    }
+}
+
+/**
+ * GEOMETRIC で n サンプルまでに行うチェックの位置（前回チェック位置 c に対し
+ * c + max(checkInterval, ⌈c·ε⌉) 以降かつ minSamples 以降の最初のサンプル）
+ */
+std::vector<size_t> geometricCheckIndices(const SteadyStateConfig& config, size_t n) {
+    std::vector<size_t> indices;
+    size_t last = 0;
+    while (true) {
+        auto growth = static_cast<size_t>(
+            std::ceil(static_cast<double>(last) * config.geometricGrowth));
+        size_t next = std::max(config.minSamples, last + std::max(config.checkInterval, growth));
+        if (next > n) {
+            return indices;
+        }
+        indices.push_back(next);
+        last = next;
+    }
+}
+
+/**
+ * GEOMETRIC のチェック回数が O(log n) で、系列長を2倍にしても log(2)/log(1+ε) 回程度しか
+ * 増えないこと
+ */
+void testGeometricScheduleChecksLogarithmically() {
+    const size_t n = 200000;
+    TimeSeriesData data = test::generateLargeTransient(n, 10.0);
+    
+    SteadyStateConfig config;
+    config.maxSamples = 2 * n;
+    config.checkInterval = 10;
+    config.convergenceThreshold = -1.0;  // 収束させない
+    config.enableIncremental = true;
+    config.checkSchedule = CheckSchedule::GEOMETRIC;
+    config.geometricGrowth = 0.1;
+    
+    SteadyStateDetector detector(config);
+    size_t halfChecks = 0;
+    for (size_t i = 0; i < n; ++i) {
+        detector.addDataPoint(data[i]);
+        if (i + 1 == n / 2) {
+            halfChecks = detector.getScheduleStatistics().checksPerformed;
+        }
+    }
+    
+    ScheduleStatistics schedule = detector.getScheduleStatistics();
+    MSER_CHECK(schedule.checksPerformed == geometricCheckIndices(config, n).size());
+    MSER_CHECK(halfChecks == geometricCheckIndices(config, n / 2).size());
+    
+    // checkInterval が増加量を上回る区間を除けば ⌈log(n / minSamples) / log(1+ε)⌉ 回以下
+    double logBound = std::log(static_cast<double>(n) / config.minSamples) / std::log(1.1);
+    MSER_CHECK(schedule.checksPerformed <= static_cast<size_t>(std::ceil(logBound)) + 10);
+    MSER_CHECK(schedule.checksPerformed - halfChecks <=
+               static_cast<size_t>(std::ceil(std::log(2.0) / std::log(1.1))) + 1);
+    MSER_CHECK(schedule.checksPerformed < (n - config.minSamples) / config.checkInterval / 100);
+    
+    // 未収束の間は検出位置・遅延は0
+    MSER_CHECK(!detector.hasConverged());
+    MSER_CHECK(schedule.detectionSample == 0 && schedule.detectionLatency == 0);
+    MSER_CHECK(schedule.checkTimeNs > 0 && schedule.elapsedTimeNs >= schedule.checkTimeNs);
+}
+
+/**
+ * 収束時にチェック回数・検出位置・検出遅延（直前のチェックとの間隔）が記録され、
+ * reset() でリセットされること
+ */
+void testScheduleStatisticsOnConvergence() {
+    TimeSeriesData data = test::generateLargeTransient(20000, 10.0);
+    
+    for (CheckSchedule schedule : {CheckSchedule::FIXED, CheckSchedule::GEOMETRIC}) {
+        SteadyStateConfig config;
+        config.maxSamples = data.size();
+        config.checkInterval = 10;
+        config.checkSchedule = schedule;
+        config.geometricGrowth = 0.1;
+        
+        SteadyStateDetector detector(config);
+        feedUntilConverged(detector, data);
+        MSER_CHECK(detector.hasConverged());
+        
+        // 収束を検出したチェックは期待するスケジュール上の位置
+        std::vector<size_t> indices;
+        if (schedule == CheckSchedule::GEOMETRIC) {
+            indices = geometricCheckIndices(config, detector.getCurrentSampleCount());
+        } else {
+            for (size_t index = config.minSamples; index <= detector.getCurrentSampleCount();
+                 index += config.checkInterval) {
+                indices.push_back(index);
+            }
+        }
+        MSER_CHECK(indices.size() >= 2);
+        
+        ScheduleStatistics statistics = detector.getScheduleStatistics();
+        MSER_CHECK(statistics.checksPerformed == indices.size());
+        MSER_CHECK(statistics.detectionSample == detector.getCurrentSampleCount());
+        MSER_CHECK(statistics.detectionSample == indices.back());
+        MSER_CHECK(statistics.detectionLatency == indices.back() - indices[indices.size() - 2]);
+        if (schedule == CheckSchedule::GEOMETRIC) {
+            MSER_CHECK(statistics.detectionLatency > config.checkInterval);
+        }
+        MSER_CHECK(statistics.checkTimeNs > 0);
+        
+        detector.reset();
+        statistics = detector.getScheduleStatistics();
+        MSER_CHECK(statistics.checksPerformed == 0 && statistics.checkTimeNs == 0);
+        MSER_CHECK(statistics.detectionSample == 0 && statistics.detectionLatency == 0);
+    }
+}
+
+/**
+ * TIME_BUDGET はチェック間隔の区切りでのみ予算を確認し、予算100%では FIXED と同じ位置で、
+ * 予算0では初回のみチェックすること
+ */
+void testTimeBudgetSchedule() {
+    TimeSeriesData data = test::generateLargeTransient(20000, 10.0);
+    
+    SteadyStateConfig config;
+    config.maxSamples = data.size();
+    SteadyStateDetector fixed(config);
+    feedUntilConverged(fixed, data);
+    MSER_CHECK(fixed.hasConverged());
+    
+    config.checkSchedule = CheckSchedule::TIME_BUDGET;
+    config.checkTimeBudget = 1.0;  // チェック時間は経過時間を超えない
+    SteadyStateDetector unlimited(config);
+    feedUntilConverged(unlimited, data);
+    MSER_CHECK(sameState(unlimited, fixed));
+    MSER_CHECK(unlimited.getScheduleStatistics().checksPerformed ==
+               fixed.getScheduleStatistics().checksPerformed);
+    MSER_CHECK(unlimited.getScheduleStatistics().detectionLatency == config.checkInterval);
+    
+    config.checkTimeBudget = 0.0;
+    config.convergenceThreshold = -1.0;
+    SteadyStateDetector exhausted(config);
+    feedUntilConverged(exhausted, TimeSeriesData(data.begin(), data.begin() + 5000));
+    MSER_CHECK(exhausted.getScheduleStatistics().checksPerformed == 1);
+    MSER_CHECK(exhausted.getLastResult().totalSamples == config.minSamples);
+}
+
+} // namespace
+
+int main() {
+    testStreamingStatisticsCoverAllSamples();
+    testStreamingSwitchKeepsStatistics();
+    testLeavingStreamingRestartsConsistently();
+    testCheckpointRoundTrip();
+    testCorruptedCheckpointRejected();
+    testNonFinitePolicies();
+    testGeometricScheduleChecksLogarithmically();
+    testScheduleStatisticsOnConvergence();
+    testTimeBudgetSchedule();
+    
+    if (test::failureCount() > 0) {
+        std::fprintf(stderr, "%d 件のチェックが失敗しました\n", test::failureCount());
+        return 1;
+    }
+    std::printf("steady_state_detector_test: 成功\n");
+    return 0;
+}
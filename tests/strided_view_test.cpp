@@ -0,0 +1,170 @@
+#include "mser/mser.h"
+#include "mser/simd.h"
+#include "mser/strided_view.h"
+#include "test_support.h"
+#include <cstdio>
+#include <limits>
+#include <vector>
+
+using namespace mser;
+
+namespace {
+
+/**
+ * 構造体配列（AoS）の1要素（メンバ列をストライド付きビューで参照する）
+ */
+struct Sample {
+    double time;
+    float value;
+    int id;
+};
+
+const simd::InstructionSet kInstructionSets[] = {
+    simd::InstructionSet::SCALAR, simd::InstructionSet::SSE2,
+    simd::InstructionSet::AVX2, simd::InstructionSet::AVX512};
+
+/**
+ * 切り捨て点・バッチ数が一致し、MSER値が相対誤差 tolerance 以内で一致すること
+ */
+bool sameResult(const MSERResult& actual, const MSERResult& expected, double tolerance) {
+    return actual.truncationPoint == expected.truncationPoint &&
+           test::nearlyEqual(actual.mserValue, expected.mserValue, tolerance) &&
+           actual.converged == expected.converged &&
+           actual.totalSamples == expected.totalSamples &&
+           actual.batchCount == expected.batchCount &&
+           actual.variant == expected.variant;
+}
+
+bool sameStatistics(const Statistics& actual, const Statistics& expected) {
+    return actual.mean == expected.mean &&
+           actual.variance == expected.variance &&
+           actual.standardError == expected.standardError &&
+           actual.sampleCount == expected.sampleCount;
+}
+
+bool sameBatchStatistics(const BatchStatistics& actual, const BatchStatistics& expected) {
+    return actual.batchMeans == expected.batchMeans &&
+           actual.originalSampleCount == expected.originalSampleCount &&
+           actual.batchSize == expected.batchSize &&
+           actual.meanStatistics.getMean() == expected.meanStatistics.getMean() &&
+           actual.meanStatistics.getVariance() == expected.meanStatistics.getVariance();
+}
+
+/**
+ * ストライド付きビューと同じ値の連続配列で、MSER計算・統計量が一致すること
+ * （MSER値は相対誤差 tolerance 以内、統計量はビット単位）
+ */
+template <typename T>
+void checkMatchesContiguous(StridedView<T> strided, const std::vector<T>& contiguous,
+                            double tolerance) {
+    MSER_CHECK(!strided.isContiguous());
+    MSER_CHECK(strided.size() == contiguous.size());
+    StridedView<T> view(contiguous);
+    size_t n = contiguous.size();
+    
+    MSER mser;
+    MSER_CHECK(sameResult(mser.calculateMSER1(strided), mser.calculateMSER1(view), tolerance));
+    for (size_t batchSize : {5, 7, 10}) {
+        MSER_CHECK(sameResult(mser.calculateMSERm(strided, batchSize),
+                              mser.calculateMSERm(view, batchSize), tolerance));
+    }
+    for (MSERVariant variant : {MSERVariant::MSER_1, MSERVariant::MSER_5, MSERVariant::MSER_M}) {
+        SteadyStateConfig config;
+        config.variant = variant;
+        config.batchSize = 8;
+        MSERResult result = mser.calculate(strided, config);
+        MSER_CHECK(result.converged);
+        MSER_CHECK(sameResult(result, mser.calculate(view, config), tolerance));
+    }
+    
+    MSER_CHECK(sameStatistics(mser.calculateStatistics(strided, 0, n),
+                              mser.calculateStatistics(view, 0, n)));
+    MSER_CHECK(sameStatistics(mser.calculateStatistics(strided, 123, n - 45),
+                              mser.calculateStatistics(view, 123, n - 45)));
+    MSER_CHECK(sameBatchStatistics(mser.calculateBatchStatistics(strided, 7),
+                                   mser.calculateBatchStatistics(view, 7)));
+    
+    // 部分ビューもストライドを保つ
+    StridedView<T> tail = strided.subview(100, n - 100);
+    std::vector<T> tailValues(contiguous.begin() + 100, contiguous.end());
+    MSER_CHECK(sameResult(mser.calculateMSERm(tail, 5),
+                          mser.calculateMSERm(StridedView<T>(tailValues), 5), tolerance));
+}
+
+/**
+ * 倍精度のインターリーブ配列（3値ごとの1列）と連続配列の比較（命令セットごと）
+ */
+void testInterleavedDoubleMatchesContiguous() {
+    for (simd::InstructionSet isa : kInstructionSets) {
+        if (simd::setInstructionSet(isa) != isa) {
+            std::printf("  %s: 非対応のため省略\n", simd::toString(isa));
+            continue;
+        }
+        for (size_t n : {1000, 20011}) {
+            TimeSeriesData data = test::generateLargeTransient(n, 1e3, n);
+            TimeSeriesData interleaved(n * 3, std::numeric_limits<double>::quiet_NaN());
+            for (size_t i = 0; i < n; ++i) {
+                interleaved[i * 3 + 1] = data[i];
+            }
+            StridedView<double> strided(interleaved.data() + 1, n, 3 * sizeof(double));
+            // 連続配置の double 列はSIMDカーネルで走査するため、スカラー以外では
+            // レーン分割の違いによる丸め誤差を許容する
+            double tolerance = (isa == simd::InstructionSet::SCALAR) ? 0.0 : 1e-9;
+            checkMatchesContiguous(strided, data, tolerance);
+        }
+    }
+    simd::setInstructionSet(simd::detectInstructionSet());
+}
+
+/**
+ * 構造体配列の単精度メンバと連続した単精度配列の比較（単精度はストライドによらずスカラー経路）
+ */
+void testStructMemberMatchesContiguous() {
+    const size_t n = 20011;
+    TimeSeriesData data = test::generateLargeTransient(n, 10.0, 5);
+    std::vector<Sample> samples(n);
+    TimeSeriesDataF32 values(n);
+    for (size_t i = 0; i < n; ++i) {
+        samples[i] = {static_cast<double>(i), static_cast<float>(data[i]), static_cast<int>(i)};
+        values[i] = samples[i].value;
+    }
+    StridedView<float> strided(&samples[0].value, n, sizeof(Sample));
+    checkMatchesContiguous(strided, values, 0.0);
+    
+    // 単精度配列の入力も同じ経路を通る
+    MSER mser;
+    MSER_CHECK(sameResult(mser.calculateMSERm(values, 7), mser.calculateMSERm(strided, 7), 0.0));
+}
+
+/**
+ * ストライド付きビュー上の非有限値を拒否すること
+ */
+void testStridedRejectsNonFinite() {
+    const size_t n = 1000;
+    TimeSeriesData data = test::generateLargeTransient(n, 10.0);
+    TimeSeriesData interleaved(n * 2, 0.0);
+    for (size_t i = 0; i < n; ++i) {
+        interleaved[i * 2] = data[i];
+    }
+    interleaved[2 * 500] = std::numeric_limits<double>::infinity();
+    StridedView<double> strided(interleaved.data(), n, 2 * sizeof(double));
+    
+    MSER mser;
+    MSER_CHECK(!mser.calculateMSER1(strided).converged);
+    MSER_CHECK(!mser.calculateMSERm(strided, 5).converged);
+}
+
+} // namespace
+
+int main() {
+    testInterleavedDoubleMatchesContiguous();
+    testStructMemberMatchesContiguous();
+    testStridedRejectsNonFinite();
+    
+    if (test::failureCount() > 0) {
+        std::fprintf(stderr, "%d 件のチェックが失敗しました\n", test::failureCount());
+        return 1;
+    }
+    std::printf("strided_view_test: 成功\n");
+    return 0;
+}
@@ -0,0 +1,89 @@
+#include "mser/mser.h"
+#include "test_support.h"
+#include <cstdio>
+#include <limits>
+#include <vector>
+
+using namespace mser;
+
+namespace {
+
+/**
+ * 一括計算の結果が個別計算と一致すること
+ * 切り捨て点・バッチ数は完全一致、MSER値は加算順序の違いによる丸め誤差の範囲で一致
+ */
+bool matchesIndividual(const MSERResult& sweep, const MSERResult& individual) {
+    return sweep.truncationPoint == individual.truncationPoint &&
+           sweep.converged == individual.converged &&
+           sweep.batchCount == individual.batchCount &&
+           sweep.totalSamples == individual.totalSamples &&
+           sweep.variant == individual.variant &&
+           test::nearlyEqual(sweep.mserValue, individual.mserValue, 1e-9);
+}
+
+/**
+ * 各バッチサイズの結果が calculateMSERm（1は calculateMSER1）の個別呼び出しと一致すること
+ * 累積和チャンク（4096サンプル）をまたぐ長さ・チャンク長を割り切らないバッチサイズ、
+ * バッチ数が下限に満たないバッチサイズを含む
+ */
+void testMatchesIndividualCalculation() {
+    for (size_t n : {1000, 4096 * 3 + 123, 50000}) {
+        for (double magnitude : {10.0, 1e3}) {
+            TimeSeriesData data = test::generateLargeTransient(n, magnitude, n);
+            std::vector<size_t> batchSizes = {1, 2, 5, 7, 10, 64, 1000, n / 10 + 1};
+            
+            MSER mser;
+            std::vector<MSERResult> sweep = mser.calculateSweep(data, batchSizes);
+            MSER_CHECK(sweep.size() == batchSizes.size());
+            
+            for (size_t i = 0; i < batchSizes.size(); ++i) {
+                size_t batchSize = batchSizes[i];
+                MSERResult individual = (batchSize == 1) ? mser.calculateMSER1(data)
+                                                         : mser.calculateMSERm(data, batchSize);
+                MSER_CHECK(matchesIndividual(sweep[i], individual));
+                MSER_CHECK(sweep[i].effectiveBatchSize == batchSize);
+            }
+            
+            // 下限を満たすバッチサイズは収束し、バッチ数が不足するものは未収束
+            MSER_CHECK(sweep[0].converged && sweep[3].converged && sweep[5].converged);
+            MSER_CHECK(!sweep.back().converged);
+        }
+    }
+}
+
+/**
+ * 非有限値を含む系列・バッチサイズ0・空の入力はすべて未収束になること
+ */
+void testInvalidInput() {
+    MSER mser;
+    TimeSeriesData data = test::generateLargeTransient(10000, 10.0);
+    data[5000] = std::numeric_limits<double>::quiet_NaN();
+    for (const MSERResult& result : mser.calculateSweep(data, {1, 5, 7})) {
+        MSER_CHECK(!result.converged);
+        MSER_CHECK(result.totalSamples == data.size());
+    }
+    
+    data[5000] = 0.0;
+    std::vector<MSERResult> zero = mser.calculateSweep(data, {0, 5});
+    MSER_CHECK(!zero[0].converged);
+    MSER_CHECK(zero[1].converged);
+    
+    std::vector<MSERResult> empty = mser.calculateSweep(TimeSeriesData(), {1, 5});
+    MSER_CHECK(empty.size() == 2);
+    MSER_CHECK(!empty[0].converged && !empty[1].converged);
+    MSER_CHECK(mser.calculateSweep(data, {}).empty());
+}
+
+} // namespace
+
+int main() {
+    testMatchesIndividualCalculation();
+    testInvalidInput();
+    
+    if (test::failureCount() > 0) {
+        std::fprintf(stderr, "%d 件のチェックが失敗しました\n", test::failureCount());
+        return 1;
+    }
+    std::printf("sweep_mser_test: 成功\n");
+    return 0;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "mser/types.h"
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+
+namespace mser {
+namespace test {
+
+/**
+ * 失敗したチェックの数（main の戻り値に用いる）
+ */
+inline int& failureCount() {
+    static int count = 0;
+    return count;
+}
+
+/**
+ * 条件の確認（失敗時は位置と式を出力して継続）
+ */
+#define MSER_CHECK(condition)                                                          \
+    do {                                                                               \
+        if (!(condition)) {                                                            \
+            std::fprintf(stderr, "%s:%d: チェック失敗: %s\n", __FILE__, __LINE__, #condition); \
+            ++::mser::test::failureCount();                                            \
+        }                                                                              \
+    } while (0)
+
+/**
+ * 相対誤差の確認
+ */
+inline bool nearlyEqual(double a, double b, double relativeTolerance) {
+    if (a == b) {
+        return true;
+    }
+    return std::fabs(a - b) <= relativeTolerance * std::max(std::fabs(a), std::fabs(b));
+}
+
+/**
+ * 大きな初期過渡を持つ系列の生成（先頭50サンプルが水準 magnitude、以降は0、N(0,1)ノイズ）
+ * 接頭和・接尾和の差による桁落ちを検出するための系列
+ * @param n 系列長
+ * @param magnitude 初期過渡の大きさ
+ * @param seed 乱数シード
+ */
+inline TimeSeriesData generateLargeTransient(size_t n, double magnitude, std::uint64_t seed = 7) {
+    std::mt19937_64 rng(seed);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    
+    TimeSeriesData data(n);
+    for (size_t i = 0; i < n; ++i) {
+        data[i] = (i < 50 ? magnitude : 0.0) + normal(rng);
+    }
+    return data;
+}
+
+} // namespace test
+} // namespace mser
@@ -0,0 +1,125 @@
+#include "mser/mser.h"
+#include "mser/time_weighted_mser.h"
+#include "test_support.h"
+#include <cstdio>
+#include <limits>
+#include <random>
+
+using namespace mser;
+
+namespace {
+
+/**
+ * 重み付きMSERの直接計算（切り捨て点ごとに接尾の重み付き平均から二乗偏差を再計算）
+ */
+std::pair<size_t, double> directWeighted(const TimeSeriesData& means, const TimeSeriesData& weights) {
+    size_t n = means.size();
+    size_t optimalK = 0;
+    double minMSER = std::numeric_limits<double>::infinity();
+    
+    for (size_t k = 0; k < n / 2; ++k) {
+        double weight = 0.0;
+        double weightedSum = 0.0;
+        for (size_t j = k; j < n; ++j) {
+            weight += weights[j];
+            weightedSum += weights[j] * means[j];
+        }
+        double mean = weightedSum / weight;
+        
+        double sumSquaredDeviations = 0.0;
+        for (size_t j = k; j < n; ++j) {
+            sumSquaredDeviations += weights[j] * (means[j] - mean) * (means[j] - mean);
+        }
+        double mser = sumSquaredDeviations / (weight * static_cast<double>(n - k));
+        if (mser < minMSER) {
+            minMSER = mser;
+            optimalK = k;
+        }
+    }
+    
+    return {optimalK, minMSER};
+}
+
+/**
+ * 等間隔の観測で大きな初期過渡でも DIRECT と一致すること
+ * （1e8 では平均シフトの丸め誤差が隣接する切り捨て点の差と同程度になるため 1e7 まで）
+ */
+void testUniformLargeTransientMatchesDirect() {
+    const size_t n = 5000;
+    MSER mser;
+    
+    for (double magnitude : {1e3, 1e6, 1e7}) {
+        TimeSeriesData data = test::generateLargeTransient(n, magnitude);
+        MSERResult reference = mser.calculateMSER5(data, MSERAlgorithm::DIRECT);
+        
+        // 最後の観測の保持時間を確定させるため1点多く追加
+        TimeWeightedMSER timeWeighted(5);
+        for (size_t i = 0; i < n; ++i) {
+            timeWeighted.addValue(data[i], 0.5 * static_cast<double>(i));
+        }
+        timeWeighted.addValue(0.0, 0.5 * static_cast<double>(n));
+        MSERResult result = timeWeighted.evaluate(MSERVariant::MSER_5);
+        
+        MSER_CHECK(result.converged && reference.converged);
+        MSER_CHECK(result.truncationPoint == reference.truncationPoint);
+        MSER_CHECK(test::nearlyEqual(result.mserValue, reference.mserValue, 1e-2));
+    }
+}
+
+/**
+ * 不等間隔の観測で大きな初期過渡でも重み付きの直接計算と一致すること
+ */
+void testIrregularLargeTransientMatchesDirect() {
+    const size_t n = 5000;
+    std::mt19937_64 rng(5);
+    std::exponential_distribution<double> interval(1.0);
+    
+    for (double magnitude : {1e3, 1e6, 1e7, 1e8}) {
+        TimeSeriesData data = test::generateLargeTransient(n, magnitude);
+        
+        TimeWeightedMSER timeWeighted(5);
+        double timestamp = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            timeWeighted.addValue(data[i], timestamp);
+            timestamp += interval(rng);
+        }
+        timeWeighted.addValue(0.0, timestamp);
+        
+        auto [truncPoint, mserVal] = timeWeighted.findOptimalTruncationPoint();
+        auto [expectedPoint, expectedValue] = directWeighted(timeWeighted.getBatchMeans(),
+                                                             timeWeighted.getBatchWeights());
+        
+        MSER_CHECK(truncPoint == expectedPoint);
+        MSER_CHECK(test::nearlyEqual(mserVal, expectedValue, 1e-2));
+    }
+}
+
+/**
+ * 切り捨て時刻が切り捨てたバッチの保持時間の和であること
+ */
+void testTruncationTime() {
+    TimeWeightedMSER timeWeighted(2);
+    for (size_t i = 0; i <= 8; ++i) {
+        timeWeighted.addValue(1.0, 10.0 + static_cast<double>(i * i));
+    }
+    
+    MSER_CHECK(timeWeighted.getBatchCount() == 4);
+    MSER_CHECK(timeWeighted.getTruncationTime(0) == 10.0);
+    MSER_CHECK(timeWeighted.getTruncationTime(2) == 26.0);
+    MSER_CHECK(timeWeighted.getTruncationTime(10) == 74.0);
+}
+
+} // namespace
+
+int main() {
+    testUniformLargeTransientMatchesDirect();
+    testIrregularLargeTransientMatchesDirect();
+    testTruncationTime();
+    
+    if (test::failureCount() > 0) {
+        std::fprintf(stderr, "%d 件のチェックが失敗しました\n", test::failureCount());
+        return 1;
+    }
+    std::printf("time_weighted_mser_test: 成功\n");
+    return 0;
+}
@@ -0,0 +1,634 @@
+/**
+ * mser-analyze: 記録済みトレースのMSER解析ツール
+ *
+ * バイナリ（float32/float64、レコード内の列ストライド指定可）はメモリマップして
+ * StridedView 経由でコピーせずに解析し、CSVは1行ずつ読み込んでバッチ平均のみを保持する。
+ *
+ * 使用例:
+ *   mser-analyze --csv trace.csv --columns energy,temperature --variant 5
+ *   mser-analyze --binary trace.bin --type f32 --fields 4 --columns 0,3 --json
+ */
+
+#include "mser/mser.h"
+#include "mser/strided_view.h"
+#include "mser/types.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+using mser::MSERAlgorithm;
+using mser::MSERResult;
+using mser::MSERVariant;
+using mser::SteadyStateConfig;
+using mser::StridedView;
+using mser::TimeSeriesData;
+
+// ============================================================================
+// コマンドライン設定
+// ============================================================================
+
+enum class InputFormat { NONE, CSV, BINARY };
+enum class ValueType { FLOAT32, FLOAT64 };
+
+struct Options {
+    InputFormat format = InputFormat::NONE;
+    std::string path;
+    ValueType valueType = ValueType::FLOAT64;
+    size_t fieldsPerRecord = 1;         // 1レコードあたりの値の数
+    size_t recordBytes = 0;             // レコード長（0は fieldsPerRecord × 値サイズ）
+    size_t offsetBytes = 0;             // 先頭ヘッダーのバイト数
+    char delimiter = ',';               // CSV区切り文字
+    bool csvHeader = false;             // CSV先頭行をヘッダーとして扱う
+    std::vector<std::string> columns;   // 解析対象列（番号またはCSVヘッダー名、空は全列）
+    SteadyStateConfig config;           // variant・batchSize・algorithm
+    bool json = false;                  // JSON出力
+};
+
+/**
+ * 解析結果（列ごと）
+ */
+struct ColumnResult {
+    std::string name;
+    MSERResult result;
+};
+
+void printUsage(const char* program) {
+    std::cerr
+        << "使用方法: " << program << " (--csv FILE | --binary FILE) [オプション]\n"
+        << "\n"
+        << "入力:\n"
+        << "  --csv FILE            CSVファイルを1行ずつ読み込む\n"
+        << "  --binary FILE         生バイナリをメモリマップする\n"
+        << "  --type f32|f64        バイナリの値型（既定: f64）\n"
+        << "  --fields N            1レコードあたりの値の数（既定: 1）\n"
+        << "  --record-bytes N      レコード長（既定: fields × 値サイズ）\n"
+        << "  --offset N            先頭ヘッダーのバイト数（既定: 0）\n"
+        << "  --header              CSV先頭行を列名として扱う\n"
+        << "  --delimiter C         CSV区切り文字（既定: ,）\n"
+        << "  --columns LIST        解析対象列（番号または列名のカンマ区切り、既定: 全列）\n"
+        << "\n"
+        << "MSER:\n"
+        << "  --variant 1|5|m       MSER変種（既定: 5）\n"
+        << "  --batch-size N        MSER-m のバッチサイズ（既定: 5）\n"
+        << "  --algorithm suffix|direct  切り捨て点探索アルゴリズム（既定: suffix）\n"
+        << "\n"
+        << "出力:\n"
+        << "  --json                JSON形式で出力\n";
+}
+
+std::vector<std::string> splitList(const std::string& text, char delimiter) {
+    std::vector<std::string> items;
+    std::string item;
+    std::istringstream stream(text);
+    while (std::getline(stream, item, delimiter)) {
+        items.push_back(item);
+    }
+    return items;
+}
+
+bool parseSize(const char* text, size_t& value) {
+    char* end = nullptr;
+    errno = 0;
+    unsigned long long parsed = std::strtoull(text, &end, 10);
+    if (errno != 0 || end == text || *end != '\0') {
+        return false;
+    }
+    value = static_cast<size_t>(parsed);
+    return true;
+}
+
+bool takesValue(const std::string& arg) {
+    static const char* const kValueOptions[] = {
+        "--csv", "--binary", "--type", "--fields", "--record-bytes", "--offset",
+        "--delimiter", "--columns", "--variant", "--batch-size", "--algorithm",
+    };
+    for (const char* option : kValueOptions) {
+        if (arg == option) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parseArguments(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        bool consumed = true;
+        
+        if (arg == "--json") {
+            options.json = true;
+            consumed = false;
+        } else if (arg == "--header") {
+            options.csvHeader = true;
+            consumed = false;
+        } else if (!takesValue(arg)) {
+            std::cerr << "不明なオプション: " << arg << "\n";
+            return false;
+        } else if (value == nullptr) {
+            std::cerr << "オプションに値がありません: " << arg << "\n";
+            return false;
+        } else if (arg == "--csv") {
+            options.format = InputFormat::CSV;
+            options.path = value;
+        } else if (arg == "--binary") {
+            options.format = InputFormat::BINARY;
+            options.path = value;
+        } else if (arg == "--type") {
+            std::string type = value;
+            if (type == "f32" || type == "float32") {
+                options.valueType = ValueType::FLOAT32;
+            } else if (type == "f64" || type == "float64") {
+                options.valueType = ValueType::FLOAT64;
+            } else {
+                std::cerr << "不明な値型: " << type << "\n";
+                return false;
+            }
+        } else if (arg == "--fields") {
+            if (!parseSize(value, options.fieldsPerRecord) || options.fieldsPerRecord == 0) {
+                std::cerr << "不正なフィールド数: " << value << "\n";
+                return false;
+            }
+        } else if (arg == "--record-bytes") {
+            if (!parseSize(value, options.recordBytes)) {
+                std::cerr << "不正なレコード長: " << value << "\n";
+                return false;
+            }
+        } else if (arg == "--offset") {
+            if (!parseSize(value, options.offsetBytes)) {
+                std::cerr << "不正なオフセット: " << value << "\n";
+                return false;
+            }
+        } else if (arg == "--delimiter") {
+            if (std::strlen(value) != 1) {
+                std::cerr << "区切り文字は1文字で指定してください\n";
+                return false;
+            }
+            options.delimiter = value[0];
+        } else if (arg == "--columns") {
+            options.columns = splitList(value, ',');
+        } else if (arg == "--variant") {
+            std::string variant = value;
+            if (variant == "1") {
+                options.config.variant = MSERVariant::MSER_1;
+            } else if (variant == "5") {
+                options.config.variant = MSERVariant::MSER_5;
+            } else if (variant == "m") {
+                options.config.variant = MSERVariant::MSER_M;
+            } else {
+                std::cerr << "不明なMSER変種: " << variant << "\n";
+                return false;
+            }
+        } else if (arg == "--batch-size") {
+            if (!parseSize(value, options.config.batchSize) || options.config.batchSize == 0) {
+                std::cerr << "不正なバッチサイズ: " << value << "\n";
+                return false;
+            }
+        } else if (arg == "--algorithm") {
+            std::string algorithm = value;
+            if (algorithm == "suffix") {
+                options.config.algorithm = MSERAlgorithm::SUFFIX_SUM;
+            } else if (algorithm == "direct") {
+                options.config.algorithm = MSERAlgorithm::DIRECT;
+            } else {
+                std::cerr << "不明なアルゴリズム: " << algorithm << "\n";
+                return false;
+            }
+        }
+        
+        if (consumed) {
+            ++i;
+        }
+    }
+    
+    if (options.format == InputFormat::NONE) {
+        std::cerr << "--csv または --binary を指定してください\n";
+        return false;
+    }
+    
+    return true;
+}
+
+/**
+ * 実効バッチサイズ（MSER-1は1、MSER-5は5）
+ */
+size_t effectiveBatchSize(const SteadyStateConfig& config) {
+    switch (config.variant) {
+        case MSERVariant::MSER_1:
+            return 1;
+        case MSERVariant::MSER_M:
+            return config.batchSize;
+        case MSERVariant::MSER_5:
+        default:
+            return 5;
+    }
+}
+
+// ============================================================================
+// バイナリ入力（メモリマップ）
+// ============================================================================
+
+/**
+ * 読み取り専用メモリマップ
+ */
+class MappedFile {
+public:
+    MappedFile() : data_(nullptr), size_(0) {}
+    
+    ~MappedFile() {
+        if (data_ != nullptr) {
+            munmap(data_, size_);
+        }
+    }
+    
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    
+    bool open(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+            ::close(fd);
+            return false;
+        }
+        
+        size_ = static_cast<size_t>(info.st_size);
+        void* mapped = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        
+        if (mapped == MAP_FAILED) {
+            size_ = 0;
+            return false;
+        }
+        
+        data_ = mapped;
+        madvise(data_, size_, MADV_SEQUENTIAL);  // 先読みを促し、走査済みページは回収させる
+        return true;
+    }
+    
+    const unsigned char* data() const { return static_cast<const unsigned char*>(data_); }
+    size_t size() const { return size_; }
+
+private:
+    void* data_;
+    size_t size_;
+};
+
+/**
+ * 列番号リストの解決（空は全列）
+ */
+bool resolveColumnIndices(const std::vector<std::string>& columns,
+                          const std::vector<std::string>& header,
+                          size_t columnCount, std::vector<size_t>& indices) {
+    if (columns.empty()) {
+        for (size_t i = 0; i < columnCount; ++i) {
+            indices.push_back(i);
+        }
+        return true;
+    }
+    
+    for (const auto& column : columns) {
+        size_t index = columnCount;
+        for (size_t i = 0; i < header.size(); ++i) {
+            if (header[i] == column) {
+                index = i;
+                break;
+            }
+        }
+        if (index == columnCount && !parseSize(column.c_str(), index)) {
+            std::cerr << "不明な列: " << column << "\n";
+            return false;
+        }
+        if (index >= columnCount) {
+            std::cerr << "列番号が範囲外です: " << column << "\n";
+            return false;
+        }
+        indices.push_back(index);
+    }
+    
+    return true;
+}
+
+template <typename T>
+bool analyzeBinaryColumns(const MappedFile& file, const Options& options,
+                          std::vector<ColumnResult>& results) {
+    size_t recordBytes = options.recordBytes != 0 ? options.recordBytes
+                                                  : options.fieldsPerRecord * sizeof(T);
+    if (recordBytes < options.fieldsPerRecord * sizeof(T)) {
+        std::cerr << "レコード長がフィールド数に対して短すぎます\n";
+        return false;
+    }
+    if (options.offsetBytes % alignof(T) != 0 || recordBytes % alignof(T) != 0) {
+        std::cerr << "オフセットとレコード長は値サイズの倍数である必要があります\n";
+        return false;
+    }
+    if (options.offsetBytes >= file.size()) {
+        std::cerr << "オフセットがファイルサイズを超えています\n";
+        return false;
+    }
+    
+    size_t recordCount = (file.size() - options.offsetBytes) / recordBytes;
+    std::vector<size_t> indices;
+    if (!resolveColumnIndices(options.columns, {}, options.fieldsPerRecord, indices)) {
+        return false;
+    }
+    
+    mser::MSER calculator;
+    const unsigned char* base = file.data() + options.offsetBytes;
+    
+    for (size_t index : indices) {
+        const T* first = reinterpret_cast<const T*>(base + index * sizeof(T));
+        StridedView<T> view(first, recordCount, recordBytes);
+        results.push_back({std::to_string(index), calculator.calculate(view, options.config)});
+    }
+    
+    return true;
+}
+
+bool analyzeBinary(const Options& options, std::vector<ColumnResult>& results) {
+    MappedFile file;
+    if (!file.open(options.path)) {
+        std::cerr << "ファイルをマップできません: " << options.path << "\n";
+        return false;
+    }
+    
+    if (options.valueType == ValueType::FLOAT32) {
+        return analyzeBinaryColumns<float>(file, options, results);
+    }
+    return analyzeBinaryColumns<double>(file, options, results);
+}
+
+// ============================================================================
+// CSV入力（ストリーミング）
+// ============================================================================
+
+/**
+ * 列ごとのバッチ平均累積（生データは保持しない）
+ */
+struct ColumnAccumulator {
+    TimeSeriesData batchMeans;
+    double batchSum = 0.0;
+    size_t batchFill = 0;
+    size_t sampleCount = 0;
+    size_t nonFiniteCount = 0;
+};
+
+/**
+ * フィールドの数値解析（空欄・数値以外の文字を含む場合は失敗）
+ */
+bool parseValue(const std::string& field, double& value) {
+    const char* text = field.c_str();
+    while (*text == ' ' || *text == '\t') {
+        ++text;
+    }
+    char* end = nullptr;
+    value = std::strtod(text, &end);
+    if (end == text) {
+        return false;
+    }
+    while (*end == ' ' || *end == '\t' || *end == '\r') {
+        ++end;
+    }
+    return *end == '\0';
+}
+
+bool analyzeCsv(const Options& options, std::vector<ColumnResult>& results) {
+    std::ifstream input(options.path);
+    if (!input) {
+        std::cerr << "ファイルを開けません: " << options.path << "\n";
+        return false;
+    }
+    
+    std::string line;
+    std::vector<std::string> header;
+    std::vector<std::string> fields;
+    bool haveFirstRow = false;
+    
+    // 先頭行から列数と列名を決定
+    while (std::getline(input, line)) {
+        if (line.empty() || line == "\r") {
+            continue;
+        }
+        fields = splitList(line, options.delimiter);
+        haveFirstRow = true;
+        break;
+    }
+    if (!haveFirstRow) {
+        std::cerr << "データがありません: " << options.path << "\n";
+        return false;
+    }
+    
+    size_t columnCount = fields.size();
+    if (options.csvHeader) {
+        header = fields;
+        for (auto& name : header) {
+            if (!name.empty() && name.back() == '\r') {
+                name.pop_back();
+            }
+        }
+    }
+    
+    std::vector<size_t> indices;
+    if (!resolveColumnIndices(options.columns, header, columnCount, indices)) {
+        return false;
+    }
+    
+    size_t batchSize = effectiveBatchSize(options.config);
+    std::vector<ColumnAccumulator> accumulators(indices.size());
+    
+    auto ingest = [&](const std::vector<std::string>& row) {
+        for (size_t c = 0; c < indices.size(); ++c) {
+            ColumnAccumulator& column = accumulators[c];
+            // 欠損・解析不能なフィールドは NaN として取り込み、非有限値として扱う
+            double value = 0.0;
+            if (indices[c] >= row.size() || !parseValue(row[indices[c]], value)) {
+                value = std::numeric_limits<double>::quiet_NaN();
+            }
+            
+            ++column.sampleCount;
+            if (!std::isfinite(value)) {
+                ++column.nonFiniteCount;  // 欠損値・解析不能値を含む
+            }
+            
+            column.batchSum += value;
+            if (++column.batchFill == batchSize) {
+                column.batchMeans.push_back(column.batchSum / batchSize);
+                column.batchSum = 0.0;
+                column.batchFill = 0;
+            }
+        }
+    };
+    
+    if (!options.csvHeader) {
+        ingest(fields);
+    }
+    while (std::getline(input, line)) {
+        if (line.empty() || line == "\r") {
+            continue;
+        }
+        splitList(line, options.delimiter).swap(fields);
+        ingest(fields);
+    }
+    
+    // バッチ平均系列にMSER-1を適用し、元のMSER変種の結果として整形
+    mser::MSER calculator;
+    for (size_t c = 0; c < indices.size(); ++c) {
+        const ColumnAccumulator& column = accumulators[c];
+        
+        MSERResult result;
+        if (column.nonFiniteCount == 0 && column.batchMeans.size() >= 10) {
+            result = calculator.calculateMSER1(column.batchMeans, options.config.algorithm);
+        }
+        
+        result.variant = options.config.variant;
+        result.totalSamples = column.sampleCount;
+        result.effectiveBatchSize = batchSize;
+        result.batchCount = (batchSize > 1) ? column.batchMeans.size() : 0;
+        
+        std::string name = header.empty() ? std::to_string(indices[c]) : header[indices[c]];
+        results.push_back({name, result});
+    }
+    
+    return true;
+}
+
+// ============================================================================
+// 出力
+// ============================================================================
+
+const char* variantName(MSERVariant variant) {
+    switch (variant) {
+        case MSERVariant::MSER_1:
+            return "MSER-1";
+        case MSERVariant::MSER_M:
+            return "MSER-m";
+        case MSERVariant::MSER_5:
+        default:
+            return "MSER-5";
+    }
+}
+
+std::string jsonEscape(const std::string& text) {
+    std::string escaped;
+    for (char ch : text) {
+        switch (ch) {
+            case '"':
+                escaped += "\\\"";
+                break;
+            case '\\':
+                escaped += "\\\\";
+                break;
+            case '\n':
+                escaped += "\\n";
+                break;
+            case '\t':
+                escaped += "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(ch) < 0x20) {
+                    char buffer[8];
+                    std::snprintf(buffer, sizeof(buffer), "\\u%04x", ch);
+                    escaped += buffer;
+                } else {
+                    escaped += ch;
+                }
+        }
+    }
+    return escaped;
+}
+
+std::string jsonNumber(double value) {
+    if (!std::isfinite(value)) {
+        return "null";
+    }
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+    return buffer;
+}
+
+void printText(const Options& options, const std::vector<ColumnResult>& results) {
+    std::cout << options.path << "\n";
+    for (const auto& column : results) {
+        const MSERResult& result = column.result;
+        std::cout << "  列 " << column.name << " (" << variantName(result.variant) << ")\n"
+                  << "    収束: " << (result.converged ? "yes" : "no") << "\n"
+                  << "    切り捨て点: " << result.truncationPoint;
+        if (result.effectiveBatchSize > 1) {
+            std::cout << " バッチ（" << result.truncationPoint * result.effectiveBatchSize
+                      << " サンプル）";
+        }
+        std::cout << "\n"
+                  << "    MSER値: " << result.mserValue << "\n"
+                  << "    サンプル数: " << result.totalSamples << "\n";
+        if (result.effectiveBatchSize > 1) {
+            std::cout << "    バッチ数: " << result.batchCount
+                      << "（バッチサイズ " << result.effectiveBatchSize << "）\n";
+        }
+    }
+}
+
+void printJson(const Options& options, const std::vector<ColumnResult>& results) {
+    std::cout << "{\n  \"file\": \"" << jsonEscape(options.path) << "\",\n  \"results\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const MSERResult& result = results[i].result;
+        std::cout << (i == 0 ? "\n" : ",\n")
+                  << "    {\"column\": \"" << jsonEscape(results[i].name) << "\""
+                  << ", \"variant\": \"" << variantName(result.variant) << "\""
+                  << ", \"converged\": " << (result.converged ? "true" : "false")
+                  << ", \"truncationPoint\": " << result.truncationPoint
+                  << ", \"truncationSample\": "
+                  << result.truncationPoint * std::max<size_t>(result.effectiveBatchSize, 1)
+                  << ", \"mserValue\": " << jsonNumber(result.mserValue)
+                  << ", \"totalSamples\": " << result.totalSamples
+                  << ", \"batchCount\": " << result.batchCount
+                  << ", \"effectiveBatchSize\": " << result.effectiveBatchSize << "}";
+    }
+    std::cout << "\n  ]\n}\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (argc < 2 || !parseArguments(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    
+    std::vector<ColumnResult> results;
+    bool ok = (options.format == InputFormat::CSV) ? analyzeCsv(options, results)
+                                                   : analyzeBinary(options, results);
+    if (!ok) {
+        return 1;
+    }
+    
+    if (options.json) {
+        printJson(options, results);
+    } else {
+        printText(options, results);
+    }
+    
+    return 0;
+}